@@ -63,6 +63,7 @@ Eigen::VectorXd DoubleIntegratorDynamicsSolver::f(const StateVector& x, const Co
 
 void DoubleIntegratorDynamicsSolver::ComputeDerivatives(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("DoubleIntegratorDynamicsSolver::ComputeDerivatives");
     // If the integrator changed, set up state transition derivatives again:
     if (integrator_ != last_integrator_)
     {
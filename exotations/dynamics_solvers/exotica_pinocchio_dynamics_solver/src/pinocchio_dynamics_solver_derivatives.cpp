@@ -36,6 +36,7 @@ namespace exotica
 {
 void PinocchioDynamicsSolver::ComputeDerivatives(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("PinocchioDynamicsSolver::ComputeDerivatives");
     pinocchio::computeABADerivatives(model_, *pinocchio_data_.get(), x.head(num_positions_), x.tail(num_velocities_), u, fx_.block(num_velocities_, 0, num_velocities_, num_velocities_), fx_.block(num_velocities_, num_velocities_, num_velocities_, num_velocities_), fu_.bottomRightCorner(num_velocities_, num_velocities_));
 
     Eigen::Block<Eigen::MatrixXd> da_dx = fx_.block(num_velocities_, 0, num_velocities_, get_num_state_derivative());
@@ -41,6 +41,7 @@ namespace exotica
 {
 void PinocchioDynamicsSolverWithGravityCompensation::ComputeDerivatives(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("PinocchioDynamicsSolverWithGravityCompensation::ComputeDerivatives");
     Eigen::VectorBlock<const Eigen::VectorXd> q = x.head(num_positions_);
     Eigen::VectorBlock<const Eigen::VectorXd> v = x.tail(num_velocities_);
 
@@ -31,6 +31,8 @@
 #define EXOTICA_COLLISION_SCENE_FCL_LATEST_COLLISION_SCENE_FCL_LATEST_H_
 
 #include <iostream>
+#include <list>
+#include <unordered_map>
 
 #include <exotica_core/collision_scene.h>
 #include <exotica_core/tools/conversions.h>
@@ -65,6 +67,44 @@ public:
         bool self = true;
     };
 
+    /// Last distance query result of a pair of collision objects, used to warm start subsequent queries.
+    struct DistanceCacheEntry
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        fcl::Transform3d tf1;  ///< Transform of the first object when the entry was stored
+        fcl::Transform3d tf2;  ///< Transform of the second object when the entry was stored
+        double distance;       ///< Signed distance
+        fcl::Vector3d nearest_points[2];
+        fcl::Vector3d separating_direction;  ///< Unit vector pointing from the first to the second object
+    };
+
+    /// Cache key: indices of both collision objects.
+    struct DistanceCacheKey
+    {
+        long o1;
+        long o2;
+        bool operator==(const DistanceCacheKey& other) const { return o1 == other.o1 && o2 == other.o2; }
+    };
+
+    struct DistanceCacheKeyHash
+    {
+        std::size_t operator()(const DistanceCacheKey& k) const
+        {
+            std::size_t h = std::hash<long>()(k.o1);
+            h ^= std::hash<long>()(k.o2) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    /// Cache entries of all pairs at one (discretised) scene time.
+    struct DistanceCacheSlice
+    {
+        std::list<long>::iterator lru;  ///< Position in distance_cache_lru_
+        std::unordered_map<DistanceCacheKey, DistanceCacheEntry, DistanceCacheKeyHash, std::equal_to<DistanceCacheKey>, Eigen::aligned_allocator<std::pair<const DistanceCacheKey, DistanceCacheEntry>>> entries;
+    };
+
+    void Instantiate(const CollisionSceneFCLLatestInitializer& init) override;
     void Setup() override;
 
     bool IsAllowedToCollide(const std::string& o1, const std::string& o2, const bool& self) override;
@@ -118,10 +158,44 @@ public:
     /// \brief Updates collision object transformations from the kinematic tree.
     void UpdateCollisionObjectTransforms() override;
 
+    /// @brief      Removes all entries from the distance query cache.
+    void ClearDistanceCache();
+
+    /// @brief      Number of pair distance queries that found a cache entry for the same pair and time.
+    std::size_t GetDistanceCacheHits() const { return distance_cache_hits_; }
+
+    /// @brief      Number of narrow phase queries skipped thanks to the cache (collision checks or entire pairs beyond the margin).
+    std::size_t GetDistanceCacheSkips() const { return distance_cache_skips_; }
+
+    /// @brief      Number of scene times for which the cache currently holds entries.
+    std::size_t GetDistanceCacheSize() const { return distance_cache_.size(); }
+
 private:
+    /// Returns the cache entry of the pair at the current time, or nullptr if none exists or caching is disabled.
+    DistanceCacheEntry* FindDistanceCacheEntry(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2);
+
+    /// Stores the result of a distance query of a pair at the current time.
+    void StoreDistanceCacheEntry(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, const CollisionProxy& proxy);
+
+    /// Lower bound on the signed distance of a pair given its cached distance and the motion of both objects since.
+    static double GetDistanceLowerBound(const DistanceCacheEntry& entry, fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2);
+
+    /// Returns true if the pair cannot be closer than check_margin according to the cache.
+    bool IsPairBeyondMargin(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, double check_margin);
+
+    bool use_distance_cache_ = false;
+    std::size_t distance_cache_max_time_slices_ = 1000;
+    double distance_cache_time_resolution_ = 1e-6;
+    long distance_cache_time_key_ = 0;
+    std::unordered_map<long, DistanceCacheSlice> distance_cache_;  ///< Indexed by the time key
+    std::list<long> distance_cache_lru_;                             ///< Time keys, most recently used first
+    std::size_t distance_cache_hits_ = 0;
+    std::size_t distance_cache_skips_ = 0;
+
     std::shared_ptr<fcl::BroadPhaseCollisionManagerd> broad_phase_collision_manager_;
 
     std::shared_ptr<fcl::CollisionObjectd> ConstructFclCollisionObject(long i, std::shared_ptr<KinematicElement> element);
+    std::shared_ptr<fcl::CollisionGeometryd> ConstructFclCollisionGeometry(shapes::ShapeConstPtr shape, double scale, double padding) const;
     static void CheckCollision(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, CollisionData* data);
     static void ComputeDistance(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, DistanceData* data);
 
@@ -30,6 +30,12 @@
 #include <exotica_collision_scene_fcl_latest/collision_scene_fcl_latest.h>
 #include <exotica_core/factory.h>
 #include <exotica_core/scene.h>
+#include <exotica_core/server.h>
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 #include <geometric_shapes/mesh_operations.h>
 #include <geometric_shapes/shape_operations.h>
@@ -63,6 +69,41 @@ inline bool IsRobotLink(std::shared_ptr<KinematicElement> e)
     return e->is_robot_link || e->closest_robot_link.lock();
 }
 
+namespace
+{
+// Collision geometries of meshes and octrees are expensive to build. They are shared between all collision scenes
+// using the same shape (e.g. the links of a shared robot model or meshes from the Server cache) with the same
+// scaling, padding and replacement settings. Entries are only reused while the shape is alive and are removed once
+// it expired, or by Server::ClearCache.
+typedef std::tuple<const shapes::Shape*, double, double, bool, bool> GeometryCacheKey;
+std::map<GeometryCacheKey, std::pair<std::weak_ptr<const shapes::Shape>, std::shared_ptr<fcl::CollisionGeometryd>>> geometry_cache;
+std::mutex geometry_cache_mutex;
+
+// Requires geometry_cache_mutex to be locked
+void PruneGeometryCache()
+{
+    for (auto it = geometry_cache.begin(); it != geometry_cache.end();)
+    {
+        it = it->second.first.expired() ? geometry_cache.erase(it) : std::next(it);
+    }
+}
+
+void ClearGeometryCache()
+{
+    std::lock_guard<std::mutex> lock(geometry_cache_mutex);
+    geometry_cache.clear();
+}
+}  // namespace
+
+void CollisionSceneFCLLatest::Instantiate(const CollisionSceneFCLLatestInitializer& init)
+{
+    Instantiable<CollisionSceneFCLLatestInitializer>::Instantiate(init);
+    use_distance_cache_ = init.UseDistanceCache;
+    if (init.DistanceCacheTimeSlices < 1) ThrowPretty("DistanceCacheTimeSlices needs to be at least 1, got " << init.DistanceCacheTimeSlices);
+    distance_cache_max_time_slices_ = init.DistanceCacheTimeSlices;
+    Server::Instance()->RegisterCache("CollisionSceneFCLLatest/Geometry", ClearGeometryCache);
+}
+
 void CollisionSceneFCLLatest::Setup()
 {
     if (debug_) HIGHLIGHT_NAMED("CollisionSceneFCLLatest", "FCL version: " << FCL_VERSION);
@@ -123,6 +164,9 @@ void CollisionSceneFCLLatest::UpdateCollisionObjects(const std::map<std::string,
         }
     }
 
+    // Cache entries refer to object indices, which are no longer valid.
+    ClearDistanceCache();
+
     // Register objects with the BroadPhaseCollisionManager
     broad_phase_collision_manager_->clear();
     broad_phase_collision_manager_->registerObjects(fcl_objects_);
@@ -131,6 +175,7 @@ void CollisionSceneFCLLatest::UpdateCollisionObjects(const std::map<std::string,
 
 void CollisionSceneFCLLatest::UpdateCollisionObjectTransforms()
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::UpdateCollisionObjectTransforms");
     for (fcl::CollisionObjectd* collision_object : fcl_objects_)
     {
         if (!collision_object)
@@ -152,29 +197,102 @@ void CollisionSceneFCLLatest::UpdateCollisionObjectTransforms()
         collision_object->setTransform(transformKDLToFCL(element->frame));
         collision_object->computeAABB();
     }
+
+    if (use_distance_cache_) distance_cache_time_key_ = std::lround(scene_.lock()->get_current_time() / distance_cache_time_resolution_);
 }
 
-// This function was originally copied from 'moveit_core/collision_detection_fcl/src/collision_common.cpp'
-// https://github.com/ros-planning/moveit/blob/kinetic-devel/moveit_core/collision_detection_fcl/src/collision_common.cpp#L520
-// and then modified for use in EXOTica.
-std::shared_ptr<fcl::CollisionObjectd> CollisionSceneFCLLatest::ConstructFclCollisionObject(long kinematic_element_id, std::shared_ptr<KinematicElement> element)
+void CollisionSceneFCLLatest::ClearDistanceCache()
 {
-    shapes::ShapePtr shape(element->shape->clone());
+    distance_cache_.clear();
+    distance_cache_lru_.clear();
+    distance_cache_hits_ = 0;
+    distance_cache_skips_ = 0;
+}
 
-    // Apply scaling and padding
-    if (IsRobotLink(element))
+CollisionSceneFCLLatest::DistanceCacheEntry* CollisionSceneFCLLatest::FindDistanceCacheEntry(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2)
+{
+    if (!use_distance_cache_) return nullptr;
+    const long i1 = reinterpret_cast<long>(o1->getUserData());
+    const long i2 = reinterpret_cast<long>(o2->getUserData());
+    auto slice = distance_cache_.find(distance_cache_time_key_);
+    if (slice == distance_cache_.end()) return nullptr;
+    auto it = slice->second.entries.find({std::min(i1, i2), std::max(i1, i2)});
+    if (it == slice->second.entries.end()) return nullptr;
+    distance_cache_lru_.splice(distance_cache_lru_.begin(), distance_cache_lru_, slice->second.lru);
+    ++distance_cache_hits_;
+    return &it->second;
+}
+
+void CollisionSceneFCLLatest::StoreDistanceCacheEntry(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, const CollisionProxy& proxy)
+{
+    if (!use_distance_cache_) return;
+    const long i1 = reinterpret_cast<long>(o1->getUserData());
+    const long i2 = reinterpret_cast<long>(o2->getUserData());
+
+    // Time-indexed and continuous-time callers create a new slice per time. Only the most recently used ones are kept.
+    auto slice = distance_cache_.find(distance_cache_time_key_);
+    if (slice == distance_cache_.end())
     {
-        if (robot_link_scale_ != 1.0 || robot_link_padding_ > 0.0)
+        if (distance_cache_.size() >= distance_cache_max_time_slices_)
         {
-            shape->scaleAndPadd(robot_link_scale_, robot_link_padding_);
+            distance_cache_.erase(distance_cache_lru_.back());
+            distance_cache_lru_.pop_back();
         }
+        distance_cache_lru_.push_front(distance_cache_time_key_);
+        slice = distance_cache_.emplace(distance_cache_time_key_, DistanceCacheSlice()).first;
+        slice->second.lru = distance_cache_lru_.begin();
     }
     else
     {
-        if (world_link_scale_ != 1.0 || world_link_padding_ > 0.0)
-        {
-            shape->scaleAndPadd(world_link_scale_, world_link_padding_);
-        }
+        distance_cache_lru_.splice(distance_cache_lru_.begin(), distance_cache_lru_, slice->second.lru);
+    }
+
+    // Entries are stored with the lower object index first.
+    const bool swap = i2 < i1;
+    DistanceCacheEntry& entry = slice->second.entries[{std::min(i1, i2), std::max(i1, i2)}];
+    entry.tf1 = swap ? o2->getTransform() : o1->getTransform();
+    entry.tf2 = swap ? o1->getTransform() : o2->getTransform();
+    entry.distance = proxy.distance;
+    entry.nearest_points[0] = swap ? proxy.contact2 : proxy.contact1;
+    entry.nearest_points[1] = swap ? proxy.contact1 : proxy.contact2;
+    entry.separating_direction = swap ? proxy.normal2 : proxy.normal1;
+}
+
+// Upper bound on how far any point of the object's geometry has moved between two transforms:
+// |(R1 - R0) x + (p1 - p0)| <= |p1 - p0| + 2 sin(theta / 2) |x|, where theta is the relative rotation angle.
+inline double GetMotionBound(const fcl::Transform3d& before, const fcl::Transform3d& after, const fcl::CollisionGeometryd& geometry)
+{
+    const double translation = (after.translation() - before.translation()).norm();
+    const Eigen::AngleAxisd rotation(Eigen::Matrix3d(after.linear() * before.linear().transpose()));
+    if (rotation.angle() == 0.0) return translation;  // Avoids 0 * inf for unbounded geometries (planes, octrees)
+    return translation + 2.0 * std::sin(0.5 * std::abs(rotation.angle())) * (geometry.aabb_center.norm() + geometry.aabb_radius);
+}
+
+double CollisionSceneFCLLatest::GetDistanceLowerBound(const DistanceCacheEntry& entry, fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2)
+{
+    if (reinterpret_cast<long>(o2->getUserData()) < reinterpret_cast<long>(o1->getUserData())) std::swap(o1, o2);
+    return entry.distance - GetMotionBound(entry.tf1, o1->getTransform(), *o1->collisionGeometry()) - GetMotionBound(entry.tf2, o2->getTransform(), *o2->collisionGeometry());
+}
+
+bool CollisionSceneFCLLatest::IsPairBeyondMargin(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, double check_margin)
+{
+    DistanceCacheEntry* entry = FindDistanceCacheEntry(o1, o2);
+    if (entry == nullptr || !(GetDistanceLowerBound(*entry, o1, o2) > check_margin)) return false;
+    ++distance_cache_skips_;
+    return true;
+}
+
+// This function was originally copied from 'moveit_core/collision_detection_fcl/src/collision_common.cpp'
+// https://github.com/ros-planning/moveit/blob/kinetic-devel/moveit_core/collision_detection_fcl/src/collision_common.cpp#L520
+// and then modified for use in EXOTica.
+std::shared_ptr<fcl::CollisionGeometryd> CollisionSceneFCLLatest::ConstructFclCollisionGeometry(shapes::ShapeConstPtr shape_in, double scale, double padding) const
+{
+    shapes::ShapePtr shape(shape_in->clone());
+
+    // Apply scaling and padding
+    if (scale != 1.0 || padding > 0.0)
+    {
+        shape->scaleAndPadd(scale, padding);
     }
 
     // Replace primitive shapes with meshes if desired (e.g. if primitives are unstable)
@@ -260,10 +378,47 @@ std::shared_ptr<fcl::CollisionObjectd> CollisionSceneFCLLatest::ConstructFclColl
             ThrowPretty("This shape type (" << ((int)shape->type) << ") is not supported using FCL yet");
     }
     geometry->computeLocalAABB();
-    geometry->setUserData(reinterpret_cast<void*>(kinematic_element_id));
+    return geometry;
+}
+
+std::shared_ptr<fcl::CollisionObjectd> CollisionSceneFCLLatest::ConstructFclCollisionObject(long kinematic_element_id, std::shared_ptr<KinematicElement> element)
+{
+    const bool is_robot_link = IsRobotLink(element);
+    const double scale = is_robot_link ? robot_link_scale_ : world_link_scale_;
+    const double padding = is_robot_link ? robot_link_padding_ : world_link_padding_;
+    const GeometryCacheKey key(element->shape.get(), scale, padding, replace_primitive_shapes_with_meshes_, replace_cylinders_with_capsules_);
+
+    std::shared_ptr<fcl::CollisionGeometryd> geometry;
+    {
+        std::lock_guard<std::mutex> lock(geometry_cache_mutex);
+        const auto it = geometry_cache.find(key);
+        if (it != geometry_cache.end())
+        {
+            if (it->second.first.expired())
+            {
+                // The shape was released: its address may have been reused by a different shape.
+                PruneGeometryCache();
+            }
+            else
+            {
+                geometry = it->second.second;
+            }
+        }
+    }
+
+    if (!geometry)
+    {
+        geometry = ConstructFclCollisionGeometry(element->shape, scale, padding);
+        if (geometry->getNodeType() == fcl::BV_OBBRSS || geometry->getNodeType() == fcl::GEOM_OCTREE)
+        {
+            std::lock_guard<std::mutex> lock(geometry_cache_mutex);
+            PruneGeometryCache();
+            geometry_cache[key] = std::make_pair(std::weak_ptr<const shapes::Shape>(element->shape), geometry);
+        }
+    }
+
     std::shared_ptr<fcl::CollisionObjectd> ret(new fcl::CollisionObjectd(geometry));
     ret->setUserData(reinterpret_cast<void*>(kinematic_element_id));
-
     return ret;
 }
 
@@ -340,6 +495,9 @@ bool CollisionSceneFCLLatest::CollisionCallback(fcl::CollisionObjectd* o1, fcl::
 
     if (!IsAllowedToCollide(o1, o2, data_->self, data_->scene)) return false;
 
+    // A cached distance query may already prove that the pair is further apart than the safety distance.
+    if (data_->scene->IsPairBeyondMargin(o1, o2, data_->safe_distance)) return false;
+
     CheckCollision(o1, o2, data_);
     return data_->result.isCollision();
 }
@@ -356,12 +514,20 @@ void CollisionSceneFCLLatest::ComputeDistance(fcl::CollisionObjectd* o1, fcl::Co
     //  - If in collision, use the deepest contact of the collide callback.
     //  - If not in collision, run distance query.
 
-    // Step 0: Run collision check:
+    // Step 0: Run collision check, unless a cached query at the same time proves that the pair cannot be in collision:
     fcl::CollisionRequestd tmp_req;
     fcl::CollisionResultd tmp_res;
     tmp_req.num_max_contacts = 1000;
     tmp_req.enable_contact = true;
 
+    bool skip_collision_check = false;
+    DistanceCacheEntry* cached = data->scene->FindDistanceCacheEntry(o1, o2);
+    if (cached != nullptr && GetDistanceLowerBound(*cached, o1, o2) > 0.0)
+    {
+        skip_collision_check = true;
+        ++data->scene->distance_cache_skips_;
+    }
+
     // The following comment and Step 1 code is copied from Drake (BSD license):
     // https://github.com/RobotLocomotion/drake/blob/0aa7f713eb029fea7d47109992762ed6d8d1d457/geometry/proximity_engine.cc
     // NOTE: As of 5/1/2018 the GJK implementation of Libccd appears to be
@@ -372,10 +538,10 @@ void CollisionSceneFCLLatest::ComputeDistance(fcl::CollisionObjectd* o1, fcl::Co
     tmp_req.gjk_tolerance = 2e-12;
     tmp_req.gjk_solver_type = fcl::GJKSolverType::GST_LIBCCD;
 
-    fcl::collide(o1, o2, tmp_req, tmp_res);
+    if (!skip_collision_check) fcl::collide(o1, o2, tmp_req, tmp_res);
 
     // Step 1: If in collision, extract contact point.
-    if (tmp_res.isCollision())
+    if (!skip_collision_check && tmp_res.isCollision())
     {
         // TODO: Issue #364: https://github.com/ipab-slmc/exotica/issues/364
         // As of 0.5.94, this does not work for primitive-vs-mesh (but does for mesh-vs-primitive):
@@ -428,6 +594,7 @@ void CollisionSceneFCLLatest::ComputeDistance(fcl::CollisionObjectd* o1, fcl::Co
 
             data->Distance = std::min(data->Distance, p.distance);
             data->proxies.push_back(p);
+            data->scene->StoreDistanceCacheEntry(o1, o2, p);
 
             return;
         }
@@ -524,6 +691,7 @@ void CollisionSceneFCLLatest::ComputeDistance(fcl::CollisionObjectd* o1, fcl::Co
 
     data->Distance = std::min(data->Distance, p.distance);
     data->proxies.push_back(p);
+    data->scene->StoreDistanceCacheEntry(o1, o2, p);
 }
 
 bool CollisionSceneFCLLatest::CollisionCallbackDistance(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, void* data, double& dist)
@@ -537,6 +705,7 @@ bool CollisionSceneFCLLatest::CollisionCallbackDistance(fcl::CollisionObjectd* o
 
 bool CollisionSceneFCLLatest::IsStateValid(bool self, double safe_distance)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::IsStateValid");
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
 
     CollisionData data(this);
@@ -548,6 +717,7 @@ bool CollisionSceneFCLLatest::IsStateValid(bool self, double safe_distance)
 
 bool CollisionSceneFCLLatest::IsCollisionFree(const std::string& o1, const std::string& o2, double safe_distance)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::IsCollisionFree");
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
 
     // TODO: Redo this logic using prior built maps
@@ -578,6 +748,7 @@ bool CollisionSceneFCLLatest::IsCollisionFree(const std::string& o1, const std::
 
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(bool self)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetCollisionDistance");
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
 
     DistanceData data(this);
@@ -588,6 +759,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(bool s
 
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(const std::string& o1, const std::string& o2)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetCollisionDistance");
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
 
     // TODO: Redo logic with prior built maps.
@@ -622,6 +794,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(const
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(
     const std::string& o1, const bool& self, const bool& disable_collision_scene_update)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetCollisionDistance");
     if (!always_externally_updated_collision_scene_ && !disable_collision_scene_update) UpdateCollisionObjectTransforms();
 
     std::vector<fcl::CollisionObjectd*> shapes1;
@@ -676,6 +849,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(
 
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(const std::vector<std::string>& objects, const bool& self)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetCollisionDistance");
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
 
     std::vector<CollisionProxy> proxies;
@@ -687,6 +861,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetCollisionDistance(const
 
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetRobotToRobotCollisionDistance(double check_margin)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetRobotToRobotCollisionDistance");
     DistanceData data(this);
     data.self = true;
 
@@ -703,7 +878,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetRobotToRobotCollisionDis
                     for (auto o2 : it2.second)
                     {
                         // Check whether the AABB is less than the check_margin, if so, perform a collision distance call
-                        if (o1->getAABB().distance(o2->getAABB()) < check_margin)
+                        if (o1->getAABB().distance(o2->getAABB()) < check_margin && !IsPairBeyondMargin(o1, o2, check_margin))
                         {
                             ComputeDistance(o1, o2, &data);
                         }
@@ -717,6 +892,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetRobotToRobotCollisionDis
 
 std::vector<CollisionProxy> CollisionSceneFCLLatest::GetRobotToWorldCollisionDistance(double check_margin)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::GetRobotToWorldCollisionDistance");
     DistanceData data(this);
     data.self = false;
 
@@ -733,7 +909,7 @@ std::vector<CollisionProxy> CollisionSceneFCLLatest::GetRobotToWorldCollisionDis
                     for (auto o2 : it2.second)
                     {
                         // Check whether the AABB is less than the check_margin, if so, perform a collision distance call
-                        if (o1->getAABB().distance(o2->getAABB()) < check_margin)
+                        if (o1->getAABB().distance(o2->getAABB()) < check_margin && !IsPairBeyondMargin(o1, o2, check_margin))
                         {
                             ComputeDistance(o1, o2, &data);
                         }
@@ -765,6 +941,7 @@ ContinuousCollisionProxy CollisionSceneFCLLatest::ContinuousCollisionCheck(
     const std::string& o1, const KDL::Frame& tf1_beg, const KDL::Frame& tf1_end,
     const std::string& o2, const KDL::Frame& tf2_beg, const KDL::Frame& tf2_end)
 {
+    EXOTICA_PROFILE_ZONE("CollisionSceneFCLLatest::ContinuousCollisionCheck");
     ContinuousCollisionProxy ret;
 
     if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_COLLISION_SCENE_SPHERE_SWEPT_H_
+#define EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_COLLISION_SCENE_SPHERE_SWEPT_H_
+
+#include <unordered_map>
+
+#include <exotica_core/collision_scene.h>
+
+#include <exotica_collision_scene_sphere_swept/collision_scene_sphere_swept_initializer.h>
+#include <exotica_collision_scene_sphere_swept/swept_sphere_distance.h>
+
+namespace exotica
+{
+/// \brief Collision scene approximating every collision shape by a set of conservatively fitted swept spheres (spheres and capsules).
+///
+/// Distances are computed with vectorised batch kernels and are lower bounds of the true distances between the original shapes.
+/// If an ExactCollisionScene is provided, the approximation is used as a pre-filter: states that are provably free are
+/// accepted without consulting the exact scene, all others are forwarded to it.
+class CollisionSceneSphereSwept : public CollisionScene, public Instantiable<CollisionSceneSphereSweptInitializer>
+{
+public:
+    /// A swept sphere fitted to a collision object, stored in the local frame of the object.
+    struct SweptSphere
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        int object;  ///< Index into kinematic_elements_
+        Eigen::Vector3d a;
+        Eigen::Vector3d b;
+        double radius;
+    };
+
+    void Instantiate(const CollisionSceneSphereSweptInitializer& init) override;
+    void Setup() override;
+
+    void SetACM(const AllowedCollisionMatrix& acm) override;
+
+    bool IsAllowedToCollide(const std::string& o1, const std::string& o2, const bool& self) override;
+
+    /// \brief Check if the whole robot is valid (collision only).
+    /// @param self Indicate if self collision check is required.
+    /// @return True, if the state is collision free.
+    bool IsStateValid(bool self = true, double safe_distance = 0.0) override;
+    bool IsCollisionFree(const std::string& o1, const std::string& o2, double safe_distance = 0.0) override;
+
+    /// \brief Computes collision distances.
+    /// \param self Indicate if self collision check is required.
+    /// \return Collision proximity objects for all colliding pairs of objects.
+    std::vector<CollisionProxy> GetCollisionDistance(bool self) override;
+    std::vector<CollisionProxy> GetCollisionDistance(const std::string& o1, const std::string& o2) override;
+    std::vector<CollisionProxy> GetCollisionDistance(const std::string& o1, const bool& self = true) override;
+    std::vector<CollisionProxy> GetCollisionDistance(const std::vector<std::string>& objects, const bool& self = true) override;
+    std::vector<CollisionProxy> GetCollisionDistance(const std::string& o1, const bool& self = true, const bool& disable_collision_scene_update = false) override;
+
+    std::vector<CollisionProxy> GetRobotToRobotCollisionDistance(double check_margin) override;
+    std::vector<CollisionProxy> GetRobotToWorldCollisionDistance(double check_margin) override;
+
+    /// @brief      Gets the collision world links.
+    /// @return     The collision world links.
+    std::vector<std::string> GetCollisionWorldLinks() override;
+
+    /// @brief      Gets the collision robot links.
+    /// @return     The collision robot links.
+    std::vector<std::string> GetCollisionRobotLinks() override;
+
+    Eigen::Vector3d GetTranslation(const std::string& name) override;
+
+    /// \brief Creates the collision scene from kinematic elements.
+    /// \param objects Vector kinematic element pointers of collision objects.
+    void UpdateCollisionObjects(const std::map<std::string, std::weak_ptr<KinematicElement>>& objects) override;
+
+    /// \brief Updates collision object transformations from the kinematic tree.
+    void UpdateCollisionObjectTransforms() override;
+
+    /// @brief      Returns the swept spheres fitted to the named collision object (in the local frame of the object).
+    std::vector<SweptSphere> GetSweptSpheres(const std::string& name);
+
+    /// @brief      Returns the exact collision scene queries are forwarded to, or nullptr if not set.
+    const CollisionScenePtr& GetExactCollisionScene() const { return exact_collision_scene_; }
+
+private:
+    /// Closest pair of swept spheres found so far for a pair of collision objects.
+    struct PairRecord
+    {
+        int sphere1;
+        int sphere2;
+        double s;
+        double t;
+        double distance;
+    };
+
+    /// Fits swept spheres to the (scaled and padded) shape of the element and appends them to the given vector.
+    void FitSweptSpheres(const int object_id, std::shared_ptr<KinematicElement> element, std::vector<SweptSphere>& out) const;
+
+    /// Covers a box (in the local frame of the object) with capsules aligned with its longest axis.
+    void FitBox(const int object_id, const Eigen::Vector3d& center, const Eigen::Matrix3d& rotation, const Eigen::Vector3d& half_extents, std::vector<SweptSphere>& out) const;
+
+    /// Precomputes which object pairs are allowed to collide (with self collisions enabled).
+    void UpdateAllowedPairs();
+
+    inline bool IsPairAllowed(int o1, int o2, bool self) const
+    {
+        return allowed_(o1, o2) && (self || !is_robot_object_[o1] || !is_robot_object_[o2]);
+    }
+
+    /// \brief Runs the batch kernel for each swept sphere of the query objects and keeps the closest swept sphere pair per object pair.
+    /// @param objects1      Query objects.
+    /// @param targets       Mask over objects to compute distances to.
+    /// @param following     If true, each query sphere is only tested against spheres with a higher index (avoids duplicate pairs).
+    /// @param begin         First swept sphere index to test against.
+    /// @param end           One past the last swept sphere index to test against.
+    /// @param check_acm     Whether to skip pairs which are not allowed to collide.
+    /// @param self          Whether robot-robot pairs are allowed (only used if check_acm is set).
+    /// @param check_margin  Only pairs closer than this distance are returned.
+    void ComputeDistances(const std::vector<int>& objects1, const std::vector<bool>& targets, const bool following, const Eigen::Index begin, const Eigen::Index end, const bool check_acm, const bool self, const double check_margin, std::vector<CollisionProxy>& proxies);
+
+    /// Returns true if any two robot/world objects allowed to collide are closer than the threshold (conservative).
+    bool IsAnyPairCloserThan(const std::vector<int>& objects1, const std::vector<bool>& targets, const bool check_acm, const bool self, const double threshold);
+
+    /// Fills the contact points and normals of a proxy from the closest points of the core segments.
+    void FillProxy(const PairRecord& record, CollisionProxy& proxy) const;
+
+    std::vector<int> GetObjectIndicesByName(const std::string& name) const;
+    std::vector<int> GetRobotObjectIndices() const;
+
+    std::vector<std::weak_ptr<KinematicElement>> kinematic_elements_;
+    std::map<std::string, std::weak_ptr<KinematicElement>> kinematic_elements_map_;
+
+    // The following maps are stored by the name of the *frame*, e.g., base_link_collision_0
+    std::map<std::string, std::vector<int>> robot_objects_map_;
+    std::map<std::string, std::vector<int>> world_objects_map_;
+    std::vector<bool> is_robot_object_;
+    Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> allowed_;
+
+    std::vector<SweptSphere> swept_spheres_;  ///< Robot spheres first, spheres of each object are contiguous
+    std::vector<int> sphere_begin_;           ///< Index of the first swept sphere of each object
+    std::vector<int> sphere_count_;           ///< Number of swept spheres of each object
+    Eigen::Index num_robot_spheres_ = 0;
+    SweptSphereBatch world_spheres_;  ///< Swept spheres transformed into the world frame
+
+    SweptSphereDistanceWorkspace workspace_;
+    Eigen::ArrayXd distance_buffer_;
+    std::unordered_map<long, PairRecord> pair_records_;
+
+    int max_spheres_per_shape_ = 4;
+    CollisionScenePtr exact_collision_scene_;
+};
+}  // namespace exotica
+
+#endif  // EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_COLLISION_SCENE_SPHERE_SWEPT_H_
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_SWEPT_SPHERE_DISTANCE_H_
+#define EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_SWEPT_SPHERE_DISTANCE_H_
+
+#include <Eigen/Dense>
+
+namespace exotica
+{
+/// Structure-of-arrays storage for a batch of swept spheres (capsules).
+/// A sphere is a capsule with coincident end points. Each coordinate is stored
+/// in its own contiguous column so that Eigen can vectorise the batch kernels.
+struct SweptSphereBatch
+{
+    Eigen::Array<double, Eigen::Dynamic, 3> a;  ///< First end point (world frame)
+    Eigen::Array<double, Eigen::Dynamic, 3> b;  ///< Second end point (world frame)
+    Eigen::ArrayXd radius;
+
+    inline void Resize(Eigen::Index n)
+    {
+        a.resize(n, 3);
+        b.resize(n, 3);
+        radius.resize(n);
+    }
+
+    inline Eigen::Index Size() const { return radius.rows(); }
+};
+
+/// Preallocated temporaries of the batch kernel. Reused across queries to avoid heap allocations.
+struct SweptSphereDistanceWorkspace
+{
+    Eigen::ArrayXd d2x, d2y, d2z, rx, ry, rz;
+    Eigen::ArrayXd b, c, e, f, denom, s, t, dx, dy, dz;
+
+    /// Ensures that the workspace can hold at least n elements. Never shrinks.
+    inline void Reserve(Eigen::Index n)
+    {
+        if (s.rows() >= n) return;
+        for (Eigen::ArrayXd* v : {&d2x, &d2y, &d2z, &rx, &ry, &rz, &b, &c, &e, &f, &denom, &s, &t, &dx, &dy, &dz}) v->resize(n);
+    }
+};
+
+/// \brief Signed distances between one swept sphere and a batch of swept spheres.
+///
+/// Closest points between the core segments follow Ericson, Real-Time Collision Detection, 5.1.9,
+/// with all branches replaced by selects so that the whole batch is evaluated with packet operations.
+///
+/// @param[in]  p1        First end point of the query segment.
+/// @param[in]  q1        Second end point of the query segment.
+/// @param[in]  r1        Radius of the query swept sphere.
+/// @param[in]  batch     Batch of swept spheres to test against.
+/// @param[in]  begin     Index of the first element of the batch to test.
+/// @param[in]  n         Number of elements to test.
+/// @param      ws        Workspace; on return the first n elements of ws.s and ws.t hold the segment parameters of the closest points.
+/// @param[out] distance  Signed distances (negative when penetrating), size n.
+inline void SweptSphereDistance(const Eigen::Vector3d& p1, const Eigen::Vector3d& q1, const double r1,
+                                const SweptSphereBatch& batch, const Eigen::Index begin, const Eigen::Index n,
+                                SweptSphereDistanceWorkspace& ws, Eigen::Ref<Eigen::ArrayXd> distance)
+{
+    constexpr double eps = 1e-12;
+    ws.Reserve(n);
+    Eigen::Ref<Eigen::ArrayXd> d2x = ws.d2x.head(n), d2y = ws.d2y.head(n), d2z = ws.d2z.head(n);
+    Eigen::Ref<Eigen::ArrayXd> rx = ws.rx.head(n), ry = ws.ry.head(n), rz = ws.rz.head(n);
+    Eigen::Ref<Eigen::ArrayXd> b = ws.b.head(n), c = ws.c.head(n), e = ws.e.head(n), f = ws.f.head(n), denom = ws.denom.head(n);
+    Eigen::Ref<Eigen::ArrayXd> s = ws.s.head(n), t = ws.t.head(n), dx = ws.dx.head(n), dy = ws.dy.head(n), dz = ws.dz.head(n);
+
+    const Eigen::Vector3d d1 = q1 - p1;
+    const double a = d1.squaredNorm();
+
+    d2x = batch.b.col(0).segment(begin, n) - batch.a.col(0).segment(begin, n);
+    d2y = batch.b.col(1).segment(begin, n) - batch.a.col(1).segment(begin, n);
+    d2z = batch.b.col(2).segment(begin, n) - batch.a.col(2).segment(begin, n);
+    rx = p1(0) - batch.a.col(0).segment(begin, n);
+    ry = p1(1) - batch.a.col(1).segment(begin, n);
+    rz = p1(2) - batch.a.col(2).segment(begin, n);
+
+    e = d2x.square() + d2y.square() + d2z.square();
+    f = d2x * rx + d2y * ry + d2z * rz;
+
+    if (a <= eps)
+    {
+        // Query is a sphere: project its centre onto each segment.
+        s.setZero();
+        t = (e > eps).select((f / e.max(eps)).max(0.0).min(1.0), 0.0);
+    }
+    else
+    {
+        b = d1(0) * d2x + d1(1) * d2y + d1(2) * d2z;
+        c = d1(0) * rx + d1(1) * ry + d1(2) * rz;
+        denom = a * e - b.square();
+
+        // Closest point on the infinite query line, clamped to the segment (s = 0 for parallel segments).
+        s = (denom > eps).select(((b * f - c * e) / denom.max(eps)).max(0.0).min(1.0), 0.0);
+        t = (b * s + f) / e.max(eps);
+
+        // If t leaves [0, 1], clamp it and recompute s for the clamped end point.
+        s = (t < 0.0).select((-c / a).max(0.0).min(1.0), (t > 1.0).select(((b - c) / a).max(0.0).min(1.0), s));
+        t = t.max(0.0).min(1.0);
+
+        // Degenerate batch elements (spheres): t = 0 and s is the projection onto the query segment.
+        s = (e > eps).select(s, (-c / a).max(0.0).min(1.0));
+        t = (e > eps).select(t, 0.0);
+    }
+
+    // c1 - c2 = r + d1 * s - d2 * t
+    dx = rx + d1(0) * s - d2x * t;
+    dy = ry + d1(1) * s - d2y * t;
+    dz = rz + d1(2) * s - d2z * t;
+    distance = (dx.square() + dy.square() + dz.square()).sqrt() - r1 - batch.radius.segment(begin, n);
+}
+}  // namespace exotica
+
+#endif  // EXOTICA_COLLISION_SCENE_SPHERE_SWEPT_SWEPT_SPHERE_DISTANCE_H_
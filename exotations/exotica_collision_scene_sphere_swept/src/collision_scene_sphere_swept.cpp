@@ -0,0 +1,595 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <exotica_collision_scene_sphere_swept/collision_scene_sphere_swept.h>
+#include <exotica_core/factory.h>
+#include <exotica_core/scene.h>
+#include <exotica_core/setup.h>
+
+#include <geometric_shapes/shape_operations.h>
+#include <octomap/OcTree.h>
+
+#include <algorithm>
+#include <limits>
+
+REGISTER_COLLISION_SCENE_TYPE("CollisionSceneSphereSwept", exotica::CollisionSceneSphereSwept)
+
+namespace exotica
+{
+inline bool IsRobotLink(std::shared_ptr<KinematicElement> e)
+{
+    return e->is_robot_link || e->closest_robot_link.lock();
+}
+
+void CollisionSceneSphereSwept::Instantiate(const CollisionSceneSphereSweptInitializer& init)
+{
+    Instantiable<CollisionSceneSphereSweptInitializer>::Instantiate(init);
+    if (init.MaxSpheresPerShape < 1) ThrowPretty("MaxSpheresPerShape needs to be at least 1, got " << init.MaxSpheresPerShape);
+    max_spheres_per_shape_ = init.MaxSpheresPerShape;
+
+    if (init.ExactCollisionScene.size() > 1) ThrowPretty("Only one ExactCollisionScene allowed - " << init.ExactCollisionScene.size() << " provided");
+    if (init.ExactCollisionScene.size() == 1)
+    {
+        exact_collision_scene_ = exotica::Setup::CreateCollisionScene(init.ExactCollisionScene[0]);
+    }
+}
+
+void CollisionSceneSphereSwept::Setup()
+{
+    if (exact_collision_scene_ == nullptr) return;
+
+    // The exact scene sees the same (scaled and padded) shapes as the approximation.
+    exact_collision_scene_->debug_ = debug_;
+    exact_collision_scene_->SetRobotLinkScale(robot_link_scale_);
+    exact_collision_scene_->SetWorldLinkScale(world_link_scale_);
+    exact_collision_scene_->SetRobotLinkPadding(robot_link_padding_);
+    exact_collision_scene_->SetWorldLinkPadding(world_link_padding_);
+    exact_collision_scene_->Setup();
+}
+
+void CollisionSceneSphereSwept::SetACM(const AllowedCollisionMatrix& acm)
+{
+    CollisionScene::SetACM(acm);
+    if (exact_collision_scene_) exact_collision_scene_->SetACM(acm);
+    if (!kinematic_elements_.empty()) UpdateAllowedPairs();
+}
+
+void CollisionSceneSphereSwept::UpdateCollisionObjects(const std::map<std::string, std::weak_ptr<KinematicElement>>& objects)
+{
+    kinematic_elements_map_ = objects;
+    kinematic_elements_.clear();
+    kinematic_elements_.reserve(objects.size());
+    is_robot_object_.clear();
+    robot_objects_map_.clear();
+    world_objects_map_.clear();
+
+    std::vector<SweptSphere> robot_spheres, world_spheres;
+    std::vector<int> object_sphere_count;
+
+    auto world_links_to_exclude_from_collision_scene = scene_.lock()->get_world_links_to_exclude_from_collision_scene();
+    for (const auto& object : objects)
+    {
+        if (world_links_to_exclude_from_collision_scene.count(object.first) > 0)
+        {
+            if (debug_) HIGHLIGHT_NAMED("CollisionSceneSphereSwept::UpdateCollisionObject", object.first << " is excluded, skipping.");
+            continue;
+        }
+
+        std::shared_ptr<KinematicElement> element = object.second.lock();
+        const int i = static_cast<int>(kinematic_elements_.size());
+        const bool is_robot = IsRobotLink(element);
+        kinematic_elements_.emplace_back(object.second);
+        is_robot_object_.push_back(is_robot);
+
+        std::vector<SweptSphere>& spheres = is_robot ? robot_spheres : world_spheres;
+        const std::size_t before = spheres.size();
+        FitSweptSpheres(i, element, spheres);
+        object_sphere_count.push_back(static_cast<int>(spheres.size() - before));
+
+        if (is_robot)
+        {
+            robot_objects_map_[object.first].emplace_back(i);
+        }
+        else
+        {
+            world_objects_map_[object.first].emplace_back(i);
+        }
+
+        if (debug_) HIGHLIGHT_NAMED("CollisionSceneSphereSwept::UpdateCollisionObject", "Created " << object.first << " from " << object_sphere_count.back() << " swept spheres");
+    }
+
+    // Robot spheres first so that robot-only queries operate on a contiguous block.
+    swept_spheres_ = std::move(robot_spheres);
+    num_robot_spheres_ = static_cast<Eigen::Index>(swept_spheres_.size());
+    swept_spheres_.insert(swept_spheres_.end(), world_spheres.begin(), world_spheres.end());
+
+    sphere_begin_.assign(kinematic_elements_.size(), 0);
+    sphere_count_ = object_sphere_count;
+    for (int k = static_cast<int>(swept_spheres_.size()) - 1; k >= 0; --k) sphere_begin_[swept_spheres_[k].object] = k;
+
+    world_spheres_.Resize(static_cast<Eigen::Index>(swept_spheres_.size()));
+    distance_buffer_.resize(static_cast<Eigen::Index>(swept_spheres_.size()));
+    workspace_.Reserve(static_cast<Eigen::Index>(swept_spheres_.size()));
+
+    UpdateAllowedPairs();
+
+    if (exact_collision_scene_)
+    {
+        exact_collision_scene_->AssignScene(scene_.lock());
+        exact_collision_scene_->SetAlwaysExternallyUpdatedCollisionScene(always_externally_updated_collision_scene_);
+        exact_collision_scene_->UpdateCollisionObjects(objects);
+    }
+
+    needs_update_of_collision_objects_ = false;
+}
+
+void CollisionSceneSphereSwept::UpdateAllowedPairs()
+{
+    const int n = static_cast<int>(kinematic_elements_.size());
+    allowed_.setConstant(n, n, false);
+    for (int i = 0; i < n; ++i)
+    {
+        std::shared_ptr<KinematicElement> e1 = kinematic_elements_[i].lock();
+        for (int j = i + 1; j < n; ++j)
+        {
+            std::shared_ptr<KinematicElement> e2 = kinematic_elements_[j].lock();
+            bool allowed = true;
+            // Don't check collisions between world objects
+            if (!is_robot_object_[i] && !is_robot_object_[j]) allowed = false;
+            // Skip collisions between shapes within the same objects
+            else if (e1->parent.lock() == e2->parent.lock()) allowed = false;
+            // Skip collisions between bodies attached to the same object
+            else if (e1->closest_robot_link.lock() && e2->closest_robot_link.lock() && e1->closest_robot_link.lock() == e2->closest_robot_link.lock()) allowed = false;
+            else if (is_robot_object_[i] && is_robot_object_[j])
+            {
+                const std::string& name1 = e1->closest_robot_link.lock() ? e1->closest_robot_link.lock()->segment.getName() : e1->parent.lock()->segment.getName();
+                const std::string& name2 = e2->closest_robot_link.lock() ? e2->closest_robot_link.lock()->segment.getName() : e2->parent.lock()->segment.getName();
+                allowed = acm_.getAllowedCollision(name1, name2);
+            }
+            allowed_(i, j) = allowed_(j, i) = allowed;
+        }
+    }
+}
+
+void CollisionSceneSphereSwept::FitSweptSpheres(const int object_id, std::shared_ptr<KinematicElement> element, std::vector<SweptSphere>& out) const
+{
+    shapes::ShapePtr shape(element->shape->clone());
+
+    // Apply scaling and padding
+    if (IsRobotLink(element))
+    {
+        if (robot_link_scale_ != 1.0 || robot_link_padding_ > 0.0)
+        {
+            shape->scaleAndPadd(robot_link_scale_, robot_link_padding_);
+        }
+    }
+    else
+    {
+        if (world_link_scale_ != 1.0 || world_link_padding_ > 0.0)
+        {
+            shape->scaleAndPadd(world_link_scale_, world_link_padding_);
+        }
+    }
+
+    SweptSphere sphere;
+    sphere.object = object_id;
+    switch (shape->type)
+    {
+        case shapes::SPHERE:
+        {
+            auto s = dynamic_cast<const shapes::Sphere*>(shape.get());
+            sphere.a.setZero();
+            sphere.b.setZero();
+            sphere.radius = s->radius;
+            out.push_back(sphere);
+        }
+        break;
+        case shapes::CYLINDER:
+        {
+            auto s = dynamic_cast<const shapes::Cylinder*>(shape.get());
+            // A capsule with the same radius and full length encloses the cylinder. If cylinders are replaced
+            // with capsules, use the same capsule as the exact collision scene.
+            const bool degenerate_capsule = (s->length <= 2 * s->radius);
+            const double half_length = (replace_cylinders_with_capsules_ && !degenerate_capsule) ? 0.5 * s->length - s->radius : 0.5 * s->length;
+            sphere.a = Eigen::Vector3d(0, 0, -half_length);
+            sphere.b = Eigen::Vector3d(0, 0, half_length);
+            sphere.radius = s->radius;
+            out.push_back(sphere);
+        }
+        break;
+        case shapes::CONE:
+        {
+            auto s = dynamic_cast<const shapes::Cone*>(shape.get());
+            sphere.a = Eigen::Vector3d(0, 0, -0.5 * s->length);
+            sphere.b = Eigen::Vector3d(0, 0, 0.5 * s->length);
+            sphere.radius = s->radius;
+            out.push_back(sphere);
+        }
+        break;
+        case shapes::BOX:
+        {
+            auto s = dynamic_cast<const shapes::Box*>(shape.get());
+            FitBox(object_id, Eigen::Vector3d::Zero(), Eigen::Matrix3d::Identity(), 0.5 * Eigen::Map<const Eigen::Vector3d>(s->size), out);
+        }
+        break;
+        case shapes::MESH:
+        {
+            auto mesh = dynamic_cast<const shapes::Mesh*>(shape.get());
+            if (mesh->vertex_count == 0) ThrowPretty("Mesh of " << element->segment.getName() << " has no vertices.");
+            Eigen::Map<const Eigen::Matrix3Xd> vertices(mesh->vertices, 3, mesh->vertex_count);
+
+            // Fit an oriented bounding box along the principal axes of the vertices.
+            const Eigen::Vector3d mean = vertices.rowwise().mean();
+            const Eigen::Matrix3Xd centered = vertices.colwise() - mean;
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(centered * centered.transpose());
+            const Eigen::Matrix3d rotation = eig.eigenvectors();
+            const Eigen::Matrix3Xd local = rotation.transpose() * centered;
+            const Eigen::Vector3d min = local.rowwise().minCoeff();
+            const Eigen::Vector3d max = local.rowwise().maxCoeff();
+            FitBox(object_id, mean + rotation * (0.5 * (max + min)), rotation, 0.5 * (max - min), out);
+        }
+        break;
+        case shapes::OCTREE:
+        {
+            // Enclose every occupied leaf with a sphere.
+            auto g = dynamic_cast<const shapes::OcTree*>(shape.get());
+            for (auto it = g->octree->begin_leafs(), end = g->octree->end_leafs(); it != end; ++it)
+            {
+                if (!g->octree->isNodeOccupied(*it)) continue;
+                sphere.a = Eigen::Vector3d(it.getX(), it.getY(), it.getZ());
+                sphere.b = sphere.a;
+                sphere.radius = 0.5 * std::sqrt(3.0) * it.getSize();
+                out.push_back(sphere);
+            }
+        }
+        break;
+        default:
+            ThrowPretty("This shape type (" << ((int)shape->type) << ") is not supported by CollisionSceneSphereSwept");
+    }
+}
+
+void CollisionSceneSphereSwept::FitBox(const int object_id, const Eigen::Vector3d& center, const Eigen::Matrix3d& rotation, const Eigen::Vector3d& half_extents, std::vector<SweptSphere>& out) const
+{
+    // Sort axes by extent: the capsules are aligned with the longest axis and the box is sliced along the middle one.
+    int axes[3] = {0, 1, 2};
+    std::sort(axes, axes + 3, [&half_extents](int i, int j) { return half_extents(i) > half_extents(j); });
+    const double h0 = half_extents(axes[0]);
+    const double h1 = half_extents(axes[1]);
+    const double h2 = half_extents(axes[2]);
+
+    int num_slices = max_spheres_per_shape_;
+    if (h2 > 0.0) num_slices = std::min(max_spheres_per_shape_, std::max(1, static_cast<int>(std::ceil(h1 / h2))));
+    const double w = h1 / num_slices;
+
+    SweptSphere sphere;
+    sphere.object = object_id;
+    sphere.radius = std::sqrt(w * w + h2 * h2);
+    for (int k = 0; k < num_slices; ++k)
+    {
+        Eigen::Vector3d a = Eigen::Vector3d::Zero(), b = Eigen::Vector3d::Zero();
+        a(axes[0]) = -h0;
+        b(axes[0]) = h0;
+        a(axes[1]) = b(axes[1]) = -h1 + w * (2 * k + 1);
+        sphere.a = center + rotation * a;
+        sphere.b = center + rotation * b;
+        out.push_back(sphere);
+    }
+}
+
+void CollisionSceneSphereSwept::UpdateCollisionObjectTransforms()
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::UpdateCollisionObjectTransforms");
+    for (std::size_t k = 0; k < swept_spheres_.size(); ++k)
+    {
+        const SweptSphere& sphere = swept_spheres_[k];
+        std::shared_ptr<KinematicElement> element = kinematic_elements_[sphere.object].lock();
+        if (!element)
+        {
+            ThrowPretty("Expired pointer, this should not happen - make sure to call UpdateCollisionObjects() after UpdateSceneFrames()");
+        }
+
+        const KDL::Vector a = element->frame * KDL::Vector(sphere.a(0), sphere.a(1), sphere.a(2));
+        const KDL::Vector b = element->frame * KDL::Vector(sphere.b(0), sphere.b(1), sphere.b(2));
+        world_spheres_.a.row(k) << a.x(), a.y(), a.z();
+        world_spheres_.b.row(k) << b.x(), b.y(), b.z();
+        world_spheres_.radius(k) = sphere.radius;
+    }
+
+    if (!world_spheres_.a.allFinite() || !world_spheres_.b.allFinite()) ThrowPretty("Collision object transforms contain NaNs.");
+
+    // When externally updated, the exact scene does not update itself on queries.
+    if (exact_collision_scene_ && always_externally_updated_collision_scene_) exact_collision_scene_->UpdateCollisionObjectTransforms();
+}
+
+void CollisionSceneSphereSwept::ComputeDistances(const std::vector<int>& objects1, const std::vector<bool>& targets, const bool following, const Eigen::Index begin, const Eigen::Index end, const bool check_acm, const bool self, const double check_margin, std::vector<CollisionProxy>& proxies)
+{
+    const long num_objects = static_cast<long>(kinematic_elements_.size());
+    pair_records_.clear();
+
+    for (const int o1 : objects1)
+    {
+        for (int k = sphere_begin_[o1]; k < sphere_begin_[o1] + sphere_count_[o1]; ++k)
+        {
+            const Eigen::Index first = following ? std::max(begin, static_cast<Eigen::Index>(k + 1)) : begin;
+            const Eigen::Index n = end - first;
+            if (n <= 0) continue;
+
+            SweptSphereDistance(world_spheres_.a.row(k).transpose().matrix(), world_spheres_.b.row(k).transpose().matrix(), world_spheres_.radius(k),
+                                world_spheres_, first, n, workspace_, distance_buffer_.head(n));
+
+            for (Eigen::Index j = 0; j < n; ++j)
+            {
+                const double distance = distance_buffer_(j);
+                if (distance >= check_margin) continue;
+                const int o2 = swept_spheres_[first + j].object;
+                if (o2 == o1 || !targets[o2]) continue;
+                if (check_acm && !IsPairAllowed(o1, o2, self)) continue;
+
+                const long key = o1 * num_objects + o2;
+                auto it = pair_records_.find(key);
+                if (it == pair_records_.end() || distance < it->second.distance)
+                {
+                    pair_records_[key] = {k, static_cast<int>(first + j), workspace_.s(j), workspace_.t(j), distance};
+                }
+            }
+        }
+    }
+
+    proxies.reserve(proxies.size() + pair_records_.size());
+    for (const auto& it : pair_records_)
+    {
+        CollisionProxy p;
+        FillProxy(it.second, p);
+        proxies.push_back(p);
+    }
+}
+
+bool CollisionSceneSphereSwept::IsAnyPairCloserThan(const std::vector<int>& objects1, const std::vector<bool>& targets, const bool check_acm, const bool self, const double threshold)
+{
+    for (const int o1 : objects1)
+    {
+        for (int k = sphere_begin_[o1]; k < sphere_begin_[o1] + sphere_count_[o1]; ++k)
+        {
+            const Eigen::Index first = k + 1;
+            const Eigen::Index n = static_cast<Eigen::Index>(swept_spheres_.size()) - first;
+            if (n <= 0) continue;
+
+            SweptSphereDistance(world_spheres_.a.row(k).transpose().matrix(), world_spheres_.b.row(k).transpose().matrix(), world_spheres_.radius(k),
+                                world_spheres_, first, n, workspace_, distance_buffer_.head(n));
+            if (distance_buffer_.head(n).minCoeff() >= threshold) continue;
+
+            for (Eigen::Index j = 0; j < n; ++j)
+            {
+                if (distance_buffer_(j) >= threshold) continue;
+                const int o2 = swept_spheres_[first + j].object;
+                if (o2 == o1 || !targets[o2]) continue;
+                if (check_acm && !IsPairAllowed(o1, o2, self)) continue;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void CollisionSceneSphereSwept::FillProxy(const PairRecord& record, CollisionProxy& p) const
+{
+    const Eigen::Vector3d a1 = world_spheres_.a.row(record.sphere1).transpose().matrix();
+    const Eigen::Vector3d b1 = world_spheres_.b.row(record.sphere1).transpose().matrix();
+    const Eigen::Vector3d a2 = world_spheres_.a.row(record.sphere2).transpose().matrix();
+    const Eigen::Vector3d b2 = world_spheres_.b.row(record.sphere2).transpose().matrix();
+    const Eigen::Vector3d c1 = a1 + record.s * (b1 - a1);
+    const Eigen::Vector3d c2 = a2 + record.t * (b2 - a2);
+
+    p.e1 = kinematic_elements_[swept_spheres_[record.sphere1].object].lock();
+    p.e2 = kinematic_elements_[swept_spheres_[record.sphere2].object].lock();
+    p.distance = record.distance;
+
+    // If the core segments intersect, the normal is ill-defined. Use the shape centres as a proxy.
+    Eigen::Vector3d n = c2 - c1;
+    if (n.norm() < 1e-12) n = Eigen::Map<const Eigen::Vector3d>(p.e2->frame.p.data) - Eigen::Map<const Eigen::Vector3d>(p.e1->frame.p.data);
+    if (n.norm() < 1e-12) n = Eigen::Vector3d::UnitZ();
+    n.normalize();
+
+    p.contact1 = c1 + world_spheres_.radius(record.sphere1) * n;
+    p.contact2 = c2 - world_spheres_.radius(record.sphere2) * n;
+
+    // Same convention as CollisionSceneFCLLatest: normal1 points from contact1 towards contact2, i.e., it flips on penetration.
+    if (record.distance < 0.0) n = -n;
+    p.normal1 = n;
+    p.normal2 = -n;
+}
+
+std::vector<int> CollisionSceneSphereSwept::GetObjectIndicesByName(const std::string& name) const
+{
+    std::vector<int> ret;
+    for (std::size_t i = 0; i < kinematic_elements_.size(); ++i)
+    {
+        std::shared_ptr<KinematicElement> e = kinematic_elements_[i].lock();
+        // NB: Same as in CollisionSceneFCLLatest, the name can be either the name of the link or of the collision object.
+        if (e->segment.getName() == name || e->parent.lock()->segment.getName() == name) ret.push_back(static_cast<int>(i));
+    }
+    return ret;
+}
+
+std::vector<int> CollisionSceneSphereSwept::GetRobotObjectIndices() const
+{
+    std::vector<int> ret;
+    for (std::size_t i = 0; i < kinematic_elements_.size(); ++i)
+    {
+        if (is_robot_object_[i]) ret.push_back(static_cast<int>(i));
+    }
+    return ret;
+}
+
+bool CollisionSceneSphereSwept::IsAllowedToCollide(const std::string& o1, const std::string& o2, const bool& self)
+{
+    const std::vector<int> objects1 = GetObjectIndicesByName(o1);
+    const std::vector<int> objects2 = GetObjectIndicesByName(o2);
+    if (objects1.size() == 0) ThrowPretty("KinematicElement is not a valid collision link:" << o1);
+    if (objects2.size() == 0) ThrowPretty("KinematicElement is not a valid collision link:" << o2);
+    return IsPairAllowed(objects1[0], objects2[0], self);
+}
+
+bool CollisionSceneSphereSwept::IsStateValid(bool self, double safe_distance)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::IsStateValid");
+    if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
+
+    const std::vector<bool> targets(kinematic_elements_.size(), true);
+    if (!IsAnyPairCloserThan(GetRobotObjectIndices(), targets, true, self, safe_distance)) return true;
+
+    // The approximation cannot prove that the state is free.
+    if (exact_collision_scene_) return exact_collision_scene_->IsStateValid(self, safe_distance);
+    return false;
+}
+
+bool CollisionSceneSphereSwept::IsCollisionFree(const std::string& o1, const std::string& o2, double safe_distance)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::IsCollisionFree");
+    if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
+
+    const std::vector<int> objects1 = GetObjectIndicesByName(o1);
+    const std::vector<int> objects2 = GetObjectIndicesByName(o2);
+    if (objects1.size() == 0) ThrowPretty("Can't find object '" << o1 << "'!");
+    if (objects2.size() == 0) ThrowPretty("Can't find object '" << o2 << "'!");
+
+    std::vector<bool> targets(kinematic_elements_.size(), false);
+    for (int i : objects2) targets[i] = true;
+    std::vector<CollisionProxy> proxies;
+    ComputeDistances(objects1, targets, false, 0, static_cast<Eigen::Index>(swept_spheres_.size()), false, true, safe_distance, proxies);
+    if (proxies.empty()) return true;
+
+    if (exact_collision_scene_) return exact_collision_scene_->IsCollisionFree(o1, o2, safe_distance);
+    return false;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetCollisionDistance(bool self)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetCollisionDistance");
+    if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
+
+    std::vector<CollisionProxy> proxies;
+    const std::vector<bool> targets(kinematic_elements_.size(), true);
+    ComputeDistances(GetRobotObjectIndices(), targets, true, 0, static_cast<Eigen::Index>(swept_spheres_.size()), true, self, std::numeric_limits<double>::infinity(), proxies);
+    return proxies;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetCollisionDistance(const std::string& o1, const std::string& o2)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetCollisionDistance");
+    if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
+
+    const std::vector<int> objects1 = GetObjectIndicesByName(o1);
+    const std::vector<int> objects2 = GetObjectIndicesByName(o2);
+    if (objects1.size() == 0) ThrowPretty("Can't find object '" << o1 << "'!");
+    if (objects2.size() == 0) ThrowPretty("Can't find object '" << o2 << "'!");
+
+    std::vector<bool> targets(kinematic_elements_.size(), false);
+    for (int i : objects2) targets[i] = true;
+    std::vector<CollisionProxy> proxies;
+    ComputeDistances(objects1, targets, false, 0, static_cast<Eigen::Index>(swept_spheres_.size()), false, true, std::numeric_limits<double>::infinity(), proxies);
+    return proxies;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetCollisionDistance(const std::string& o1, const bool& self)
+{
+    return GetCollisionDistance(o1, self, false);
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetCollisionDistance(const std::string& o1, const bool& self, const bool& disable_collision_scene_update)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetCollisionDistance");
+    if (!always_externally_updated_collision_scene_ && !disable_collision_scene_update) UpdateCollisionObjectTransforms();
+
+    std::vector<CollisionProxy> proxies;
+    const std::vector<int> objects1 = GetObjectIndicesByName(o1);
+    if (objects1.size() == 0) return proxies;
+
+    const std::vector<bool> targets(kinematic_elements_.size(), true);
+    ComputeDistances(objects1, targets, false, 0, static_cast<Eigen::Index>(swept_spheres_.size()), true, self, std::numeric_limits<double>::infinity(), proxies);
+    return proxies;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetCollisionDistance(const std::vector<std::string>& objects, const bool& self)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetCollisionDistance");
+    if (!always_externally_updated_collision_scene_) UpdateCollisionObjectTransforms();
+
+    std::vector<CollisionProxy> proxies;
+    for (const auto& o1 : objects)
+        AppendVector(proxies, GetCollisionDistance(o1, self, true));
+
+    return proxies;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetRobotToRobotCollisionDistance(double check_margin)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetRobotToRobotCollisionDistance");
+    std::vector<CollisionProxy> proxies;
+    const std::vector<bool> targets(is_robot_object_.begin(), is_robot_object_.end());
+    ComputeDistances(GetRobotObjectIndices(), targets, true, 0, num_robot_spheres_, true, true, check_margin, proxies);
+    return proxies;
+}
+
+std::vector<CollisionProxy> CollisionSceneSphereSwept::GetRobotToWorldCollisionDistance(double check_margin)
+{
+    EXOTICA_PROFILE_ZONE("CollisionSceneSphereSwept::GetRobotToWorldCollisionDistance");
+    std::vector<CollisionProxy> proxies;
+    const std::vector<bool> targets(kinematic_elements_.size(), true);
+    ComputeDistances(GetRobotObjectIndices(), targets, false, num_robot_spheres_, static_cast<Eigen::Index>(swept_spheres_.size()), true, false, check_margin, proxies);
+    return proxies;
+}
+
+std::vector<CollisionSceneSphereSwept::SweptSphere> CollisionSceneSphereSwept::GetSweptSpheres(const std::string& name)
+{
+    std::vector<SweptSphere> ret;
+    for (int i : GetObjectIndicesByName(name))
+    {
+        ret.insert(ret.end(), swept_spheres_.begin() + sphere_begin_[i], swept_spheres_.begin() + sphere_begin_[i] + sphere_count_[i]);
+    }
+    return ret;
+}
+
+Eigen::Vector3d CollisionSceneSphereSwept::GetTranslation(const std::string& name)
+{
+    auto it = kinematic_elements_map_.find(name);
+    if (it == kinematic_elements_map_.end()) ThrowPretty("KinematicElement is not a valid collision link:" << name);
+    return Eigen::Map<Eigen::Vector3d>(it->second.lock()->frame.p.data);
+}
+
+std::vector<std::string> CollisionSceneSphereSwept::GetCollisionWorldLinks()
+{
+    return GetKeysFromMap(world_objects_map_);
+}
+
+std::vector<std::string> CollisionSceneSphereSwept::GetCollisionRobotLinks()
+{
+    return GetKeysFromMap(robot_objects_map_);
+}
+}  // namespace exotica
@@ -46,10 +46,12 @@ public:
     void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi) override;
     void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian) override;
     int TaskSpaceDim() override;
+    KinematicRequestFlags GetKinematicRequestFlags() const override;
 
 private:
     void Initialize();
     void InitializeDebug();
+    void PublishDebug(Eigen::VectorXdRefConst phi);
 
     Eigen::VectorXd mass_;
     ros::Publisher com_links_pub_;
@@ -36,6 +36,31 @@
 
 namespace exotica
 {
+/// @brief Publishes the point, the line and their distance of PointToLine and PointToLineAutoDiff as RViz markers.
+class PointToLineVisualization
+{
+public:
+    /// @brief Advertises the marker topics and deletes the markers of previous runs.
+    /// @param object_name name of the task map, used for the marker namespaces
+    /// @param link_name frame of the point, used as label
+    /// @param base_name frame of the line, in which the markers are published
+    void Initialize(const std::string& object_name, const std::string& link_name, const std::string& base_name);
+
+    /// @brief Publishes the markers of one point.
+    /// @param line_start start point of line in base frame
+    /// @param point point in base frame
+    /// @param dv vector from #point to its projection on the line
+    void Publish(const Eigen::Vector3d& line_start, const Eigen::Vector3d& point, const Eigen::Vector3d& dv);
+
+private:
+    std::string object_name_;
+    std::string link_name_;
+    std::string base_name_;
+
+    ros::Publisher pub_marker_;        ///< publish marker for RViz
+    ros::Publisher pub_marker_label_;  ///< marker label
+};
+
 class PointToLine : public TaskMap, public Instantiable<PointToLineInitializer>
 {
 public:
@@ -67,9 +92,7 @@ private:
     std::string link_name_;  ///< frame of defined point
     std::string base_name_;  ///< frame of defined line
 
-    ros::Publisher pub_marker_;        ///< publish marker for RViz
-    ros::Publisher pub_marker_label_;  ///< marker label
-
+    PointToLineVisualization visualization_;
     bool visualize_;
 };
 }  // namespace exotica
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_TASK_MAPS_POINT_TO_LINE_AUTODIFF_H_
+#define EXOTICA_CORE_TASK_MAPS_POINT_TO_LINE_AUTODIFF_H_
+
+#include <exotica_core/autodiff_task_map.h>
+#include <exotica_core_task_maps/point_to_line.h>
+
+#include <exotica_core_task_maps/point_to_line_autodiff_initializer.h>
+
+namespace exotica
+{
+/// @brief Same task as PointToLine with derivatives computed by automatic differentiation. Both ends of a finite segment are clipped and differentiated.
+class PointToLineAutoDiff : public AutoDiffTaskMap<PointToLineAutoDiff, 1, 3, false>, public Instantiable<PointToLineAutoDiffInitializer>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    PointToLineAutoDiff();
+    virtual ~PointToLineAutoDiff();
+
+    void Instantiate(const PointToLineAutoDiffInitializer& init) override;
+
+    void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian) override;
+    using AutoDiffTaskMap::Update;
+
+    Eigen::Vector3d GetEndPoint();
+    void SetEndPoint(const Eigen::Vector3d& point);
+
+    /// @brief Computes the vector from the point to its projection on the line
+    /// http://mathworld.wolfram.com/Point-LineDistance3-Dimensional.html
+    /// let:
+    ///      s: start of line
+    ///      e: end of line
+    ///      p: point
+    /// then the point on vector v = e-s that is closest to p is vp = s + t*(e-s) with
+    /// t = -((s-p)*(e-s)) / (|e-s|^2)    (* denotes the dot product)
+    template <typename T>
+    void Eval(const Eigen::Matrix<T, 3, 1>& frame, Eigen::Matrix<T, 3, 1>& phi, int /*i*/) const
+    {
+        // point in base frame
+        const Eigen::Matrix<T, 3, 1> p = line_start_.cast<T>() + Position(frame, 0);
+        T t = -(line_start_.cast<T>() - p).dot(line_.cast<T>()) / line_.squaredNorm();
+        if (!infinite_)
+        {
+            // clip to to range [0,1]
+            if (t < 0.0)
+                t = T(0.0);
+            else if (t > 1.0)
+                t = T(1.0);
+        }
+
+        // vector from point 'p' to point 'vp' on line
+        phi = line_start_.cast<T>() + t * line_.cast<T>() - p;
+    }
+
+private:
+    Eigen::Vector3d line_start_;  ///< start point of line in base frame
+    Eigen::Vector3d line_end_;    ///< end point of line in base frame
+    Eigen::Vector3d line_;        ///< vector from start to end point of line
+    bool infinite_;               ///< true: vector from start to end defines the direction of and infinite line
+                                  ///< false: start and end define a line segment
+
+    std::string link_name_;  ///< frame of defined point
+    std::string base_name_;  ///< frame of defined line
+
+    PointToLineVisualization visualization_;
+    bool visualize_;
+};
+}  // namespace exotica
+
+#endif  // EXOTICA_CORE_TASK_MAPS_POINT_TO_LINE_AUTODIFF_H_
@@ -50,6 +50,7 @@ public:
     void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi) override;
     void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian) override;
     int TaskSpaceDim() override;
+    KinematicRequestFlags GetKinematicRequestFlags() const override;
 
 private:
     void Initialize();
@@ -37,34 +37,35 @@ namespace exotica
 void CenterOfMass::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi)
 {
     if (phi.rows() != dim_) ThrowNamed("Wrong size of phi!");
-    double M = mass_.sum();
-    if (M == 0.0) return;
 
-    KDL::Vector com;
-    for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
+    if (frames_.size() > 0)
     {
-        com += kinematics[0].Phi(i).p * mass_(i);
-        if (debug_)
+        double M = mass_.sum();
+        if (M == 0.0) return;
+
+        KDL::Vector com;
+        for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
         {
-            com_links_marker_.points[i].x = kinematics[0].Phi(i).p[0];
-            com_links_marker_.points[i].y = kinematics[0].Phi(i).p[1];
-            com_links_marker_.points[i].z = kinematics[0].Phi(i).p[2];
+            com += kinematics[0].Phi(i).p * mass_(i);
+            if (debug_)
+            {
+                com_links_marker_.points[i].x = kinematics[0].Phi(i).p[0];
+                com_links_marker_.points[i].y = kinematics[0].Phi(i).p[1];
+                com_links_marker_.points[i].z = kinematics[0].Phi(i).p[2];
+            }
         }
-    }
-
-    com = com / M;
-    for (int i = 0; i < dim_; ++i) phi(i) = com[i];
 
-    if (debug_ && Server::IsRos())
+        com = com / M;
+        for (int i = 0; i < dim_; ++i) phi(i) = com[i];
+    }
+    else
     {
-        com_marker_.pose.position.x = phi(0);
-        com_marker_.pose.position.y = phi(1);
-        com_marker_.pose.position.z = phi(2);
-
-        com_marker_.header.stamp = com_links_marker_.header.stamp = ros::Time::now();
-        com_links_pub_.publish(com_links_marker_);
-        com_pub_.publish(com_marker_);
+        // Composite center of mass of the robot links and attached objects maintained by the KinematicTree (KIN_COM)
+        if (scene_->GetKinematicTree().GetTotalMass() == 0.0) return;
+        phi = scene_->GetKinematicTree().GetCenterOfMass().head(dim_);
     }
+
+    PublishDebug(phi);
 }
 
 void CenterOfMass::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian)
@@ -72,10 +73,10 @@ void CenterOfMass::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eig
     if (phi.rows() != dim_) ThrowNamed("Wrong size of phi!");
     if (jacobian.rows() != dim_ || jacobian.cols() != x.rows()) ThrowNamed("Wrong size of jacobian! " << x.rows());
     jacobian.setZero();
-    KDL::Vector com;
 
     if (frames_.size() > 0)
     {
+        KDL::Vector com;
         double M = mass_.sum();
         if (M == 0.0) return;
         for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
@@ -90,47 +91,25 @@ void CenterOfMass::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eig
             }
         }
         com = com / M;
+        for (int i = 0; i < dim_; ++i) phi(i) = com[i];
     }
     else
     {
-        if (debug_) com_links_marker_.points.resize(0);
-        double M = 0.0;
-        for (std::weak_ptr<KinematicElement> welement : scene_->GetKinematicTree().GetTree())
-        {
-            std::shared_ptr<KinematicElement> element = welement.lock();
-            if (element->is_robot_link || element->closest_robot_link.lock())  // Only for robot links and attached objects
-            {
-                double mass = element->segment.getInertia().getMass();
-                if (mass > 0)
-                {
-                    KDL::Frame cog = KDL::Frame(element->segment.getInertia().getCOG());
-                    KDL::Frame com_local = scene_->GetKinematicTree().FK(element, cog, nullptr, KDL::Frame());
-                    Eigen::MatrixXd jacobian_com_local = scene_->GetKinematicTree().Jacobian(element, cog, nullptr, KDL::Frame());
-                    com += com_local.p * mass;
-                    jacobian += jacobian_com_local.topRows(dim_) * mass;
-                    M += mass;
-                    if (debug_)
-                    {
-                        geometry_msgs::Point pt;
-                        pt.x = com_local.p[0];
-                        pt.y = com_local.p[1];
-                        pt.z = com_local.p[2];
-                        com_links_marker_.points.push_back(pt);
-                    }
-                }
-            }
-        }
-        if (M == 0.0) return;
-        com = com / M;
-        jacobian = jacobian / M;
+        if (scene_->GetKinematicTree().GetTotalMass() == 0.0) return;
+        phi = scene_->GetKinematicTree().GetCenterOfMass().head(dim_);
+        jacobian = scene_->GetKinematicTree().GetCenterOfMassJacobian().topRows(dim_);
     }
-    for (int i = 0; i < dim_; ++i) phi(i) = com[i];
 
+    PublishDebug(phi);
+}
+
+void CenterOfMass::PublishDebug(Eigen::VectorXdRefConst phi)
+{
     if (debug_ && Server::IsRos())
     {
         com_marker_.pose.position.x = phi(0);
         com_marker_.pose.position.y = phi(1);
-        com_marker_.pose.position.z = phi(2);
+        com_marker_.pose.position.z = dim_ == 3 ? phi(2) : 0.0;
 
         com_marker_.header.stamp = com_links_marker_.header.stamp = ros::Time::now();
         com_links_pub_.publish(com_links_marker_);
@@ -143,6 +122,11 @@ int CenterOfMass::TaskSpaceDim()
     return dim_;
 }
 
+KinematicRequestFlags CenterOfMass::GetKinematicRequestFlags() const
+{
+    return frames_.size() > 0 ? KIN_FK : KIN_COM;
+}
+
 void CenterOfMass::Initialize()
 {
     enable_z_ = parameters_.EnableZ;
@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <eigen_conversions/eigen_kdl.h>
+
+#include <exotica_core/server.h>
+#include <exotica_core_task_maps/eff_axis_alignment_autodiff.h>
+
+REGISTER_TASKMAP_TYPE("EffAxisAlignmentAutoDiff", exotica::EffAxisAlignmentAutoDiff);
+
+namespace exotica
+{
+void EffAxisAlignmentAutoDiff::Initialize()
+{
+    N = scene_->GetKinematicTree().GetNumControlledJoints();
+
+    n_frames_ = parameters_.EndEffector.size();
+    if (debug_) HIGHLIGHT_NAMED("EffAxisAlignmentAutoDiff", "Number of EndEffectors: " << n_frames_);
+    axis_.resize(3, n_frames_);
+    dir_.resize(3, n_frames_);
+
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        FrameWithAxisAndDirectionInitializer frame(parameters_.EndEffector[i]);
+        axis_.col(i) = frame.Axis.normalized();
+        dir_.col(i) = frame.Direction.normalized();
+    }
+
+    if (debug_)
+    {
+        for (int i = 0; i < n_frames_; ++i)
+        {
+            HIGHLIGHT_NAMED("EffAxisAlignmentAutoDiff",
+                            "Frame " << frames_[i].frame_A_link_name << ":"
+                                     << "\tAxis=" << axis_.col(i).transpose()
+                                     << "\tDirection=" << dir_.col(i).transpose());
+        }
+    }
+
+    if (Server::IsRos())
+    {
+        pub_debug_ = Server::Advertise<visualization_msgs::MarkerArray>(object_name_ + "/debug", 1, true);
+        msg_debug_.markers.reserve(n_frames_ * 2);
+        for (int i = 0; i < n_frames_; ++i)
+        {
+            visualization_msgs::Marker marker;
+            marker.action = visualization_msgs::Marker::ADD;
+            marker.type = visualization_msgs::Marker::ARROW;
+            marker.frame_locked = true;
+            marker.header.frame_id = "exotica/" + scene_->GetKinematicTree().GetRootFrameName();
+            marker.scale.x = 0.025;  // Shaft diameter
+            marker.scale.y = 0.05;   // Head diameter
+            marker.scale.z = 0.05;   // Head length
+            marker.ns = frames_[i].frame_A_link_name;
+            marker.pose.orientation.w = 1.0;
+            marker.points.resize(2);
+
+            // Current: red
+            {
+                marker.color = GetColor(1., 0., 0., 0.5);
+                marker.id = i;
+                msg_debug_.markers.emplace_back(marker);
+            }
+
+            // Target: green
+            {
+                marker.color = GetColor(0., 1., 0., 0.5);
+                marker.id = i + n_frames_;
+                msg_debug_.markers.emplace_back(marker);
+            }
+        }
+
+        // Clear pre-existing markers
+        visualization_msgs::MarkerArray msg;
+        msg.markers.resize(1);
+        msg.markers[0].action = 3;  // DELETE_ALL
+        pub_debug_.publish(msg);
+    }
+}
+
+void EffAxisAlignmentAutoDiff::AssignScene(ScenePtr scene)
+{
+    scene_ = scene;
+    Initialize();
+}
+
+void EffAxisAlignmentAutoDiff::Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian)
+{
+    AutoDiffTaskMap::Update(q, phi, jacobian);
+    if (Server::IsRos() && debug_) PublishDebug();
+}
+
+void EffAxisAlignmentAutoDiff::PublishDebug()
+{
+    constexpr double arrow_length = 0.25;
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        const Eigen::Vector3d link_position_in_base = Eigen::Map<const Eigen::Vector3d>(kinematics[0].Phi(i).p.data);
+        Eigen::Vector3d axis_in_base;
+        tf::vectorKDLToEigen(kinematics[0].Phi(i).M * KDL::Vector(axis_(0, i), axis_(1, i), axis_(2, i)), axis_in_base);
+
+        // Current - red
+        msg_debug_.markers[i].points[0].x = link_position_in_base.x();
+        msg_debug_.markers[i].points[0].y = link_position_in_base.y();
+        msg_debug_.markers[i].points[0].z = link_position_in_base.z();
+        msg_debug_.markers[i].points[1].x = link_position_in_base.x() + arrow_length * axis_in_base.x();
+        msg_debug_.markers[i].points[1].y = link_position_in_base.y() + arrow_length * axis_in_base.y();
+        msg_debug_.markers[i].points[1].z = link_position_in_base.z() + arrow_length * axis_in_base.z();
+
+        // Target - green
+        msg_debug_.markers[i + n_frames_].points[0].x = link_position_in_base.x();
+        msg_debug_.markers[i + n_frames_].points[0].y = link_position_in_base.y();
+        msg_debug_.markers[i + n_frames_].points[0].z = link_position_in_base.z();
+        msg_debug_.markers[i + n_frames_].points[1].x = link_position_in_base.x() + arrow_length * dir_.col(i).x();
+        msg_debug_.markers[i + n_frames_].points[1].y = link_position_in_base.y() + arrow_length * dir_.col(i).y();
+        msg_debug_.markers[i + n_frames_].points[1].z = link_position_in_base.z() + arrow_length * dir_.col(i).z();
+    }
+    pub_debug_.publish(msg_debug_);
+}
+
+Eigen::Vector3d EffAxisAlignmentAutoDiff::GetDirection(const std::string& frame_name) const
+{
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        if (frames_[i].frame_A_link_name == frame_name)
+        {
+            return dir_.col(i);
+        }
+    }
+    ThrowPretty("Direction for frame with name " << frame_name << " could not be found.");
+}
+
+void EffAxisAlignmentAutoDiff::SetDirection(const std::string& frame_name, const Eigen::Vector3d& dir_in)
+{
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        if (frames_[i].frame_A_link_name == frame_name)
+        {
+            dir_.col(i) = dir_in.normalized();
+            return;
+        }
+    }
+    ThrowPretty("Could not find frame with name " << frame_name << ".");
+}
+
+Eigen::Vector3d EffAxisAlignmentAutoDiff::GetAxis(const std::string& frame_name) const
+{
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        if (frames_[i].frame_A_link_name == frame_name)
+        {
+            return axis_.col(i);
+        }
+    }
+    ThrowPretty("Axis for frame with name " << frame_name << " could not be found.");
+}
+
+void EffAxisAlignmentAutoDiff::SetAxis(const std::string& frame_name, const Eigen::Vector3d& axis_in)
+{
+    for (int i = 0; i < n_frames_; ++i)
+    {
+        if (frames_[i].frame_A_link_name == frame_name)
+        {
+            axis_.col(i) = axis_in.normalized();
+            return;
+        }
+    }
+    ThrowPretty("Could not find frame with name " << frame_name << ".");
+}
+}  // namespace exotica
@@ -27,6 +27,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <array>
+
 #include <exotica_core/server.h>
 #include <exotica_core_task_maps/interaction_mesh.h>
 
@@ -43,7 +45,7 @@ void InteractionMesh::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi)
 
     if (phi.rows() != M * 3) ThrowNamed("Wrong size of Phi!");
 
-    Eigen::VectorXd eff_Phi;
+    Eigen::VectorXd eff_Phi(M * 3);
     for (int i = 0; i < M; ++i)
     {
         eff_Phi(i * 3) = kinematics[0].Phi(i).p[0];
@@ -63,61 +65,82 @@ void InteractionMesh::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi,
     if (phi.rows() != M * 3) ThrowNamed("Wrong size of Phi!");
     if (jacobian.rows() != M * 3 || jacobian.cols() != N) ThrowNamed("Wrong size of jacobian! " << N);
 
-    Eigen::MatrixXd dist;
-    Eigen::VectorXd wsum;
+    // Positions and position Jacobians of the end-effectors. The Jacobian rows are stored coordinate-major
+    // (row c * M + j holds coordinate c of end-effector j) so that pairwise terms act on all joints as matrix products.
     Eigen::VectorXd eff_Phi(M * 3);
-    for (int i = 0; i < M; ++i)
+    Eigen::MatrixXd eff_jacobian(M * 3, N);
+    for (int j = 0; j < M; ++j)
     {
-        eff_Phi(i * 3) = kinematics[0].Phi(i).p[0];
-        eff_Phi(i * 3 + 1) = kinematics[0].Phi(i).p[1];
-        eff_Phi(i * 3 + 2) = kinematics[0].Phi(i).p[2];
+        for (int c = 0; c < 3; ++c)
+        {
+            eff_Phi(j * 3 + c) = kinematics[0].Phi(j).p[c];
+            eff_jacobian.row(c * M + j) = kinematics[0].jacobian[j].data.row(c);
+        }
     }
+    Eigen::MatrixXd dist;
+    Eigen::VectorXd wsum;
     phi = ComputeLaplace(eff_Phi, weights_, &dist, &wsum);
+    const Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>> positions(eff_Phi.data(), M, 3);
 
-    double A, _A, Sk, Sl, w, _w;
-    int i, j, k, l;
-    Eigen::Vector3d distance, _distance = Eigen::Vector3d::Zero(3, 1);
-    for (i = 0; i < N; ++i)
+    // Pairwise terms (M x M), independent of the joints:
+    //   w(j, l) = weights(j, l) / (dist(j, l) * wsum(j))   weights of the Laplace coordinates
+    //   c(j, l) = -weights(j, l) / (dist(j, l) * wsum(j))^2
+    //   e(j, l) = weights(j, l) / dist(j, l)^2
+    //   u[a](j, l)                                          coordinate a of the unit vector from l to j
+    //   wpos(j) = sum_l weights(j, l) / dist(j, l)         over positive weights
+    Eigen::MatrixXd w = Eigen::MatrixXd::Zero(M, M);
+    Eigen::MatrixXd c = Eigen::MatrixXd::Zero(M, M);
+    Eigen::MatrixXd e = Eigen::MatrixXd::Zero(M, M);
+    std::array<Eigen::MatrixXd, 3> u;
+    for (int a = 0; a < 3; ++a) u[a] = Eigen::MatrixXd::Zero(M, M);
+    Eigen::VectorXd wpos = Eigen::VectorXd::Zero(M);
+    for (int j = 0; j < M; ++j)
     {
-        for (j = 0; j < M; ++j)
+        for (int l = 0; l < M; ++l)
         {
-            if (j < M)
-                jacobian.block(3 * j, i, 3, 1) = kinematics[0].jacobian[j].data.block(0, i, 3, 1);
-            for (l = 0; l < M; ++l)
+            if (j == l || dist(j, l) <= 0) continue;
+            for (int a = 0; a < 3; ++a) u[a](j, l) = (positions(j, a) - positions(l, a)) / dist(j, l);
+            if (weights_(j, l) <= 0) continue;
+            e(j, l) = weights_(j, l) / (dist(j, l) * dist(j, l));
+            wpos(j) += weights_(j, l) / dist(j, l);
+            if (wsum(j) > 0)
             {
-                if (j != l)
-                {
-                    if (dist(j, l) > 0 && wsum(j) > 0 && weights_(j, l) > 0)
-                    {
-                        A = dist(j, l) * wsum(j);
-                        w = weights_(j, l) / A;
+                const double A = dist(j, l) * wsum(j);
+                w(j, l) = weights_(j, l) / A;
+                c(j, l) = -weights_(j, l) / (A * A);
+            }
+        }
+    }
 
-                        _A = 0;
-                        distance = eff_Phi.segment(j * 3, 3) - eff_Phi.segment(l * 3, 3);
-                        _distance = kinematics[0].jacobian[j].data.block(0, i, 3, 1) - kinematics[0].jacobian[l].data.block(0, i, 3, 1);
+    // The derivative of dist(j, l) w.r.t. a joint is S(j, l) = u(j, l) . (J_j - J_l).
+    // g(j, :) = sum_k e(j, k) * S(j, k) for all joints at once.
+    Eigen::MatrixXd g = Eigen::MatrixXd::Zero(M, N);
+    for (int b = 0; b < 3; ++b)
+    {
+        const Eigen::MatrixXd f = e.cwiseProduct(u[b]);
+        g += f.rowwise().sum().asDiagonal() * eff_jacobian.middleRows(b * M, M);
+        g.noalias() -= f * eff_jacobian.middleRows(b * M, M);
+    }
+    const Eigen::MatrixXd q = c.cwiseProduct(dist) * positions;
 
-                        Sl = distance.dot(_distance) / dist(j, l);
-                        for (k = 0; k < M; ++k)
-                        {
-                            if (j != k && dist(j, k) > 0 && weights_(j, k) > 0)
-                            {
-                                distance = eff_Phi.segment(j * 3, 3) - eff_Phi.segment(k * 3, 3);
-                                _distance = kinematics[0].jacobian[j].data.block(0, i, 3, 1) - kinematics[0].jacobian[k].data.block(0, i, 3, 1);
-                                Sk = distance.dot(_distance) / dist(j, k);
-                                _A += weights_(j, k) * (Sl * dist(j, k) - Sk * dist(j, l)) / (dist(j, k) * dist(j, k));
-                            }
-                        }
-                        _w = -weights_(j, l) * _A / (A * A);
-                    }
-                    else
-                    {
-                        _w = 0;
-                        w = 0;
-                    }
-                    jacobian.block(3 * j, i, 3, 1) -= eff_Phi.segment(l * 3, 3) * _w + kinematics[0].jacobian[l].data.block(0, i, 3, 1) * w;
-                }
-            }
+    // Jacobian of the Laplace coordinates, one coordinate at a time:
+    //   J_j - sum_l w(j, l) * J_l - sum_l c(j, l) * (wpos(j) * S(j, l) - dist(j, l) * g(j)) * p_l
+    Eigen::MatrixXd s(M, N);
+    Eigen::MatrixXd jacobian_a(M, N);
+    for (int a = 0; a < 3; ++a)
+    {
+        s.setZero();
+        for (int b = 0; b < 3; ++b)
+        {
+            const Eigen::MatrixXd cb = c.cwiseProduct(u[b]) * positions.col(a).asDiagonal();
+            s += cb.rowwise().sum().asDiagonal() * eff_jacobian.middleRows(b * M, M);
+            s.noalias() -= cb * eff_jacobian.middleRows(b * M, M);
         }
+        jacobian_a = eff_jacobian.middleRows(a * M, M);
+        jacobian_a.noalias() -= w * eff_jacobian.middleRows(a * M, M);
+        jacobian_a -= wpos.asDiagonal() * s;
+        jacobian_a += q.col(a).asDiagonal() * g;
+        for (int j = 0; j < M; ++j) jacobian.row(3 * j + a) = jacobian_a.row(j);
     }
 
     if (debug_) Debug(phi);
@@ -306,7 +329,7 @@ void InteractionMesh::ComputeGoalLaplace(const std::vector<KDL::Frame>& nodes, E
 void InteractionMesh::ComputeGoalLaplace(const Eigen::VectorXd& x, Eigen::VectorXd& goal)
 {
     scene_->Update(x);
-    Eigen::VectorXd eff_Phi;
+    Eigen::VectorXd eff_Phi(eff_size_ * 3);
     for (int i = 0; i < eff_size_; ++i)
     {
         eff_Phi(i * 3) = kinematics[0].Phi(i).p[0];
@@ -34,6 +34,128 @@ REGISTER_TASKMAP_TYPE("PointToLine", exotica::PointToLine);
 
 namespace exotica
 {
+void PointToLineVisualization::Initialize(const std::string &object_name, const std::string &link_name, const std::string &base_name)
+{
+    object_name_ = object_name;
+    link_name_ = link_name;
+    base_name_ = base_name;
+
+    pub_marker_ = Server::Advertise<visualization_msgs::MarkerArray>("p2l", 1, true);
+    pub_marker_label_ = Server::Advertise<visualization_msgs::MarkerArray>("p2l_label", 1, true);
+    // delete previous markers
+    visualization_msgs::Marker md;
+    md.action = 3;  // DELETEALL
+    visualization_msgs::MarkerArray ma;
+    ma.markers.push_back(md);
+    pub_marker_.publish(ma);
+    pub_marker_label_.publish(ma);
+}
+
+void PointToLineVisualization::Publish(const Eigen::Vector3d &line_start, const Eigen::Vector3d &point, const Eigen::Vector3d &dv)
+{
+    const ros::Time t = ros::Time::now();
+    const std::string common_frame = "exotica/" + base_name_;
+    visualization_msgs::MarkerArray ma;
+    {
+        // line in base frame
+        visualization_msgs::Marker mc;
+        mc.header.stamp = t;
+        mc.frame_locked = true;
+        mc.header.frame_id = common_frame;
+        mc.ns = "cam/line/" + object_name_;
+        mc.type = visualization_msgs::Marker::ARROW;
+        mc.scale.x = 0.01;
+        mc.scale.y = 0.01;
+        mc.scale.z = 0.01;
+        // line start
+        geometry_msgs::Point pp;
+        pp.x = line_start.x();
+        pp.y = line_start.y();
+        pp.z = line_start.z();
+        mc.points.push_back(pp);
+        // line end
+        const Eigen::Vector3d pe = point + dv;
+        pp.x = pe.x();
+        pp.y = pe.y();
+        pp.z = pe.z();
+        mc.points.push_back(pp);
+        mc.color.r = 1;
+        mc.color.g = 1;
+        mc.color.b = 0;
+        mc.color.a = 1;
+        ma.markers.push_back(mc);
+    }
+    {
+        // point in link frame
+        visualization_msgs::Marker ml;
+        ml.header.stamp = t;
+        ml.frame_locked = true;
+        ml.header.frame_id = common_frame;
+        ml.ns = "lnk/point/" + object_name_;
+        ml.type = visualization_msgs::Marker::SPHERE;
+        ml.scale.x = 0.03;
+        ml.scale.y = 0.03;
+        ml.scale.z = 0.03;
+        ml.color.r = 1;
+        ml.color.g = 0;
+        ml.color.b = 0;
+        ml.color.a = 1;
+        ml.pose.position.x = point.x();
+        ml.pose.position.y = point.y();
+        ml.pose.position.z = point.z();
+        ma.markers.push_back(ml);
+    }
+    {
+        // draw 'dv' starting at 'p' in base frame
+        visualization_msgs::Marker mdv;
+        mdv.header.stamp = t;
+        mdv.frame_locked = true;
+        mdv.header.frame_id = common_frame;
+        mdv.ns = "dv/" + object_name_;
+        mdv.type = visualization_msgs::Marker::ARROW;
+        mdv.scale.x = 0.001;
+        mdv.scale.y = 0.01;
+        mdv.scale.z = 0.01;
+        mdv.pose.position.x = point.x();
+        mdv.pose.position.y = point.y();
+        mdv.pose.position.z = point.z();
+        mdv.points.push_back(geometry_msgs::Point());
+        geometry_msgs::Point pdv;
+        pdv.x = dv.x();
+        pdv.y = dv.y();
+        pdv.z = dv.z();
+        mdv.points.push_back(pdv);
+        mdv.color.r = 0;
+        mdv.color.g = 1;
+        mdv.color.b = 0;
+        mdv.color.a = 0.5;
+        ma.markers.push_back(mdv);
+    }
+    pub_marker_.publish(ma);
+    {
+        ma.markers.clear();
+        visualization_msgs::Marker mt;
+        mt.header.stamp = t;
+        mt.frame_locked = true;
+        mt.header.frame_id = common_frame;
+        mt.ns = "lnk/label/" + object_name_;
+        mt.type = visualization_msgs::Marker::TEXT_VIEW_FACING;
+        mt.text = link_name_;
+        mt.pose.position.x = point.x();
+        mt.pose.position.y = point.y();
+        mt.pose.position.z = point.z();
+        mt.scale.x = 0.05;
+        mt.scale.y = 0.05;
+        mt.scale.z = 0.05;
+        mt.color.r = 1;
+        mt.color.g = 1;
+        mt.color.b = 1;
+        mt.color.a = 1;
+        ma.markers.push_back(mt);
+        pub_marker_label_.publish(ma);
+    }
+}
+
 PointToLine::PointToLine() = default;
 PointToLine::~PointToLine() = default;
 
@@ -87,7 +209,7 @@ void PointToLine::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi)
     for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
     {
         const Eigen::Vector3d p = line_start_ + Eigen::Map<const Eigen::Vector3d>(kinematics[0].Phi(i).p.data);
-        phi.segment<3>(i * 3) = -Direction(p);
+        phi.segment<3>(i * 3) = Direction(p);
     }
 }
 
@@ -117,111 +239,7 @@ void PointToLine::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eige
             }
         }
 
-        // visualisation of point, line and their distance
-        if (visualize_ && Server::IsRos())
-        {
-            const ros::Time t = ros::Time::now();
-            const std::string common_frame = "exotica/" + base_name_;
-            visualization_msgs::MarkerArray ma;
-            {
-                // line in base frame
-                visualization_msgs::Marker mc;
-                mc.header.stamp = t;
-                mc.frame_locked = true;
-                mc.header.frame_id = common_frame;
-                mc.ns = "cam/line/" + object_name_;
-                mc.type = visualization_msgs::Marker::ARROW;
-                mc.scale.x = 0.01;
-                mc.scale.y = 0.01;
-                mc.scale.z = 0.01;
-                // line start
-                geometry_msgs::Point pp;
-                pp.x = line_start_.x();
-                pp.y = line_start_.y();
-                pp.z = line_start_.z();
-                mc.points.push_back(pp);
-                // line end
-                const Eigen::Vector3d pe = p + dv;
-                pp.x = pe.x();
-                pp.y = pe.y();
-                pp.z = pe.z();
-                mc.points.push_back(pp);
-                mc.color.r = 1;
-                mc.color.g = 1;
-                mc.color.b = 0;
-                mc.color.a = 1;
-                ma.markers.push_back(mc);
-            }
-            {
-                // point in link frame
-                visualization_msgs::Marker ml;
-                ml.header.stamp = t;
-                ml.frame_locked = true;
-                ml.header.frame_id = common_frame;
-                ml.ns = "lnk/point/" + object_name_;
-                ml.type = visualization_msgs::Marker::SPHERE;
-                ml.scale.x = 0.03;
-                ml.scale.y = 0.03;
-                ml.scale.z = 0.03;
-                ml.color.r = 1;
-                ml.color.g = 0;
-                ml.color.b = 0;
-                ml.color.a = 1;
-                ml.pose.position.x = p.x();
-                ml.pose.position.y = p.y();
-                ml.pose.position.z = p.z();
-                ma.markers.push_back(ml);
-            }
-            {
-                // draw 'dv' starting at 'p' in base frame
-                visualization_msgs::Marker mdv;
-                mdv.header.stamp = t;
-                mdv.frame_locked = true;
-                mdv.header.frame_id = common_frame;
-                mdv.ns = "dv/" + object_name_;
-                mdv.type = visualization_msgs::Marker::ARROW;
-                mdv.scale.x = 0.001;
-                mdv.scale.y = 0.01;
-                mdv.scale.z = 0.01;
-                mdv.pose.position.x = p.x();
-                mdv.pose.position.y = p.y();
-                mdv.pose.position.z = p.z();
-                mdv.points.push_back(geometry_msgs::Point());
-                geometry_msgs::Point pdv;
-                pdv.x = dv.x();
-                pdv.y = dv.y();
-                pdv.z = dv.z();
-                mdv.points.push_back(pdv);
-                mdv.color.r = 0;
-                mdv.color.g = 1;
-                mdv.color.b = 0;
-                mdv.color.a = 0.5;
-                ma.markers.push_back(mdv);
-            }
-            pub_marker_.publish(ma);
-            {
-                ma.markers.clear();
-                visualization_msgs::Marker mt;
-                mt.header.stamp = t;
-                mt.frame_locked = true;
-                mt.header.frame_id = common_frame;
-                mt.ns = "lnk/label/" + object_name_;
-                mt.type = visualization_msgs::Marker::TEXT_VIEW_FACING;
-                mt.text = link_name_;
-                mt.pose.position.x = p.x();
-                mt.pose.position.y = p.y();
-                mt.pose.position.z = p.z();
-                mt.scale.x = 0.05;
-                mt.scale.y = 0.05;
-                mt.scale.z = 0.05;
-                mt.color.r = 1;
-                mt.color.g = 1;
-                mt.color.b = 1;
-                mt.color.a = 1;
-                ma.markers.push_back(mt);
-                pub_marker_label_.publish(ma);
-            }
-        }
+        if (visualize_ && Server::IsRos()) visualization_.Publish(line_start_, p, dv);
     }
 }
 
@@ -238,18 +256,7 @@ void PointToLine::Instantiate(const PointToLineInitializer &init)
 
     visualize_ = init.Visualise;
 
-    if (visualize_ && Server::IsRos())
-    {
-        pub_marker_ = Server::Advertise<visualization_msgs::MarkerArray>("p2l", 1, true);
-        pub_marker_label_ = Server::Advertise<visualization_msgs::MarkerArray>("p2l_label", 1, true);
-        // delete previous markers
-        visualization_msgs::Marker md;
-        md.action = 3;  // DELETEALL
-        visualization_msgs::MarkerArray ma;
-        ma.markers.push_back(md);
-        pub_marker_.publish(ma);
-        pub_marker_label_.publish(ma);
-    }
+    if (visualize_ && Server::IsRos()) visualization_.Initialize(object_name_, link_name_, base_name_);
 }
 
 int PointToLine::TaskSpaceDim()
@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <exotica_core/server.h>
+#include <exotica_core_task_maps/point_to_line_autodiff.h>
+
+REGISTER_TASKMAP_TYPE("PointToLineAutoDiff", exotica::PointToLineAutoDiff);
+
+namespace exotica
+{
+PointToLineAutoDiff::PointToLineAutoDiff() = default;
+PointToLineAutoDiff::~PointToLineAutoDiff() = default;
+
+Eigen::Vector3d PointToLineAutoDiff::GetEndPoint()
+{
+    return line_end_;
+}
+
+void PointToLineAutoDiff::SetEndPoint(const Eigen::Vector3d &point)
+{
+    line_end_ = point;
+    line_ = line_end_ - line_start_;
+}
+
+void PointToLineAutoDiff::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian)
+{
+    AutoDiffTaskMap::Update(x, phi, jacobian);
+    if (visualize_ && Server::IsRos())
+    {
+        for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
+        {
+            visualization_.Publish(line_start_, line_start_ + Eigen::Map<const Eigen::Vector3d>(kinematics[0].Phi(i).p.data), phi.segment<3>(i * 3));
+        }
+    }
+}
+
+void PointToLineAutoDiff::Instantiate(const PointToLineAutoDiffInitializer &init)
+{
+    link_name_ = frames_[0].frame_A_link_name;
+    base_name_ = frames_[0].frame_B_link_name;
+
+    line_start_ = Eigen::Map<Eigen::Vector3d>(frames_[0].frame_B_offset.p.data);
+    line_end_ = init.EndPoint;
+
+    line_ = line_end_ - line_start_;
+    infinite_ = init.Infinite;
+
+    visualize_ = init.Visualise;
+
+    if (visualize_ && Server::IsRos()) visualization_.Initialize(object_name_, link_name_, base_name_);
+}
+}  // namespace exotica
@@ -151,28 +151,8 @@ void QuasiStatic::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi)
 {
     if (phi.rows() != 1) ThrowNamed("Wrong size of phi!");
     phi(0) = 0.0;
-    KDL::Vector kdl_com;
-    double M = 0.0;
-    for (std::weak_ptr<KinematicElement> welement : scene_->GetKinematicTree().GetTree())
-    {
-        std::shared_ptr<KinematicElement> element = welement.lock();
-        if (element->is_robot_link || element->closest_robot_link.lock())  // Only for robot links and attached objects
-        {
-            double mass = element->segment.getInertia().getMass();
-            if (mass > 0)
-            {
-                KDL::Frame cog = KDL::Frame(element->segment.getInertia().getCOG());
-                KDL::Frame com_local = scene_->GetKinematicTree().FK(element, cog, nullptr, KDL::Frame());
-                kdl_com += com_local.p * mass;
-                M += mass;
-            }
-        }
-    }
-    if (M == 0.0) return;
-    kdl_com = kdl_com / M;
-    Eigen::VectorXd com(2);
-    com(0) = kdl_com[0];
-    com(1) = kdl_com[1];
+    if (scene_->GetKinematicTree().GetTotalMass() == 0.0) return;
+    Eigen::VectorXd com = scene_->GetKinematicTree().GetCenterOfMass().head<2>();
 
     Eigen::MatrixXd supports(kinematics[0].Phi.rows(), 2);
     for (int i = 0; i < kinematics[0].Phi.rows(); ++i)
@@ -239,32 +219,9 @@ void QuasiStatic::Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRef phi, Eige
     if (jacobian.rows() != 1 || jacobian.cols() != x.rows()) ThrowNamed("Wrong size of jacobian! " << x.rows());
     phi(0) = 0.0;
     jacobian.setZero();
-    Eigen::MatrixXd jacobian_com = Eigen::MatrixXd::Zero(2, jacobian.cols());
-    KDL::Vector kdl_com;
-    double M = 0.0;
-    for (std::weak_ptr<KinematicElement> welement : scene_->GetKinematicTree().GetTree())
-    {
-        std::shared_ptr<KinematicElement> element = welement.lock();
-        if (element->is_robot_link || element->closest_robot_link.lock())  // Only for robot links and attached objects
-        {
-            double mass = element->segment.getInertia().getMass();
-            if (mass > 0)
-            {
-                KDL::Frame cog = KDL::Frame(element->segment.getInertia().getCOG());
-                KDL::Frame com_local = scene_->GetKinematicTree().FK(element, cog, nullptr, KDL::Frame());
-                Eigen::MatrixXd jacobian_com_local = scene_->GetKinematicTree().Jacobian(element, cog, nullptr, KDL::Frame());
-                kdl_com += com_local.p * mass;
-                jacobian_com += jacobian_com_local.topRows(2) * mass;
-                M += mass;
-            }
-        }
-    }
-    if (M == 0.0) return;
-    kdl_com = kdl_com / M;
-    Eigen::VectorXd com(2);
-    com(0) = kdl_com[0];
-    com(1) = kdl_com[1];
-    jacobian_com = jacobian_com / M;
+    if (scene_->GetKinematicTree().GetTotalMass() == 0.0) return;
+    Eigen::VectorXd com = scene_->GetKinematicTree().GetCenterOfMass().head<2>();
+    Eigen::MatrixXd jacobian_com = scene_->GetKinematicTree().GetCenterOfMassJacobian().topRows<2>();
 
     Eigen::MatrixXd supports(kinematics[0].Phi.rows(), 2);
     Eigen::MatrixXd supportsJ(kinematics[0].Phi.rows() * 2, x.rows());
@@ -338,6 +295,11 @@ int QuasiStatic::TaskSpaceDim()
     return 1;
 }
 
+KinematicRequestFlags QuasiStatic::GetKinematicRequestFlags() const
+{
+    return KIN_COM;
+}
+
 void QuasiStatic::Initialize()
 {
     {
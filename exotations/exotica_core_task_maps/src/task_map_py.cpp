@@ -37,6 +37,7 @@
 #include <exotica_core_task_maps/control_regularization.h>
 #include <exotica_core_task_maps/distance.h>
 #include <exotica_core_task_maps/eff_axis_alignment.h>
+#include <exotica_core_task_maps/eff_axis_alignment_autodiff.h>
 #include <exotica_core_task_maps/eff_box.h>
 #include <exotica_core_task_maps/eff_frame.h>
 #include <exotica_core_task_maps/eff_orientation.h>
@@ -50,6 +51,7 @@
 #include <exotica_core_task_maps/joint_velocity_backward_difference.h>
 #include <exotica_core_task_maps/joint_velocity_limit_constraint.h>
 #include <exotica_core_task_maps/point_to_line.h>
+#include <exotica_core_task_maps/point_to_line_autodiff.h>
 #include <exotica_core_task_maps/sphere_collision.h>
 
 using namespace exotica;
@@ -79,6 +81,12 @@ PYBIND11_MODULE(exotica_core_task_maps_py, module)
         .def("get_direction", &EffAxisAlignment::GetDirection)
         .def("set_direction", &EffAxisAlignment::SetDirection);
 
+    py::class_<EffAxisAlignmentAutoDiff, std::shared_ptr<EffAxisAlignmentAutoDiff>, TaskMap>(module, "EffAxisAlignmentAutoDiff")
+        .def("get_axis", &EffAxisAlignmentAutoDiff::GetAxis)
+        .def("set_axis", &EffAxisAlignmentAutoDiff::SetAxis)
+        .def("get_direction", &EffAxisAlignmentAutoDiff::GetDirection)
+        .def("set_direction", &EffAxisAlignmentAutoDiff::SetDirection);
+
     py::class_<EffBox, std::shared_ptr<EffBox>, TaskMap>(module, "EffBox")
         .def("get_lower_limit", &EffBox::GetLowerLimit)
         .def("get_upper_limit", &EffBox::GetUpperLimit);
@@ -86,6 +94,9 @@ PYBIND11_MODULE(exotica_core_task_maps_py, module)
     py::class_<PointToLine, std::shared_ptr<PointToLine>, TaskMap>(module, "PointToLine")
         .def_property("end_point", &PointToLine::GetEndPoint, &PointToLine::SetEndPoint);
 
+    py::class_<PointToLineAutoDiff, std::shared_ptr<PointToLineAutoDiff>, TaskMap>(module, "PointToLineAutoDiff")
+        .def_property("end_point", &PointToLineAutoDiff::GetEndPoint, &PointToLineAutoDiff::SetEndPoint);
+
     py::class_<JointVelocityLimitConstraint, std::shared_ptr<JointVelocityLimitConstraint>, TaskMap>(module, "JointVelocityLimitConstraint")
         .def("set_previous_joint_state", &JointVelocityLimitConstraint::SetPreviousJointState);
 
@@ -200,6 +200,38 @@ bool test_hessian(UnconstrainedEndPoseProblemPtr problem, const double eps = 1e-
     return true;
 }
 
+// Reports the error of the TaskMap finite difference engine against the analytic Jacobian of each map
+bool test_finite_difference_jacobian(UnconstrainedEndPoseProblemPtr problem, const double eps = 1e-5)
+{
+    for (TaskMapPtr map : problem->GetTasks())
+    {
+        // Finite differences of phi are not defined for maps with Lie group outputs
+        if (map->TaskSpaceDim() != map->TaskSpaceJacobianDim()) continue;
+
+        for (const FiniteDifferenceMethod method : {FiniteDifferenceMethod::Forward, FiniteDifferenceMethod::Backward, FiniteDifferenceMethod::Central})
+        {
+            map->SetFiniteDifferenceMethod(method);
+            double max_error = 0.0;
+            for (int j = 0; j < num_trials_; ++j)
+            {
+                Eigen::VectorXd x0 = problem->GetScene()->GetKinematicTree().GetRandomControlledState();
+                problem->Update(x0);
+                Eigen::VectorXd phi(map->TaskSpaceDim()), phi_fd(map->TaskSpaceDim());
+                Eigen::MatrixXd jacobian(map->TaskSpaceDim(), problem->N), jacobian_fd(map->TaskSpaceDim(), problem->N);
+                map->Update(x0, phi, jacobian);
+                map->FiniteDifferenceJacobian(x0, phi_fd, jacobian_fd);
+                max_error = std::max(max_error, (jacobian - jacobian_fd).lpNorm<Eigen::Infinity>());
+            }
+            TEST_COUT << "Finite difference Jacobian error (method " << static_cast<int>(method) << ", h=" << map->GetFiniteDifferenceStep() << "): " << max_error;
+            // First order schemes are only accurate to O(h)
+            const double tolerance = method == FiniteDifferenceMethod::Central ? eps : std::max(eps, 1e3 * map->GetFiniteDifferenceStep());
+            if (max_error > tolerance) ADD_FAILURE() << "Finite difference Jacobian error out of bounds: " << max_error;
+        }
+        map->SetFiniteDifferenceMethod(FiniteDifferenceMethod::Backward);
+    }
+    return true;
+}
+
 template <class T>
 bool test_jacobian_time_indexed(std::shared_ptr<T> problem, TimeIndexedTask& task, int t, const double eps = 1e-5)
 {
@@ -316,6 +348,7 @@ TEST(ExoticaTaskMaps, testEffPositionXY)
         UnconstrainedEndPoseProblemPtr problem = setup_problem(map);
         EXPECT_TRUE(test_random(problem));
         EXPECT_TRUE(test_jacobian(problem));
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
         EXPECT_TRUE(test_hessian(problem));
     }
     catch (const std::exception& e)
@@ -347,6 +380,8 @@ TEST(ExoticaTaskMaps, testEffPosition)
         EXPECT_TRUE(test_values(X, Y, jacobian, problem));
 
         EXPECT_TRUE(test_jacobian(problem));
+
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
         EXPECT_TRUE(test_hessian(problem));
     }
     catch (const std::exception& e)
@@ -395,6 +430,8 @@ TEST(ExoticaTaskMaps, testEffAxisAlignment)
         EXPECT_TRUE(test_random(problem));
 
         EXPECT_TRUE(test_jacobian(problem));
+
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
     }
     catch (const std::exception& e)
     {
@@ -824,6 +861,7 @@ TEST(ExoticaTaskMaps, testCoM)
             EXPECT_TRUE(test_values(X, Y, jacobian, problem));
         }
         EXPECT_TRUE(test_jacobian(problem));
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
 
         TEST_COUT << "CoM test with a subset of links";
         map = Initializer("exotica/CenterOfMass", {{"Name", std::string("MyTask")},
@@ -861,6 +899,7 @@ TEST(ExoticaTaskMaps, testCoM)
             EXPECT_TRUE(test_values(X, Y, jacobian, problem));
         }
         EXPECT_TRUE(test_jacobian(problem));
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
 
         TEST_COUT << "CoM test with projection on XY plane";
         map = Initializer("exotica/CenterOfMass", {{"Name", std::string("MyTask")},
@@ -891,6 +930,7 @@ TEST(ExoticaTaskMaps, testCoM)
             EXPECT_TRUE(test_values(X, Y, jacobian, problem));
         }
         EXPECT_TRUE(test_jacobian(problem));
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
 
         TEST_COUT << "CoM test with attached object";
         map = Initializer("exotica/CenterOfMass", {{"Name", std::string("MyTask")},
@@ -928,6 +968,7 @@ TEST(ExoticaTaskMaps, testCoM)
             EXPECT_TRUE(test_values(X, Y, jacobian, problem));
         }
         EXPECT_TRUE(test_jacobian(problem));
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
     }
     catch (const std::exception& e)
     {
@@ -1053,6 +1094,93 @@ TEST(ExoticaTaskMaps, testPoint2Line)
         // TODO: Add test_values
 
         EXPECT_TRUE(test_jacobian(problem));
+
+        EXPECT_TRUE(test_finite_difference_jacobian(problem));
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Uncaught exception! " << e.what();
+    }
+}
+
+// Evaluates the hand-written map and its automatic differentiation counterpart on the same states, compares
+// phi and the Jacobian of both and reports the time spent in the Update of each map.
+void compare_with_autodiff(Initializer& hand_written_map, Initializer& autodiff_map)
+{
+    UnconstrainedEndPoseProblemPtr hand_written_problem = setup_problem(hand_written_map);
+    UnconstrainedEndPoseProblemPtr autodiff_problem = setup_problem(autodiff_map);
+    TaskMapPtr hand_written = hand_written_problem->GetTaskMaps().at("MyTask");
+    TaskMapPtr autodiff = autodiff_problem->GetTaskMaps().at("MyTask");
+    ASSERT_EQ(hand_written->length, autodiff->length);
+
+    const int n = hand_written_problem->N;
+    Eigen::VectorXd phi_hand_written(hand_written->length), phi_autodiff(autodiff->length), phi(autodiff->length);
+    Eigen::MatrixXd jacobian_hand_written(hand_written->length, n), jacobian_autodiff(autodiff->length, n);
+    Timer timer;
+    double time_hand_written = 0.0, time_autodiff = 0.0;
+    for (int i = 0; i < num_trials_; ++i)
+    {
+        const Eigen::VectorXd x = hand_written_problem->GetScene()->GetKinematicTree().GetRandomControlledState();
+        hand_written_problem->Update(x);
+        autodiff_problem->Update(x);
+
+        timer.Reset();
+        hand_written->Update(x, phi_hand_written, jacobian_hand_written);
+        time_hand_written += timer.GetDuration();
+
+        timer.Reset();
+        autodiff->Update(x, phi_autodiff, jacobian_autodiff);
+        time_autodiff += timer.GetDuration();
+
+        EXPECT_LT((phi_autodiff - phi_hand_written).norm(), 1e-10);
+        EXPECT_LT((jacobian_autodiff - jacobian_hand_written).norm(), 1e-10);
+
+        // The phi-only updates have to agree with the values of the full updates
+        hand_written->Update(x, phi);
+        EXPECT_LT((phi - phi_hand_written).norm(), 1e-10);
+        autodiff->Update(x, phi);
+        EXPECT_LT((phi - phi_autodiff).norm(), 1e-10);
+    }
+    TEST_COUT << "Update with Jacobian - hand-written: " << 1e6 * time_hand_written / num_trials_ << " us, AutoDiff: " << 1e6 * time_autodiff / num_trials_ << " us";
+
+    EXPECT_TRUE(test_random(autodiff_problem));
+    EXPECT_TRUE(test_jacobian(autodiff_problem));
+    EXPECT_TRUE(test_hessian(autodiff_problem));
+}
+
+TEST(ExoticaTaskMaps, testAutoDiffAgainstHandWritten)
+{
+    try
+    {
+        {
+            TEST_COUT << "PointToLine vs. PointToLineAutoDiff";
+            const std::vector<Initializer> end_effector({Initializer("Frame", {{"Link", std::string("endeff")},
+                                                                               {"LinkOffset", std::string("0.5 0 0.5")},
+                                                                               {"Base", std::string("base")},
+                                                                               {"BaseOffset", std::string("0.5 0.5 0")}})});
+            Initializer hand_written_map("exotica/PointToLine", {{"Name", std::string("MyTask")}, {"EndPoint", std::string("1 0.5 1")}, {"EndEffector", end_effector}});
+            Initializer autodiff_map("exotica/PointToLineAutoDiff", {{"Name", std::string("MyTask")}, {"EndPoint", std::string("1 0.5 1")}, {"EndEffector", end_effector}});
+            compare_with_autodiff(hand_written_map, autodiff_map);
+        }
+        {
+            TEST_COUT << "PointToLine vs. PointToLineAutoDiff - finite segment";
+            // The segment is short, so points get projected beyond both of its ends and the distance is clipped
+            const std::vector<Initializer> end_effector({Initializer("Frame", {{"Link", std::string("endeff")},
+                                                                               {"LinkOffset", std::string("0.5 0 0.5")},
+                                                                               {"Base", std::string("base")},
+                                                                               {"BaseOffset", std::string("0.5 0.5 0")}})});
+            Initializer hand_written_map("exotica/PointToLine", {{"Name", std::string("MyTask")}, {"EndPoint", std::string("0.2 0.1 0.2")}, {"Infinite", false}, {"EndEffector", end_effector}});
+            Initializer autodiff_map("exotica/PointToLineAutoDiff", {{"Name", std::string("MyTask")}, {"EndPoint", std::string("0.2 0.1 0.2")}, {"Infinite", false}, {"EndEffector", end_effector}});
+            compare_with_autodiff(hand_written_map, autodiff_map);
+        }
+        {
+            TEST_COUT << "EffAxisAlignment vs. EffAxisAlignmentAutoDiff";
+            const std::vector<Initializer> end_effector({Initializer("Frame", {{"Link", std::string("endeff")}, {"Axis", std::string("1 0 0")}, {"Direction", std::string("0 0 1")}}),
+                                                         Initializer("Frame", {{"Link", std::string("endeff")}, {"Axis", std::string("0 1 1")}, {"Direction", std::string("1 0 0")}})});
+            Initializer hand_written_map("exotica/EffAxisAlignment", {{"Name", std::string("MyTask")}, {"EndEffector", end_effector}});
+            Initializer autodiff_map("exotica/EffAxisAlignmentAutoDiff", {{"Name", std::string("MyTask")}, {"EndEffector", end_effector}});
+            compare_with_autodiff(hand_written_map, autodiff_map);
+        }
     }
     catch (const std::exception& e)
     {
@@ -80,6 +80,9 @@ public:
     ///@param solution Returned solution trajectory as a vector of joint configurations.
     void Solve(Eigen::MatrixXd& solution) override;
 
+    /// \brief Returns the memory allocated for the solver state (both state buffers and workspaces) in bytes.
+    std::size_t GetMemoryUsage() const;
+
     ///\brief Binds the solver to a specific problem which must be pre-initalised
     ///@param pointer Shared pointer to the motion planning problem
     ///@return        Successful if the problem is a valid UnconstrainedTimeIndexedProblem
@@ -105,6 +108,7 @@ private:
     double function_tolerance_ = 1e-5;         //!< Relative function tolerance/first-order optimality criterion
     int max_backtrack_iterations_ = 10;        //!< Max. number of sweeps without improvement before terminating (= line-search)
     bool use_bwd_msg_ = false;                 //!< Flag for using backward message initialisation
+    bool use_information_form_ = true;         //!< Flag for computing messages in information form (otherwise covariance form)
     Eigen::VectorXd bwd_msg_v_;                //!< Backward message initialisation mean
     Eigen::MatrixXd bwd_msg_Vinv_;             //!< Backward message initialisation covariance
     bool sweep_improved_cost_;                 //!< Whether the last sweep improved the cost (for backtrack iterations count)
@@ -112,43 +116,80 @@ private:
 
     std::vector<SinglePassMeanCovariance> q_stat_;  //!< Cost weighted normal distribution of configurations across sweeps.
 
-    std::vector<Eigen::VectorXd> s;     //!< Forward message mean
-    std::vector<Eigen::MatrixXd> Sinv;  //!< Forward message covariance inverse
-    std::vector<Eigen::VectorXd> v;     //!< Backward message mean
-    std::vector<Eigen::MatrixXd> Vinv;  //!< Backward message covariance inverse
-    std::vector<Eigen::VectorXd> r;     //!< Task message mean
-    std::vector<Eigen::MatrixXd> R;     //!< Task message covariance
-    Eigen::VectorXd rhat;               //!< Task message point of linearisation
-    std::vector<Eigen::VectorXd> b;     //!< Belief mean
-    std::vector<Eigen::MatrixXd> Binv;  //!< Belief covariance inverse
-    std::vector<Eigen::VectorXd> q;     //!< Configuration space trajectory
-    std::vector<Eigen::VectorXd> qhat;  //!< Point of linearisation
-    Eigen::VectorXd cost_control_;      //!< Control cost for each time step
-    Eigen::VectorXd cost_task_;         //!< Task cost for each task for each time step
-
-    std::vector<Eigen::VectorXd> s_old;     //!< Forward message mean (last most optimal value)
-    std::vector<Eigen::MatrixXd> Sinv_old;  //!< Forward message covariance inverse (last most optimal value)
-    std::vector<Eigen::VectorXd> v_old;     //!< Backward message mean (last most optimal value)
-    std::vector<Eigen::MatrixXd> Vinv_old;  //!< Backward message covariance inverse (last most optimal value)
-    std::vector<Eigen::VectorXd> r_old;     //!< Task message mean (last most optimal value)
-    std::vector<Eigen::MatrixXd> R_old;     //!< Task message covariance (last most optimal value)
-    Eigen::VectorXd rhat_old;               //!< Task message point of linearisation (last most optimal value)
-    std::vector<Eigen::VectorXd> b_old;     //!< Belief mean (last most optimal value)
-    std::vector<Eigen::MatrixXd> Binv_old;  //!< Belief covariance inverse (last most optimal value)
-    std::vector<Eigen::VectorXd> q_old;     //!< Configuration space trajectory (last most optimal value)
-    std::vector<Eigen::VectorXd> qhat_old;  //!< Point of linearisation (last most optimal value)
-    Eigen::VectorXd cost_control_old_;      //!< Control cost for each time step (last most optimal value)
-    Eigen::MatrixXd cost_task_old_;         //!< Task cost for each task for each time step (last most optimal value)
-
-    std::vector<Eigen::VectorXd> damping_reference_;         //!< Damping reference point
+    /// \brief Messages, beliefs and costs of all time steps.
+    /// Each quantity is stored contiguously: vectors as the columns of an N x T matrix, matrices as consecutive N x N blocks of an N x NT matrix.
+    struct SweepState
+    {
+        Eigen::MatrixXd Sinv_s;        //!< Forward message mean in information form (S^{-1} s)
+        Eigen::MatrixXd Sinv;          //!< Forward message covariance inverse
+        Eigen::MatrixXd Vinv_v;        //!< Backward message mean in information form (V^{-1} v)
+        Eigen::MatrixXd Vinv;          //!< Backward message covariance inverse
+        Eigen::MatrixXd r;             //!< Task message mean
+        Eigen::MatrixXd R;             //!< Task message covariance
+        Eigen::VectorXd rhat;          //!< Task message point of linearisation
+        Eigen::MatrixXd b;             //!< Belief mean
+        Eigen::MatrixXd Binv;          //!< Belief covariance inverse
+        Eigen::MatrixXd q;             //!< Configuration space trajectory
+        Eigen::MatrixXd qhat;          //!< Point of linearisation
+        Eigen::VectorXd cost_control;  //!< Control cost for each time step
+        Eigen::VectorXd cost_task;     //!< Task cost for each time step
+
+        /// \brief Allocates and zeroes the storage for N degrees of freedom and T time steps.
+        void Resize(int N, int T);
+
+        /// \brief Returns the size of the allocated storage in bytes.
+        std::size_t GetMemoryUsage() const;
+    };
+
+    /// Per time step quantities, grouped by the update that overwrites them as a whole.
+    enum StateBlock
+    {
+        FORWARD_MESSAGE = 0,  //!< Sinv_s, Sinv
+        BACKWARD_MESSAGE,     //!< Vinv_v, Vinv
+        TASK_MESSAGE,         //!< r, R, rhat, qhat
+        BELIEF,               //!< b, Binv
+        NUM_STATE_BLOCKS
+    };
+
+    /// The sweep state is double-buffered per block and time step: current_(block, t) indexes the buffer holding the current
+    /// value and checkpoint_(block, t) the buffer holding the last most optimal value. The first update of a block after a
+    /// checkpoint writes to the other buffer. Checkpointing and rollback only reassign the indices, no state is copied.
+    /// The trajectory and its costs are double-buffered as a whole.
+    SweepState state_buffers_[2];
+    Eigen::Array<int, NUM_STATE_BLOCKS, Eigen::Dynamic> current_;     //!< Buffer index of the current value of each block and time step
+    Eigen::Array<int, NUM_STATE_BLOCKS, Eigen::Dynamic> checkpoint_;  //!< Buffer index of the checkpointed value of each block and time step
+    int current_trajectory_ = 0;                                      //!< Buffer index of the current trajectory (q, cost_control, cost_task)
+    int checkpoint_trajectory_ = 1;                                   //!< Buffer index of the checkpointed trajectory
+
+    /// \brief Returns the buffer holding the current value of a block at time step t.
+    inline SweepState& Current(StateBlock block, int t) { return state_buffers_[current_(block, t)]; }
+
+    /// \brief Returns the buffer an update of a block at time step t writes to. The checkpoint is never overwritten.
+    inline SweepState& Writable(StateBlock block, int t)
+    {
+        current_(block, t) = 1 - checkpoint_(block, t);
+        return state_buffers_[current_(block, t)];
+    }
+
+    /// \brief Returns the buffer holding the current trajectory.
+    inline SweepState& Trajectory() { return state_buffers_[current_trajectory_]; }
+
+    Eigen::MatrixXd damping_reference_;                      //!< Damping reference point
     double cost_ = 0.0;                                      //!< cost of MAP trajectory
     double cost_old_ = std::numeric_limits<double>::max();   //!< cost of MAP trajectory (last most optimal value)
     double cost_prev_ = std::numeric_limits<double>::max();  //!< previous iteration cost
     double b_step_ = 0.0;                                    //!< Squared configuration space step
     double b_step_old_;
 
-    Eigen::MatrixXd W;     //!< Configuration space weight matrix inverse
-    Eigen::MatrixXd Winv;  //!< Configuration space weight matrix inverse
+    Eigen::MatrixXd W;     //!< Configuration space weight matrix
+    Eigen::MatrixXd Winv;  //!< Inverse of W (covariance form only)
+
+    // Preallocated workspaces of the message and belief updates (sized in InitMessages)
+    Eigen::LLT<Eigen::MatrixXd> llt_;          //!< Cholesky factorisation, reused by all message and belief updates
+    Eigen::MatrixXd message_factor_;           //!< L^{-1} W, where L L^T = S^{-1} + R + W
+    Eigen::VectorXd message_information_;      //!< L^{-1} (S^{-1} s + r)
+    Eigen::MatrixXd task_jacobian_transpose_;  //!< Transposed Jacobian of a single task
+    Eigen::VectorXd task_residual_;            //!< Linearised residual of a single task
 
     int last_T_;  //!< T the last time InitMessages was called.
 
@@ -175,6 +216,10 @@ private:
     /// \f$ s_t=a_{t-1}\!+\!A_{t-1}(S_{t-1}^{-1}\!+\!R_{t-1})^{-1}(S_{t-1}^{-1}s_{t-1}\!+\!r_{t-1}) \f$
     /// and
     /// \f$ S_t=Q+B_tH^{-1}B_t^{\!\top\!} + A_{t-1}(S_{t-1}^{-1}+R_{t-1})^{-1}A_{t-1}^{\!\top\!} \f$.
+    /// The message is computed in information form without explicit inverses. With \f$ W=(Q+B_tH^{-1}B_t^{\!\top\!})^{-1} \f$,
+    /// \f$ M=S_{t-1}^{-1}+R_{t-1}+W=LL^{\!\top\!} \f$ and \f$ X=L^{-1}W \f$:
+    /// \f$ S_t^{-1}=W-X^{\!\top\!}X \f$ and \f$ S_t^{-1}s_t=X^{\!\top\!}L^{-1}(S_{t-1}^{-1}s_{t-1}+r_{t-1}) \f$,
+    /// i.e., a single Cholesky factorisation per message. If UseInformationForm is disabled, the covariance form above is evaluated directly.
     void UpdateFwdMessage(int t);
 
     /// \brief Updates the backward message at time step $t$
@@ -185,9 +230,20 @@ private:
     /// \f$ v_t=-A_{t}^{-1}a_{t}\!\!+\!\!A_{t}^{-1}(V_{t+1}^{-1}\!\!+\!\!R_{t+1})^{-1}(V_{t+1}^{-1}v_{t+1}\!\!+\!\!r_{t+1}) \f$
     /// and
     /// \f$ V_t=A_{t}^{-1}[Q+B_tH^{-1}B_t^{\!\top\!} + (V_{t+1}^{-1}+R_{t+1})^{-1}]A_{t}^{-{\!\top\!}} \f$.
-    ///
+    /// The message is computed in information form, see UpdateFwdMessage.
     void UpdateBwdMessage(int t);
 
+    /// \brief Computes the precision and information vector of a message in information form.
+    /// @param Pinv_p Information vector of the incoming message.
+    /// @param Pinv Precision of the incoming message.
+    /// @param t Time step of the incoming task message.
+    /// @param Minv_m Resulting information vector.
+    /// @param Minv Resulting precision.
+    void ComputeMessage(const Eigen::Ref<const Eigen::VectorXd>& Pinv_p, const Eigen::Ref<const Eigen::MatrixXd>& Pinv, int t, Eigen::Ref<Eigen::VectorXd> Minv_m, Eigen::Ref<Eigen::MatrixXd> Minv);
+
+    /// \brief Updates the belief at time step $t$ from the current messages.
+    void UpdateBelief(int t);
+
     /// brief Updates the task message at time step $t$
     /// @param t Time step
     /// @param qhat_t Point of linearisation at time step $t$
@@ -228,15 +284,15 @@ private:
     void UpdateTimestepGaussNewton(int t, bool update_fwd, bool update_bwd,
                                    int max_relocation_iterations, double tolerance, double max_step_size = -1.);
 
-    /// \brief Computes the cost of the trajectory
-    /// @param x Trajectory.
+    /// \brief Computes the cost of the current trajectory, see Trajectory().
+    /// @param skip_update Skip the problem update (roll-out) if the problem is already up to date.
     /// @return Cost of the trajectory.
-    double EvaluateTrajectory(const std::vector<Eigen::VectorXd>& x, bool skip_update = false);
+    double EvaluateTrajectory(bool skip_update = false);
 
-    /// \brief Stores the previous state.
+    /// \brief Checkpoints the current state (reassigns the buffer indices).
     void RememberOldState();
 
-    /// \brief Reverts back to previous state if the cost of the current state is higher.
+    /// \brief Reverts back to the checkpoint if the cost of the current state is higher (reassigns the buffer indices).
     void PerhapsUndoStep();
 
     ///\brief Updates the task cost terms \f$ R, r, \hat{r} \f$ for time step \f$t\f$. UnconstrainedTimeIndexedProblem::Update() has to be called before calling this function.
@@ -63,6 +63,7 @@ void AICOSolver::Instantiate(const AICOSolverInitializer& init)
     function_tolerance_ = init.FunctionTolerance;
     damping_init_ = init.Damping;
     use_bwd_msg_ = init.UseBackwardMessage;
+    use_information_form_ = init.UseInformationForm;
     verbose_ = init.Verbose;
 }
 
@@ -84,6 +85,7 @@ void AICOSolver::SpecifyProblem(PlanningProblemPtr problem)
 
 void AICOSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("AICOSolver::Solve");
     prob_->PreUpdate();
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
     prob_->termination_criterion = TerminationCriterion::NotStarted;
@@ -137,7 +139,11 @@ void AICOSolver::Solve(Eigen::MatrixXd& solution)
             break;
         }
 
+        if (CheckTimeBudget(timer, iteration_count_)) break;
+
+        Timer sweep_timer;
         d = Step();
+        RecordTiming(SolverPhase::Sweep, sweep_timer.GetDuration());
         if (d < 0)
         {
             ThrowNamed("Negative step size!");
@@ -191,15 +197,54 @@ void AICOSolver::Solve(Eigen::MatrixXd& solution)
         prob_->termination_criterion = TerminationCriterion::IterationLimit;
     }
 
-    Eigen::MatrixXd sol(prob_->GetT(), prob_->N);
-    for (int tt = 0; tt < prob_->GetT(); ++tt)
-    {
-        sol.row(tt) = q[tt];
-    }
-    solution = sol;
+    solution = Trajectory().q.transpose();
     planning_time_ = timer.GetDuration();
 }
 
+namespace
+{
+/// Returns the N x N block of time step t of a quantity stored as consecutive blocks of an N x NT matrix.
+inline Eigen::MatrixXd::ColsBlockXpr Slice(Eigen::MatrixXd& m, int t)
+{
+    return m.middleCols(t * m.rows(), m.rows());
+}
+
+inline Eigen::MatrixXd::ConstColsBlockXpr Slice(const Eigen::MatrixXd& m, int t)
+{
+    return m.middleCols(t * m.rows(), m.rows());
+}
+}  // namespace
+
+void AICOSolver::SweepState::Resize(int N, int T)
+{
+    Sinv_s.setZero(N, T);
+    Sinv.setZero(N, N * T);
+    Vinv_v.setZero(N, T);
+    Vinv.setZero(N, N * T);
+    r.setZero(N, T);
+    R.setZero(N, N * T);
+    rhat.setZero(T);
+    b.setZero(N, T);
+    Binv.setZero(N, N * T);
+    q.setZero(N, T);
+    qhat.setZero(N, T);
+    cost_control.setZero(T);
+    cost_task.setZero(T);
+}
+
+std::size_t AICOSolver::SweepState::GetMemoryUsage() const
+{
+    return sizeof(double) * (Sinv_s.size() + Sinv.size() + Vinv_v.size() + Vinv.size() + r.size() + R.size() + rhat.size() +
+                             b.size() + Binv.size() + q.size() + qhat.size() + cost_control.size() + cost_task.size());
+}
+
+std::size_t AICOSolver::GetMemoryUsage() const
+{
+    return state_buffers_[0].GetMemoryUsage() + state_buffers_[1].GetMemoryUsage() + sizeof(int) * (current_.size() + checkpoint_.size()) +
+           sizeof(double) * (damping_reference_.size() + W.size() + Winv.size() + message_factor_.size() + message_information_.size() +
+                             task_jacobian_transpose_.size() + task_residual_.size() + llt_.matrixLLT().size());
+}
+
 void AICOSolver::InitMessages()
 {
     if (prob_ == nullptr) ThrowNamed("Problem definition is a NULL pointer!");
@@ -213,17 +258,21 @@ void AICOSolver::InitMessages()
         ThrowNamed("Number of time steps is too small: T=" << prob_->GetT());
     }
 
-    s.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    Sinv.assign(prob_->GetT(), Eigen::MatrixXd::Zero(prob_->N, prob_->N));
-    Sinv[0].diagonal().setConstant(1e10);
-    v.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    Vinv.assign(prob_->GetT(), Eigen::MatrixXd::Zero(prob_->N, prob_->N));
+    const int N = prob_->N;
+    const int T = prob_->GetT();
+    // Time steps which are never updated (the first forward message and belief) are read from the first buffer.
+    state_buffers_[0].Resize(N, T);
+    state_buffers_[1].Resize(N, T);
+    current_.setZero(NUM_STATE_BLOCKS, T);
+    checkpoint_.setOnes(NUM_STATE_BLOCKS, T);
+    SweepState& x = state_buffers_[0];
+    Slice(x.Sinv, 0).diagonal().setConstant(1e10);
     if (use_bwd_msg_)
     {
-        if (bwd_msg_v_.rows() == prob_->N && bwd_msg_Vinv_.rows() == prob_->N && bwd_msg_Vinv_.cols() == prob_->N)
+        if (bwd_msg_v_.rows() == N && bwd_msg_Vinv_.rows() == N && bwd_msg_Vinv_.cols() == N)
         {
-            v[prob_->GetT() - 1] = bwd_msg_v_;
-            Vinv[prob_->GetT() - 1] = bwd_msg_Vinv_;
+            x.Vinv_v.col(T - 1).noalias() = bwd_msg_Vinv_ * bwd_msg_v_;
+            Slice(x.Vinv, T - 1) = bwd_msg_Vinv_;
         }
         else
         {
@@ -231,30 +280,25 @@ void AICOSolver::InitMessages()
             WARNING("Backward message initialisation skipped, matrices have incorrect dimensions.");
         }
     }
-    b.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    damping_reference_.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    Binv.assign(prob_->GetT(), Eigen::MatrixXd::Zero(prob_->N, prob_->N));
-    Binv[0].setIdentity();
-    Binv[0] = Binv[0] * 1e10;
-    r.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    R.assign(prob_->GetT(), Eigen::MatrixXd::Zero(prob_->N, prob_->N));
-    rhat = Eigen::VectorXd::Zero(prob_->GetT());
-    qhat.assign(prob_->GetT(), Eigen::VectorXd::Zero(prob_->N));
-    q = b;
-
-    cost_control_.resize(prob_->GetT());
-    cost_control_.setZero();
-    cost_task_.resize(prob_->GetT());
-    cost_task_.setZero();
-
-    q_stat_.resize(prob_->GetT());
-    for (int t = 0; t < prob_->GetT(); ++t)
+    Slice(x.Binv, 0).diagonal().setConstant(1e10);
+    damping_reference_.setZero(N, T);
+
+    q_stat_.resize(T);
+    for (int t = 0; t < T; ++t)
     {
-        q_stat_[t].resize(prob_->N);
+        q_stat_[t].resize(N);
     }
 
+    llt_ = Eigen::LLT<Eigen::MatrixXd>(N);
+    message_factor_.resize(N, N);
+    message_information_.resize(N);
+    task_jacobian_transpose_.resize(N, prob_->cost.length_jacobian);
+    task_residual_.resize(prob_->cost.length_jacobian);
+
+    if (debug_) HIGHLIGHT("AICO state memory: " << GetMemoryUsage() / (1024.0 * 1024.0) << " MiB (T=" << T << ", N=" << N << ")");
+
     // Set last_T_ to the problem T
-    last_T_ = prob_->GetT();
+    last_T_ = T;
 }
 
 void AICOSolver::InitTrajectory(const std::vector<Eigen::VectorXd>& q_init)
@@ -263,26 +307,40 @@ void AICOSolver::InitTrajectory(const std::vector<Eigen::VectorXd>& q_init)
     {
         ThrowNamed("Incorrect number of timesteps provided!");
     }
-    qhat = q_init;
-    q = q_init;
-    damping_reference_ = q_init;
-    b = q_init;
-    s = q_init;
-    v = q_init;
+
+    // The initial trajectory is written into the first buffer. There is no checkpoint yet.
+    current_.setZero();
+    checkpoint_.setOnes();
+    current_trajectory_ = 0;
+    checkpoint_trajectory_ = 1;
+    SweepState& x = state_buffers_[0];
+    for (int t = 0; t < prob_->GetT(); ++t)
+    {
+        x.qhat.col(t) = q_init[t];
+        x.q.col(t) = q_init[t];
+        x.b.col(t) = q_init[t];
+        damping_reference_.col(t) = q_init[t];
+    }
     for (int t = 1; t < prob_->GetT(); ++t)
     {
-        Sinv.at(t).setZero();
-        Sinv.at(t).diagonal().setConstant(damping);
+        Slice(x.Sinv, t).setZero();
+        Slice(x.Sinv, t).diagonal().setConstant(damping);
     }
     for (int t = 0; t < prob_->GetT(); ++t)
     {
-        Vinv.at(t).setZero();
-        Vinv.at(t).diagonal().setConstant(damping);
+        Slice(x.Vinv, t).setZero();
+        Slice(x.Vinv, t).diagonal().setConstant(damping);
+    }
+    for (int t = 0; t < prob_->GetT(); ++t)
+    {
+        // Messages are initialised with their means at the initial trajectory
+        x.Sinv_s.col(t).noalias() = Slice(x.Sinv, t) * q_init[t];
+        x.Vinv_v.col(t).noalias() = Slice(x.Vinv, t) * q_init[t];
     }
     for (int t = 0; t < prob_->GetT(); ++t)
     {
         // Compute task message reference
-        UpdateTaskMessage(t, b[t], 0.0);
+        UpdateTaskMessage(t, x.b.col(t), 0.0);
     }
 
     // W is still writable, check dimension
@@ -291,69 +349,117 @@ void AICOSolver::InitTrajectory(const std::vector<Eigen::VectorXd>& q_init)
         ThrowNamed(prob_->W.rows() << "!=" << prob_->N);
     }
 
-    // Set constant W,Win,H,Hinv
+    // Set constant W
     W = prob_->W;
-    Winv = W.inverse();
+    if (!use_information_form_) inverseSymPosDef(Winv, W);
 
-    cost_ = EvaluateTrajectory(b, true);  // The problem will be updated via UpdateTaskMessage, i.e. do not update on this roll-out
+    cost_ = EvaluateTrajectory(true);  // The problem will be updated via UpdateTaskMessage, i.e. do not update on this roll-out
     cost_prev_ = cost_;
     prob_->SetCostEvolution(0, cost_);
     if (cost_ < 0) ThrowNamed("Invalid cost! " << cost_);
-    if (debug_) HIGHLIGHT("Initial cost, updates: " << update_count_ << ", cost_(ctrl/task/total): " << cost_control_.sum() << "/" << cost_task_.sum() << "/" << cost_);
-    RememberOldState();
+    if (debug_) HIGHLIGHT("Initial cost, updates: " << update_count_ << ", cost_(ctrl/task/total): " << x.cost_control.sum() << "/" << x.cost_task.sum() << "/" << cost_);
+}
+
+void AICOSolver::ComputeMessage(const Eigen::Ref<const Eigen::VectorXd>& Pinv_p, const Eigen::Ref<const Eigen::MatrixXd>& Pinv, int t, Eigen::Ref<Eigen::VectorXd> Minv_m, Eigen::Ref<Eigen::MatrixXd> Minv)
+{
+    const SweepState& task = Current(TASK_MESSAGE, t);
+    if (!use_information_form_)
+    {
+        // M = W^{-1} + (P^{-1} + R)^{-1}, m = (P^{-1} + R)^{-1} (P^{-1} p + r)
+        Eigen::MatrixXd barP(prob_->N, prob_->N), Mt;
+        inverseSymPosDef(barP, Pinv + Slice(task.R, t));
+        const Eigen::VectorXd m = barP * (Pinv_p + task.r.col(t));
+        Mt = Winv + barP;
+        inverseSymPosDef(Minv, Mt);
+        Minv_m.noalias() = Minv * m;
+        return;
+    }
+
+    // (W^{-1} + (P^{-1} + R)^{-1})^{-1} = W - W (P^{-1} + R + W)^{-1} W
+    llt_.compute(Pinv + Slice(task.R, t) + W);
+    if (llt_.info() != Eigen::Success) ThrowNamed("Message precision is not positive definite at t=" << t);
+
+    message_factor_ = W;
+    llt_.matrixL().solveInPlace(message_factor_);
+    message_information_ = Pinv_p + task.r.col(t);
+    llt_.matrixL().solveInPlace(message_information_);
+
+    Minv_m.noalias() = message_factor_.transpose() * message_information_;
+    Minv = W;
+    Minv.noalias() -= message_factor_.transpose() * message_factor_;
 }
 
 void AICOSolver::UpdateFwdMessage(int t)
 {
-    Eigen::MatrixXd barS(prob_->N, prob_->N), St;
-    inverseSymPosDef(barS, Sinv[t - 1] + R[t - 1]);
-    s[t] = barS * (Sinv[t - 1] * s[t - 1] + r[t - 1]);
-    St = Winv + barS;
-    inverseSymPosDef(Sinv[t], St);
+    const SweepState& previous = Current(FORWARD_MESSAGE, t - 1);
+    SweepState& x = Writable(FORWARD_MESSAGE, t);
+    ComputeMessage(previous.Sinv_s.col(t - 1), Slice(previous.Sinv, t - 1), t - 1, x.Sinv_s.col(t), Slice(x.Sinv, t));
 }
 
 void AICOSolver::UpdateBwdMessage(int t)
 {
-    Eigen::MatrixXd barV(prob_->N, prob_->N), Vt;
     if (t < prob_->GetT() - 1)
     {
-        inverseSymPosDef(barV, Vinv[t + 1] + R[t + 1]);
-        v[t] = barV * (Vinv[t + 1] * v[t + 1] + r[t + 1]);
-        Vt = Winv + barV;
-        inverseSymPosDef(Vinv[t], Vt);
+        const SweepState& next = Current(BACKWARD_MESSAGE, t + 1);
+        SweepState& x = Writable(BACKWARD_MESSAGE, t);
+        ComputeMessage(next.Vinv_v.col(t + 1), Slice(next.Vinv, t + 1), t + 1, x.Vinv_v.col(t), Slice(x.Vinv, t));
     }
     if (t == prob_->GetT() - 1)
     {
+        SweepState& x = Writable(BACKWARD_MESSAGE, t);
         if (!use_bwd_msg_)
         {
-            v[t] = b[t];
-            Vinv[t].diagonal().setConstant(1);
+            Slice(x.Vinv, t).setIdentity();
+            x.Vinv_v.col(t) = Current(BELIEF, t).b.col(t);
         }
         else
         {
-            v[prob_->GetT() - 1] = bwd_msg_v_;
-            Vinv[prob_->GetT() - 1] = bwd_msg_Vinv_;
+            x.Vinv_v.col(t).noalias() = bwd_msg_Vinv_ * bwd_msg_v_;
+            Slice(x.Vinv, t) = bwd_msg_Vinv_;
         }
     }
 }
 
+void AICOSolver::UpdateBelief(int t)
+{
+    const SweepState& fwd = Current(FORWARD_MESSAGE, t);
+    const SweepState& bwd = Current(BACKWARD_MESSAGE, t);
+    const SweepState& task = Current(TASK_MESSAGE, t);
+    SweepState& x = Writable(BELIEF, t);
+    Eigen::Ref<Eigen::MatrixXd> Binv_t = Slice(x.Binv, t);
+    Eigen::Ref<Eigen::VectorXd> b_t = x.b.col(t);
+
+    Binv_t = Slice(fwd.Sinv, t) + Slice(bwd.Vinv, t) + Slice(task.R, t);
+    b_t = fwd.Sinv_s.col(t) + bwd.Vinv_v.col(t) + task.r.col(t);
+    if (damping != 0.0)
+    {
+        Binv_t.diagonal().array() += damping;
+        b_t += damping * damping_reference_.col(t);
+    }
+
+    llt_.compute(Binv_t);
+    llt_.solveInPlace(b_t);
+}
+
 void AICOSolver::UpdateTaskMessage(int t,
                                    const Eigen::Ref<const Eigen::VectorXd>& qhat_t, double tolerance,
                                    double max_step_size)
 {
-    Eigen::VectorXd diff = qhat_t - qhat[t];
+    const SweepState& current = Current(TASK_MESSAGE, t);
+    Eigen::VectorXd diff = qhat_t - current.qhat.col(t);
     if ((diff.array().abs().maxCoeff() < tolerance)) return;
+    Eigen::Ref<Eigen::VectorXd> qhat = Writable(TASK_MESSAGE, t).qhat.col(t);
     double nrm = diff.norm();
     if (max_step_size > 0. && nrm > max_step_size)
     {
-        qhat[t] += diff * (max_step_size / nrm);
+        qhat = current.qhat.col(t) + diff * (max_step_size / nrm);
     }
     else
     {
-        qhat[t] = qhat_t;
+        qhat = qhat_t;
     }
 
-    prob_->Update(qhat[t], t);
+    prob_->Update(qhat, t);
     ++update_count_;
     double c = GetTaskCosts(t);
     q_stat_[t].addw(c > 0 ? 1.0 / (1.0 + c) : 1.0, qhat_t);
@@ -361,12 +467,14 @@ void AICOSolver::UpdateTaskMessage(int t,
 
 double AICOSolver::GetTaskCosts(int t)
 {
+    SweepState& x = Writable(TASK_MESSAGE, t);
     double C = 0;
-    Eigen::MatrixXd Jt;
     double prec;
-    rhat[t] = 0;
-    R[t].setZero();
-    r[t].setZero();
+    Eigen::Ref<Eigen::MatrixXd> R = Slice(x.R, t);
+    Eigen::Ref<Eigen::VectorXd> r = x.r.col(t);
+    x.rhat(t) = 0;
+    R.setZero();
+    r.setZero();
     for (int i = 0; i < prob_->cost.num_tasks; ++i)
     {
         prec = prob_->cost.rho[t](i);
@@ -374,11 +482,15 @@ double AICOSolver::GetTaskCosts(int t)
         {
             int start = prob_->cost.indexing[i].start_jacobian;
             int len = prob_->cost.indexing[i].length_jacobian;
+            Eigen::Ref<Eigen::MatrixXd> Jt = task_jacobian_transpose_.leftCols(len);
+            Eigen::Ref<Eigen::VectorXd> residual = task_residual_.head(len);
             Jt = prob_->cost.jacobian[t].middleRows(start, len).transpose();
+            residual.noalias() = Jt.transpose() * x.qhat.col(t);
+            residual -= prob_->cost.ydiff[t].segment(start, len);
             C += prec * (prob_->cost.ydiff[t].segment(start, len)).squaredNorm();
-            R[t] += prec * Jt * prob_->cost.jacobian[t].middleRows(start, len);
-            r[t] += prec * Jt * (-prob_->cost.ydiff[t].segment(start, len) + prob_->cost.jacobian[t].middleRows(start, len) * qhat[t]);
-            rhat[t] += prec * (-prob_->cost.ydiff[t].segment(start, len) + prob_->cost.jacobian[t].middleRows(start, len) * qhat[t]).squaredNorm();
+            R.noalias() += prec * Jt * Jt.transpose();
+            r.noalias() += prec * Jt * residual;
+            x.rhat(t) += prec * residual.squaredNorm();
         }
     }
     return prob_->get_ct() * C;
@@ -388,40 +500,23 @@ void AICOSolver::UpdateTimestep(int t, bool update_fwd, bool update_bwd,
                                 int max_relocation_iterations, double tolerance, bool force_relocation,
                                 double max_step_size)
 {
+    EXOTICA_PROFILE_ZONE("AICOSolver::UpdateTimestep");
     if (update_fwd) UpdateFwdMessage(t);
     if (update_bwd) UpdateBwdMessage(t);
 
-    if (damping != 0.0)
-    {
-        Binv[t] = Sinv[t] + Vinv[t] + R[t] + Eigen::MatrixXd::Identity(prob_->N, prob_->N) * damping;
-        AinvBSymPosDef(b[t], Binv[t], Sinv[t] * s[t] + Vinv[t] * v[t] + r[t] + damping * damping_reference_[t]);
-    }
-    else
-    {
-        Binv[t] = Sinv[t] + Vinv[t] + R[t];
-        AinvBSymPosDef(b[t], Binv[t], Sinv[t] * s[t] + Vinv[t] * v[t] + r[t]);
-    }
+    UpdateBelief(t);
 
     for (int k = 0; k < max_relocation_iterations && !(Server::IsRos() && !ros::ok()); ++k)
     {
-        if (!((!k && force_relocation) || (b[t] - qhat[t]).array().abs().maxCoeff() > tolerance)) break;
+        if (!((!k && force_relocation) || (Current(BELIEF, t).b.col(t) - Current(TASK_MESSAGE, t).qhat.col(t)).array().abs().maxCoeff() > tolerance)) break;
 
-        UpdateTaskMessage(t, b.at(t), 0., max_step_size);
+        UpdateTaskMessage(t, Current(BELIEF, t).b.col(t), 0., max_step_size);
 
         //optional reUpdate fwd or bwd message (if the Dynamics might have changed...)
         if (update_fwd) UpdateFwdMessage(t);
         if (update_bwd) UpdateBwdMessage(t);
 
-        if (damping != 0.0)
-        {
-            Binv[t] = Sinv[t] + Vinv[t] + R[t] + Eigen::MatrixXd::Identity(prob_->N, prob_->N) * damping;
-            AinvBSymPosDef(b[t], Binv[t], Sinv[t] * s[t] + Vinv[t] * v[t] + r[t] + damping * damping_reference_[t]);
-        }
-        else
-        {
-            Binv[t] = Sinv[t] + Vinv[t] + R[t];
-            AinvBSymPosDef(b[t], Binv[t], Sinv[t] * s[t] + Vinv[t] * v[t] + r[t]);
-        }
+        UpdateBelief(t);
     }
 }
 
@@ -429,17 +524,19 @@ void AICOSolver::UpdateTimestepGaussNewton(int t, bool update_fwd,
                                            bool update_bwd, int max_relocation_iterations, double tolerance,
                                            double max_step_size)
 {
+    EXOTICA_PROFILE_ZONE("AICOSolver::UpdateTimestepGaussNewton");
     // TODO: implement UpdateTimestepGaussNewton
     ThrowNamed("Not implemented yet!");
 }
 
-double AICOSolver::EvaluateTrajectory(const std::vector<Eigen::VectorXd>& x,
-                                      bool skip_update)
+double AICOSolver::EvaluateTrajectory(bool skip_update)
 {
     if (verbose_) ROS_WARN_STREAM("Evaluating, iteration " << iteration_count_ << ", sweep " << sweep_);
     Timer timer;
 
-    q = x;
+    const Eigen::MatrixXd& q = Trajectory().q;
+    Eigen::VectorXd& cost_control = Trajectory().cost_control;
+    Eigen::VectorXd& cost_task = Trajectory().cost_task;
 
     // Perform update / roll-out
     if (!skip_update)
@@ -447,12 +544,13 @@ double AICOSolver::EvaluateTrajectory(const std::vector<Eigen::VectorXd>& x,
         for (int t = 0; t < prob_->GetT(); ++t)
         {
             ++update_count_;
-            if (!q[t].allFinite())
+            if (!q.col(t).allFinite())
             {
-                ThrowNamed("q[" << t << "] is not finite: " << q[t].transpose());
+                ThrowNamed("q[" << t << "] is not finite: " << q.col(t).transpose());
             }
-            prob_->Update(q[t], t);
+            prob_->Update(q.col(t), t);
         }
+        RecordTiming(SolverPhase::ProblemUpdate, timer.GetDuration());
     }
     if (verbose_ && !skip_update) HIGHLIGHT("Roll-out took: " << timer.GetDuration());
 
@@ -461,13 +559,13 @@ double AICOSolver::EvaluateTrajectory(const std::vector<Eigen::VectorXd>& x,
         if (Server::IsRos() && !ros::ok()) return -1.0;
 
         // Control cost
-        cost_control_(t) = prob_->GetScalarTransitionCost(t);
+        cost_control(t) = prob_->GetScalarTransitionCost(t);
 
         // Task cost
-        cost_task_(t) = prob_->GetScalarTaskCost(t);
+        cost_task(t) = prob_->GetScalarTaskCost(t);
     }
 
-    cost_ = cost_control_.sum() + cost_task_.sum();
+    cost_ = cost_control.sum() + cost_task.sum();
     return cost_;
 }
 
@@ -524,21 +622,24 @@ double AICOSolver::Step()
         default:
             ThrowNamed("non-existing Sweep mode");
     }
+    // The new trajectory consists of the belief means
+    current_trajectory_ = 1 - checkpoint_trajectory_;
+    Eigen::MatrixXd& q = Trajectory().q;
     b_step_ = 0.0;
-    for (t = 0; t < static_cast<int>(b.size()); ++t)
+    for (t = 0; t < prob_->GetT(); ++t)
     {
-        b_step_ = std::max((b_old[t] - b[t]).array().abs().maxCoeff(), b_step_);
+        q.col(t) = Current(BELIEF, t).b.col(t);
+        b_step_ = std::max(b_step_, (state_buffers_[checkpoint_(BELIEF, t)].b.col(t) - q.col(t)).array().abs().maxCoeff());
     }
-    damping_reference_ = b;
-    // q is set inside of EvaluateTrajectory() function
-    cost_ = EvaluateTrajectory(b);
+    damping_reference_ = q;
+    cost_ = EvaluateTrajectory();
     if (verbose_)
     {
-        HIGHLIGHT("Iteration: " << iteration_count_ << ", Sweep: " << sweep_ << ", updates: " << update_count_ << ", cost(ctrl/task/total): " << cost_control_.sum() << "/" << cost_task_.sum() << "/" << cost_ << " (dq=" << b_step_ << ", damping=" << damping << ")");
+        HIGHLIGHT("Iteration: " << iteration_count_ << ", Sweep: " << sweep_ << ", updates: " << update_count_ << ", cost(ctrl/task/total): " << Trajectory().cost_control.sum() << "/" << Trajectory().cost_task.sum() << "/" << cost_ << " (dq=" << b_step_ << ", damping=" << damping << ")");
     }
     else if (debug_ && sweep_ == 0)
     {
-        HIGHLIGHT("Iteration: " << iteration_count_ << ", updates: " << update_count_ << ", cost(ctrl/task/total): " << cost_control_.sum() << "/" << cost_task_.sum() << "/" << cost_ << " (dq=" << b_step_ << ", damping=" << damping << ")");
+        HIGHLIGHT("Iteration: " << iteration_count_ << ", updates: " << update_count_ << ", cost(ctrl/task/total): " << Trajectory().cost_control.sum() << "/" << Trajectory().cost_task.sum() << "/" << cost_ << " (dq=" << b_step_ << ", damping=" << damping << ")");
     }
     if (cost_ < 0) return -1.0;
     best_sweep_ = sweep_;
@@ -560,21 +661,11 @@ double AICOSolver::Step()
 
 void AICOSolver::RememberOldState()
 {
-    s_old = s;
-    Sinv_old = Sinv;
-    v_old = v;
-    Vinv_old = Vinv;
-    r_old = r;
-    R_old = R;
-    Binv_old = Binv;
-    rhat_old = rhat;
-    b_old = b;
-    r_old = r;
-    q_old = q;
-    qhat_old = qhat;
+    // The current state becomes the checkpoint. Updates of the next sweep are written to the other buffer.
+    checkpoint_ = current_;
+    checkpoint_trajectory_ = current_trajectory_;
+
     cost_old_ = cost_;
-    cost_control_old_ = cost_control_;
-    cost_task_old_ = cost_task_;
     best_sweep_old_ = best_sweep_;
     b_step_old_ = b_step_;
 }
@@ -585,22 +676,10 @@ void AICOSolver::PerhapsUndoStep()
     {
         sweep_improved_cost_ = false;
         damping *= 10.;
-        s = s_old;
-        Sinv = Sinv_old;
-        v = v_old;
-        Vinv = Vinv_old;
-        r = r_old;
-        R = R_old;
-        Binv = Binv_old;
-        rhat = rhat_old;
-        b = b_old;
-        r = r_old;
-        q = q_old;
-        qhat = qhat_old;
+        current_ = checkpoint_;
+        current_trajectory_ = checkpoint_trajectory_;
         cost_ = cost_old_;
-        damping_reference_ = b_old;
-        cost_control_ = cost_control_old_;
-        cost_task_ = cost_task_old_;
+        damping_reference_ = Trajectory().q;
         best_sweep_ = best_sweep_old_;
         b_step_ = b_step_old_;
         if (verbose_) HIGHLIGHT("Reverting to previous line-search step (" << best_sweep_ << ")");
@@ -78,6 +78,7 @@ void BayesianIKSolver::SpecifyProblem(PlanningProblemPtr problem)
 
 void BayesianIKSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("BayesianIKSolver::Solve");
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
     prob_->termination_criterion = TerminationCriterion::NotStarted;
     planning_time_ = -1;
@@ -300,6 +301,7 @@ void BayesianIKSolver::UpdateTimestep(bool update_fwd, bool update_bwd,
                                       int max_relocation_iterations, double tolerance, bool force_relocation,
                                       double max_step_size)
 {
+    EXOTICA_PROFILE_ZONE("BayesianIKSolver::UpdateTimestep");
     if (update_fwd) UpdateFwdMessage();
     if (update_bwd) UpdateBwdMessage();
 
@@ -341,6 +343,7 @@ void BayesianIKSolver::UpdateTimestepGaussNewton(bool update_fwd,
                                                  bool update_bwd, int max_relocation_iterations, double tolerance,
                                                  double max_step_size)
 {
+    EXOTICA_PROFILE_ZONE("BayesianIKSolver::UpdateTimestepGaussNewton");
     // TODO: implement UpdateTimestepGaussNewton
     ThrowNamed("Not implemented yet!");
 }
@@ -30,6 +30,8 @@
 #ifndef EXOTICA_DDP_SOLVER_ABSTRACT_DDP_SOLVER_H_
 #define EXOTICA_DDP_SOLVER_ABSTRACT_DDP_SOLVER_H_
 
+#include <algorithm>
+
 #include <exotica_core/feedback_motion_solver.h>
 #include <exotica_core/problems/dynamic_time_indexed_shooting_problem.h>
 #include <exotica_core/server.h>
@@ -54,6 +56,13 @@ public:
 
     Eigen::VectorXd GetFeedbackControl(Eigen::VectorXdRefConst x, int t) const override;
 
+    ///\brief Advances the horizon by one knot for receding-horizon control (MPC).
+    /// Shifts the trajectories of the problem as well as the gains, value function and
+    /// reference trajectories of the solver in place. The next Solve is warm-started from
+    /// the shifted data and keeps the buffers and regularization of the last solve.
+    ///@param x_measured Measured state, becomes the start state of the problem.
+    virtual void ShiftHorizon(Eigen::VectorXdRefConst x_measured);
+
     const std::vector<Eigen::MatrixXd>& get_Vxx() const;
     const std::vector<Eigen::VectorXd>& get_Vx() const;
     const std::vector<Eigen::MatrixXd>& get_Qxx() const;
@@ -100,6 +109,35 @@ protected:
 
     AbstractDDPSolverInitializer base_parameters_;
 
+    bool warm_start_ = false;  ///< Set by ShiftHorizon: the next Solve reuses the solver data of the last solve
+    const Eigen::MatrixXd* control_cost_hessian_ = nullptr;  ///< Last control cost Hessian returned by GetControlCostHessian
+
+    ///\brief Returns true (and resets the flag) if the pending solve follows ShiftHorizon with unchanged dimensions.
+    bool ConsumeWarmStart(std::size_t expected_size)
+    {
+        const bool warm_start = warm_start_ && K_.size() == expected_size;
+        warm_start_ = false;
+        return warm_start;
+    }
+
+    ///\brief Shifts per-knot data by one knot towards the start and repeats the last element. Swaps storage, i.e., does not allocate.
+    template <typename T>
+    static void ShiftByOneKnot(std::vector<T>& data)
+    {
+        if (data.size() < 2) return;
+        std::rotate(data.begin(), data.begin() + 1, data.end());
+        data.back() = data[data.size() - 2];
+    }
+
+    ///\brief Control cost Hessian (luu) at knot t. Backward passes visit the knots from T_-2 down to 0.
+    /// If the Hessian is constant (L2 control cost), it is only evaluated at the first knot of each pass.
+    const Eigen::MatrixXd& GetControlCostHessian(int t)
+    {
+        if (t == T_ - 2 || control_cost_hessian_ == nullptr || !prob_->IsControlCostHessianConstant())
+            control_cost_hessian_ = &prob_->GetControlCostHessian(t);
+        return *control_cost_hessian_;
+    }
+
     virtual void IncreaseRegularization()
     {
         lambda_ *= 10.;
@@ -80,8 +80,15 @@ protected:
 
     virtual void AllocateData();
 
+    // Multiple-shooting evaluation: the shooting intervals start at the nodes xs_ and are independent of each other.
+    // They are distributed over num_threads_ threads, each with its own dynamics solver. Only the gap-closing forward pass is serial.
+    void CreateWorkers();
+    void SimulateShootingIntervals();    ///< Simulates the intervals from xs_ and us_ into xs_next_
+    void ComputeDynamicsDerivatives();  ///< Computes fx_ and fu_ at xs_ and us_
+
     Eigen::MatrixXd control_limits_;
     double initial_regularization_rate_ = 1e-9;             // Set from parameters on Instantiate
+    int num_threads_ = 1;                                   // Set from parameters on Instantiate
     bool clamp_to_control_limits_in_forward_pass_ = false;  // Set from parameters on Instantiate
 
     double steplength_;                  //!< Current applied step-length
@@ -109,6 +116,8 @@ protected:
     std::vector<Eigen::VectorXd> xs_try_;  //!< State trajectory computed by line-search procedure
     std::vector<Eigen::VectorXd> us_try_;  //!< Control trajectory computed by line-search procedure
     std::vector<Eigen::VectorXd> dx_;
+    std::vector<Eigen::VectorXd> xs_next_;                    //!< Successor states of the shooting intervals
+    std::vector<DynamicsSolverPtr> worker_dynamics_solvers_;  //!< Dynamics solver per thread, the first one is the problem's
 
     // allocate data
     std::vector<Eigen::VectorXd> fs_;  //!< Gaps/defects between shooting nodes
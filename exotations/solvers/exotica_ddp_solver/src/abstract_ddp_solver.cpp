@@ -33,8 +33,9 @@ namespace exotica
 {
 void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("AbstractDDPSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
-    Timer planning_timer, backward_pass_timer, line_search_timer;
+    Timer planning_timer, backward_pass_timer, line_search_timer, update_timer;
 
     T_ = prob_->get_T();
     NU_ = prob_->GetScene()->get_num_controls();
@@ -42,7 +43,8 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
     NDX_ = prob_->GetScene()->get_num_state_derivative();
     NV_ = prob_->GetScene()->get_num_velocities();
     dt_ = dynamics_solver_->get_dt();
-    lambda_ = base_parameters_.RegularizationRate;
+    const bool warm_start = ConsumeWarmStart(T_);
+    if (!warm_start) lambda_ = base_parameters_.RegularizationRate;
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
     prob_->PreUpdate();
     solution.resize(T_ - 1, NU_);
@@ -53,6 +55,7 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
     regularization_evolution_.assign(GetNumberOfMaxIterations() + 1, std::numeric_limits<double>::quiet_NaN());
 
     // Perform initial roll-out
+    update_timer.Reset();
     cost_ = 0.0;
     control_cost_ = 0.0;
     for (int t = 0; t < T_ - 1; ++t)
@@ -63,21 +66,39 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
         control_cost_ += dt_ * prob_->GetControlCost(t);
         cost_ += dt_ * prob_->GetStateCost(t);
     }
+    RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
 
     // Add terminal cost
     cost_ += prob_->GetStateCost(T_ - 1) + control_cost_;
     prob_->SetCostEvolution(0, cost_);
     control_cost_evolution_.at(0) = control_cost_;
 
-    // Initialize gain matrices
-    K_.assign(T_, Eigen::MatrixXd(NU_, NDX_));
-    k_.assign(T_, Eigen::VectorXd(NU_));
+    // After ShiftHorizon, the gains, value function and buffers of the last solve are reused
+    if (!warm_start)
+    {
+        // Initialize gain matrices
+        K_.assign(T_, Eigen::MatrixXd(NU_, NDX_));
+        k_.assign(T_, Eigen::VectorXd(NU_));
+
+        // Allocate memory by resizing commonly reused matrices:
+        X_ref_.assign(T_, Eigen::VectorXd::Zero(NX_));
+        U_ref_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
+        X_try_.assign(T_, Eigen::VectorXd::Zero(NX_));
+        U_try_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
+
+        Vxx_.assign(T_, Eigen::MatrixXd::Zero(NDX_, NDX_));
+        Vx_.assign(T_, Eigen::VectorXd::Zero(NDX_));
+
+        Qx_.assign(T_ - 1, Eigen::VectorXd::Zero(NDX_));
+        Qu_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
+        Qxx_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NDX_));
+        Qux_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NDX_));
+        Quu_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NU_));
+        Quu_inv_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NU_));
+        fx_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NDX_));
+        fu_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NU_));
+    }
 
-    // Allocate memory by resizing commonly reused matrices:
-    X_ref_.assign(T_, Eigen::VectorXd::Zero(NX_));
-    U_ref_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
-    X_try_.assign(T_, Eigen::VectorXd::Zero(NX_));
-    U_try_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
     for (int t = 0; t < T_; ++t)
     {
         X_ref_[t] = prob_->get_X(t);
@@ -89,18 +110,6 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
         U_try_[t] = prob_->get_U(t);
     }
 
-    Vxx_.assign(T_, Eigen::MatrixXd::Zero(NDX_, NDX_));
-    Vx_.assign(T_, Eigen::VectorXd::Zero(NDX_));
-
-    Qx_.assign(T_ - 1, Eigen::VectorXd::Zero(NDX_));
-    Qu_.assign(T_ - 1, Eigen::VectorXd::Zero(NU_));
-    Qxx_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NDX_));
-    Qux_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NDX_));
-    Quu_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NU_));
-    Quu_inv_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU_, NU_));
-    fx_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NDX_));
-    fu_.assign(T_ - 1, Eigen::MatrixXd::Zero(NDX_, NU_));
-
     if (debug_) HIGHLIGHT_NAMED("DDPSolver", "Running DDP solver for max " << GetNumberOfMaxIterations() << " iterations");
 
     cost_prev_ = cost_;
@@ -116,10 +125,13 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
             break;
         }
 
+        if (CheckTimeBudget(planning_timer, iteration - 1)) break;
+
         // Backward-pass computes the gains
         backward_pass_timer.Reset();
         BackwardPass();
         time_taken_backward_pass_ = backward_pass_timer.GetDuration();
+        RecordTiming(SolverPhase::BackwardPass, time_taken_backward_pass_);
 
         // Forward-pass to compute new control trajectory
         line_search_timer.Reset();
@@ -128,6 +140,9 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
         // Perform a linear search to find the best rate
         for (int ai = 0; ai < alpha_space_.size(); ++ai)
         {
+            // Out of time: keep the last accepted trajectory
+            if (ai > 0 && IsTimeBudgetExceeded(planning_timer)) break;
+
             const double& alpha = alpha_space_(ai);
             rollout_cost = ForwardPass(alpha);
 
@@ -142,6 +157,7 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
             }
         }
         time_taken_forward_pass_ = line_search_timer.GetDuration();
+        RecordTiming(SolverPhase::LineSearch, time_taken_forward_pass_);
 
         // Finiteness checks
         // if (!U_try_.allFinite())
@@ -230,8 +246,10 @@ void AbstractDDPSolver::Solve(Eigen::MatrixXd& solution)
 
         // Roll-out and store reference state trajectory
         // TODO: This roll-out may not be required => The line-search already does a roll-out.
+        update_timer.Reset();
         for (int t = 0; t < T_ - 1; ++t)
             prob_->Update(U_ref_[t], t);
+        RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
         for (int t = 0; t < T_; ++t)
             X_ref_[t] = prob_->get_X(t);
 
@@ -267,6 +285,7 @@ void AbstractDDPSolver::SpecifyProblem(PlanningProblemPtr pointer)
     MotionSolver::SpecifyProblem(pointer);
     prob_ = std::static_pointer_cast<DynamicTimeIndexedShootingProblem>(pointer);
     dynamics_solver_ = prob_->GetScene()->GetDynamicsSolver();
+    control_cost_hessian_ = nullptr;
 
     // Set up backtracking line-search coefficients
     alpha_space_ = Eigen::VectorXd::LinSpaced(11, 0.0, -3.0);
@@ -278,8 +297,23 @@ void AbstractDDPSolver::SpecifyProblem(PlanningProblemPtr pointer)
     if (debug_) HIGHLIGHT_NAMED("DDPSolver", "initialized");
 }
 
+void AbstractDDPSolver::ShiftHorizon(Eigen::VectorXdRefConst x_measured)
+{
+    if (!prob_) ThrowNamed("Solver has not been initialized!");
+    prob_->ShiftHorizon(x_measured);
+
+    ShiftByOneKnot(K_);
+    ShiftByOneKnot(k_);
+    ShiftByOneKnot(Vxx_);
+    ShiftByOneKnot(Vx_);
+    ShiftByOneKnot(X_ref_);
+    ShiftByOneKnot(U_ref_);
+    warm_start_ = true;
+}
+
 double AbstractDDPSolver::ForwardPass(const double alpha)
 {
+    EXOTICA_PROFILE_ZONE("AbstractDDPSolver::ForwardPass");
     cost_try_ = 0.0;
     control_cost_try_ = 0.0;
 
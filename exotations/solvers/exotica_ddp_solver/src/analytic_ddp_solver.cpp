@@ -41,6 +41,7 @@ void AnalyticDDPSolver::Instantiate(const AnalyticDDPSolverInitializer& init)
 
 void AnalyticDDPSolver::BackwardPass()
 {
+    EXOTICA_PROFILE_ZONE("AnalyticDDPSolver::BackwardPass");
     // NB: The DynamicTimeIndexedShootingProblem assumes row-major notation for derivatives
     //     The solvers follow DDP papers where we have a column-major notation => there will be transposes.
     Vx_.back() = prob_->GetStateCostJacobian(T_ - 1);
@@ -80,11 +81,10 @@ void AnalyticDDPSolver::BackwardPass()
 
         Qxx_[t].noalias() = dt_ * prob_->GetStateCostHessian(t);         // Eq. 20(c)        (NDX,NDX)^T => (NDX,NDX)
         Qxx_[t].noalias() += fx_[t].transpose() * Vxx_[t + 1] * fx_[t];  //                  + (NDX,NDX)^T*(NDX,NDX)*(NDX,NDX)
-        Quu_[t].noalias() = dt_ * prob_->GetControlCostHessian(t);       // Eq. 20(d)        (NU,NU)^T
+        Quu_[t].noalias() = dt_ * GetControlCostHessian(t);              // Eq. 20(d)        (NU,NU)^T
         Quu_[t].noalias() += fu_[t].transpose() * Vxx_[t + 1] * fu_[t];  //                  + (NDX,NU)^T*(NDX,NDX)*(NDX,NU)
-        // Qux_[t].noalias() = dt_ * prob_->GetStateControlCostHessian();          // Eq. 20(e)        (NU,NDX)
-        // NB: This assumes that Lux is always 0.
-        Qux_[t].noalias() = fu_[t].transpose() * Vxx_[t + 1] * fx_[t];  //                  + (NDX,NU)^T*(NDX,NDX) =>(NU,NDX)
+        Qux_[t].noalias() = fu_[t].transpose() * Vxx_[t + 1] * fx_[t];  // Eq. 20(e)        (NDX,NU)^T*(NDX,NDX) =>(NU,NDX)
+        if (prob_->HasStateControlCostCoupling()) Qux_[t].noalias() += dt_ * prob_->GetStateControlCostHessian();  //  + Lux (NU,NDX)
 
         // The tensor product terms need to be added if second-order dynamics are considered.
         if (parameters_.UseSecondOrderDynamics && dynamics_solver_->get_has_second_order_derivatives())
@@ -43,6 +43,7 @@ void ControlLimitedDDPSolver::Instantiate(const ControlLimitedDDPSolverInitializ
 
 void ControlLimitedDDPSolver::BackwardPass()
 {
+    EXOTICA_PROFILE_ZONE("ControlLimitedDDPSolver::BackwardPass");
     const Eigen::MatrixXd& control_limits = dynamics_solver_->get_control_limits();
 
     Vx_.back().noalias() = prob_->GetStateCostJacobian(T_ - 1);
@@ -69,9 +70,9 @@ void ControlLimitedDDPSolver::BackwardPass()
         Vxx_[t + 1].diagonal().array() += lambda_;
 
         Qxx_[t].noalias() = dt_ * prob_->GetStateCostHessian(t) + fx_[t].transpose() * Vxx_[t + 1] * fx_[t];
-        Quu_[t].noalias() = dt_ * prob_->GetControlCostHessian(t) + fu_[t].transpose() * Vxx_[t + 1] * fu_[t];
-        // Qux_[t].noalias() = dt_ * prob_->GetStateControlCostHessian()  // TODO: Reactivate once we have costs that depend on both x and u!
+        Quu_[t].noalias() = dt_ * GetControlCostHessian(t) + fu_[t].transpose() * Vxx_[t + 1] * fu_[t];
         Qux_[t].noalias() = fu_[t].transpose() * Vxx_[t + 1] * fx_[t];
+        if (prob_->HasStateControlCostCoupling()) Qux_[t].noalias() += dt_ * prob_->GetStateControlCostHessian();
 
         if (parameters_.UseSecondOrderDynamics && dynamics_solver_->get_has_second_order_derivatives())
         {
@@ -49,6 +49,7 @@ void ControlLimitedFeasibilityDrivenDDPSolver::Instantiate(const ControlLimitedF
     th_gradient_tolerance_ = parameters_.GradientTolerance;
     th_acceptstep_ = parameters_.DescentStepAcceptanceThreshold;
     th_acceptnegstep_ = parameters_.AscentStepAcceptanceThreshold;
+    num_threads_ = parameters_.NumThreads;
 }
 
 void ControlLimitedFeasibilityDrivenDDPSolver::AllocateData()
@@ -63,7 +63,8 @@ PYBIND11_MODULE(exotica_ddp_solver_py, module)
         .def_property_readonly("fu", &AbstractDDPSolver::get_fu)
         .def_property_readonly("control_cost_evolution", &AbstractDDPSolver::get_control_cost_evolution)
         .def_property_readonly("steplength_evolution", &AbstractDDPSolver::get_steplength_evolution)
-        .def_property_readonly("regularization_evolution", &AbstractDDPSolver::get_regularization_evolution);
+        .def_property_readonly("regularization_evolution", &AbstractDDPSolver::get_regularization_evolution)
+        .def("shift_horizon", &AbstractDDPSolver::ShiftHorizon, py::arg("x_measured"));
 
     py::class_<AnalyticDDPSolver, std::shared_ptr<AnalyticDDPSolver>, AbstractDDPSolver> analytic_ddp_solver(module, "AnalyticDDPSolver");
 
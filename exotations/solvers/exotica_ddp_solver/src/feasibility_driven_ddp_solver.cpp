@@ -27,12 +27,39 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
+#include <exotica_core/setup.h>
 #include <exotica_ddp_solver/feasibility_driven_ddp_solver.h>
 
 REGISTER_MOTIONSOLVER_TYPE("FeasibilityDrivenDDPSolver", exotica::FeasibilityDrivenDDPSolver)
 
 namespace exotica
 {
+namespace
+{
+// Calls function(t, worker) for t in [begin, end), split into contiguous blocks over num_workers threads.
+// The calling thread evaluates the first block. Exceptions are rethrown once all workers have finished.
+template <typename Function>
+void ParallelFor(const int begin, const int end, int num_workers, const Function& function)
+{
+    num_workers = std::max(1, std::min(num_workers, end - begin));
+    const int block = (end - begin + num_workers - 1) / num_workers;
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_workers - 1);
+    for (int worker = 1; worker < num_workers; ++worker)
+    {
+        futures.emplace_back(std::async(std::launch::async, [&function, begin, end, block, worker]() {
+            for (int t = begin + worker * block; t < std::min(end, begin + (worker + 1) * block); ++t) function(t, worker);
+        }));
+    }
+    for (int t = begin; t < std::min(end, begin + block); ++t) function(t, 0);
+    for (std::future<void>& future : futures) future.get();
+}
+}  // namespace
+
 void FeasibilityDrivenDDPSolver::Instantiate(const FeasibilityDrivenDDPSolverInitializer& init)
 {
     parameters_ = init;
@@ -47,6 +74,7 @@ void FeasibilityDrivenDDPSolver::Instantiate(const FeasibilityDrivenDDPSolverIni
     th_gradient_tolerance_ = parameters_.GradientTolerance;
     th_acceptstep_ = parameters_.DescentStepAcceptanceThreshold;
     th_acceptnegstep_ = parameters_.AscentStepAcceptanceThreshold;
+    num_threads_ = parameters_.NumThreads;
 }
 
 void AbstractFeasibilityDrivenDDPSolver::AllocateData()
@@ -71,6 +99,7 @@ void AbstractFeasibilityDrivenDDPSolver::AllocateData()
     xs_try_.resize(T + 1);
     us_try_.resize(T);
     dx_.resize(T + 1);
+    xs_next_.assign(T, Eigen::VectorXd::Zero(NX_));
 
     FuTVxx_p_.resize(T);
     Quu_ldlt_.resize(T);
@@ -137,18 +166,59 @@ void AbstractFeasibilityDrivenDDPSolver::SpecifyProblem(PlanningProblemPtr point
     NDX_ = prob_->GetScene()->get_num_state_derivative();  // Tangent vector size
 
     AllocateData();
+    CreateWorkers();
+}
+
+void AbstractFeasibilityDrivenDDPSolver::CreateWorkers()
+{
+    if (num_threads_ < 0) ThrowNamed("NumThreads has to be non-negative, got " << num_threads_);
+    const int num_workers = std::max(1, num_threads_ > 0 ? num_threads_ : static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Dynamics solvers keep the results of their last evaluation, i.e., every thread needs its own instance.
+    worker_dynamics_solvers_.assign(1, dynamics_solver_);
+    for (int i = 1; i < num_workers; ++i)
+    {
+        DynamicsSolverPtr worker = Setup::CreateDynamicsSolver(prob_->GetScene()->GetParameters().DynamicsSolver.at(0));
+        worker->AssignScene(prob_->GetScene());
+        worker_dynamics_solvers_.emplace_back(worker);
+    }
+}
+
+void AbstractFeasibilityDrivenDDPSolver::SimulateShootingIntervals()
+{
+    const double tau = prob_->get_tau();
+    ParallelFor(0, T_ - 1, static_cast<int>(worker_dynamics_solvers_.size()), [this, tau](const int t, const int worker) {
+        xs_next_[t] = worker_dynamics_solvers_[worker]->Simulate(xs_[t], us_[t], tau);
+    });
+}
+
+void AbstractFeasibilityDrivenDDPSolver::ComputeDynamicsDerivatives()
+{
+    ParallelFor(0, T_ - 1, static_cast<int>(worker_dynamics_solvers_.size()), [this](const int t, const int worker) {
+        const DynamicsSolverPtr& dynamics_solver = worker_dynamics_solvers_[worker];
+        dynamics_solver->ComputeDerivatives(xs_[t], us_[t]);
+        fx_[t].noalias() = dynamics_solver->get_Fx();
+        fu_[t].noalias() = dynamics_solver->get_Fu();
+    });
 }
 
 void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("AbstractFeasibilityDrivenDDPSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
-    Timer planning_timer, backward_pass_timer, line_search_timer;
+    Timer planning_timer, backward_pass_timer, line_search_timer, update_timer;
 
     T_ = prob_->get_T();
     if (T_ != last_T_) AllocateData();
+    const bool warm_start = ConsumeWarmStart(T_ - 1);
 
     dt_ = dynamics_solver_->get_dt();
     control_limits_ = dynamics_solver_->get_control_limits();
+    for (std::size_t i = 1; i < worker_dynamics_solvers_.size(); ++i)
+    {
+        worker_dynamics_solvers_[i]->SetDt(dt_);
+        worker_dynamics_solvers_[i]->set_integrator(dynamics_solver_->get_integrator());
+    }
 
     const Eigen::MatrixXd& X_warm = prob_->get_X();
     const Eigen::MatrixXd& U_warm = prob_->get_U();
@@ -168,23 +238,30 @@ void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
     prob_->PreUpdate();
     solution.resize(T_ - 1, NU_);
 
-    // Initial roll-out to get initial cost
+    // Initial roll-out to get initial cost. The shooting intervals start at the warm-start nodes and are simulated in parallel.
+    update_timer.Reset();
+    SimulateShootingIntervals();
     cost_ = 0.0;
     control_cost_ = 0.0;
     for (int t = 0; t < T_ - 1; ++t)
     {
-        prob_->Update(xs_[t], us_[t], t);
+        prob_->Update(xs_[t], us_[t], xs_next_[t], t);
         control_cost_ += dt_ * prob_->GetControlCost(t);
         cost_ += dt_ * prob_->GetStateCost(t);
     }
+    RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
     // Reset shooting nodes so we can warm-start from state trajectory
     prob_->set_X(X_warm);
     cost_ += prob_->GetStateCost(T_ - 1) + control_cost_;
     prob_->SetCostEvolution(0, cost_);
     control_cost_evolution_.at(0) = control_cost_;
 
-    xreg_ = std::max(regmin_, initial_regularization_rate_);
-    ureg_ = std::max(regmin_, initial_regularization_rate_);
+    // A receding-horizon re-solve continues with the regularization of the last solve
+    if (!warm_start)
+    {
+        xreg_ = std::max(regmin_, initial_regularization_rate_);
+        ureg_ = std::max(regmin_, initial_regularization_rate_);
+    }
     was_feasible_ = false;
 
     bool diverged = false;
@@ -205,6 +282,8 @@ void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
             break;
         }
 
+        if (CheckTimeBudget(planning_timer, iter - 1)) break;
+
         backward_pass_timer.Reset();
         while (!ComputeDirection(recalcDiff))
         {
@@ -223,6 +302,7 @@ void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
             }
         }
         time_taken_backward_pass_ = backward_pass_timer.GetDuration();
+        RecordTiming(SolverPhase::BackwardPass, time_taken_backward_pass_);
 
         if (diverged)
         {
@@ -237,6 +317,9 @@ void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
         line_search_timer.Reset();
         for (int ai = 0; ai < alpha_space_.size(); ++ai)
         {
+            // Out of time: keep the current candidate
+            if (ai > 0 && IsTimeBudgetExceeded(planning_timer)) break;
+
             steplength_ = alpha_space_(ai);
             dV_ = TryStep(steplength_);
 
@@ -280,6 +363,7 @@ void AbstractFeasibilityDrivenDDPSolver::Solve(Eigen::MatrixXd& solution)
             control_cost_evolution_.at(iter) = control_cost_;
         }
         time_taken_forward_pass_ = line_search_timer.GetDuration();
+        RecordTiming(SolverPhase::LineSearch, time_taken_forward_pass_);
 
         steplength_evolution_.at(iter) = steplength_;
         regularization_evolution_.at(iter) = xreg_;
@@ -479,6 +563,7 @@ double AbstractFeasibilityDrivenDDPSolver::TryStep(const double steplength)
 
 void AbstractFeasibilityDrivenDDPSolver::ForwardPass(const double steplength)
 {
+    EXOTICA_PROFILE_ZONE("AbstractFeasibilityDrivenDDPSolver::ForwardPass");
     if (steplength > 1. || steplength < 0.)
     {
         ThrowPretty("Invalid argument: invalid step length, value should be between 0. to 1. - got=" << steplength);
@@ -585,6 +670,9 @@ double AbstractFeasibilityDrivenDDPSolver::CalcDiff()
 
 bool AbstractFeasibilityDrivenDDPSolver::BackwardPassFDDP()
 {
+    EXOTICA_PROFILE_ZONE("AbstractFeasibilityDrivenDDPSolver::BackwardPassFDDP");
+    ComputeDynamicsDerivatives();
+
     Vxx_.back() = prob_->GetStateCostHessian(T_ - 1);
     Vx_.back() = prob_->GetStateCostJacobian(T_ - 1);
 
@@ -604,19 +692,15 @@ bool AbstractFeasibilityDrivenDDPSolver::BackwardPassFDDP()
         const Eigen::VectorXd& Vx_p = Vx_[t + 1];
 
         Qxx_[t].noalias() = dt_ * prob_->GetStateCostHessian(t);
-        Qxu_[t].noalias() = dt_ * prob_->GetStateControlCostHessian().transpose();
-        Quu_[t].noalias() = dt_ * prob_->GetControlCostHessian(t);
+        Quu_[t].noalias() = dt_ * GetControlCostHessian(t);
         Qx_[t].noalias() = dt_ * prob_->GetStateCostJacobian(t);
         Qu_[t].noalias() = dt_ * prob_->GetControlCostJacobian(t);
 
-        dynamics_solver_->ComputeDerivatives(xs_[t], us_[t]);
-        fx_[t].noalias() = dynamics_solver_->get_Fx();
-        fu_[t].noalias() = dynamics_solver_->get_Fu();
-
         FxTVxx_p_.noalias() = fx_[t].transpose() * Vxx_p;
         FuTVxx_p_[t].noalias() = fu_[t].transpose() * Vxx_p;
         Qxx_[t].noalias() += FxTVxx_p_ * fx_[t];
-        Qxu_[t].noalias() += FxTVxx_p_ * fu_[t];
+        Qxu_[t].noalias() = FxTVxx_p_ * fu_[t];
+        if (prob_->HasStateControlCostCoupling()) Qxu_[t].noalias() += dt_ * prob_->GetStateControlCostHessian().transpose();
         Quu_[t].noalias() += FuTVxx_p_[t] * fu_[t];
         Qx_[t].noalias() += fx_[t].transpose() * Vx_p;
         Qu_[t].noalias() += fu_[t].transpose() * Vx_p;
@@ -73,9 +73,10 @@ void IKSolver::SpecifyProblem(PlanningProblemPtr pointer)
 
 void IKSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("IKSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
 
-    Timer timer;
+    Timer timer, update_timer, line_search_timer;
 
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
     lambda_ = parameters_.RegularizationRate;
@@ -89,7 +90,11 @@ void IKSolver::Solve(Eigen::MatrixXd& solution)
     int i;
     for (i = 0; i < GetNumberOfMaxIterations(); ++i)
     {
+        if (CheckTimeBudget(timer, i)) break;
+
+        update_timer.Reset();
         prob_->Update(q_);
+        RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
         error_ = prob_->GetScalarCost();
         prob_->SetCostEvolution(i, error_);
         error_prev_ = error_;
@@ -144,8 +149,12 @@ void IKSolver::Solve(Eigen::MatrixXd& solution)
         // Line search
         else
         {
+            line_search_timer.Reset();
             for (int ai = 0; ai < alpha_space_.size(); ++ai)
             {
+                // Out of time: keep the current configuration
+                if (ai > 0 && IsTimeBudgetExceeded(timer)) break;
+
                 steplength_ = alpha_space_(ai);
                 Eigen::VectorXd q_tmp = q_ - steplength_ * qd_;
                 prob_->Update(q_tmp);
@@ -158,6 +167,7 @@ void IKSolver::Solve(Eigen::MatrixXd& solution)
                     break;
                 }
             }
+            RecordTiming(SolverPhase::LineSearch, line_search_timer.GetDuration());
         }
 
         // Step tolerance parameter
@@ -48,6 +48,7 @@ void ILQGSolver::SpecifyProblem(PlanningProblemPtr pointer)
 
 void ILQGSolver::BackwardPass()
 {
+    EXOTICA_PROFILE_ZONE("ILQGSolver::BackwardPass");
     constexpr double min_clamp_ = -1e10;
     constexpr double max_clamp_ = 1e10;
     const int T = prob_->get_T();
@@ -78,10 +79,10 @@ void ILQGSolver::BackwardPass()
         Eigen::MatrixXd Q = dt * prob_->GetStateCostHessian(t);
         Eigen::MatrixXd r = dt * prob_->GetControlCostJacobian(t);
         Eigen::MatrixXd R = dt * prob_->GetControlCostHessian(t);
-        Eigen::MatrixXd P = dt * prob_->GetStateControlCostHessian();
 
         Eigen::MatrixXd g = r + B.transpose() * s;
-        Eigen::MatrixXd G = P + B.transpose() * S * A;
+        Eigen::MatrixXd G = B.transpose() * S * A;
+        if (prob_->HasStateControlCostCoupling()) G += dt * prob_->GetStateControlCostHessian();
         Eigen::MatrixXd H = R + B.transpose() * S * B;
 
         if (parameters_.IncludeNoiseTerms)
@@ -144,6 +145,7 @@ void ILQGSolver::BackwardPass()
 
 double ILQGSolver::ForwardPass(const double alpha, Eigen::MatrixXdRefConst ref_x, Eigen::MatrixXdRefConst ref_u)
 {
+    EXOTICA_PROFILE_ZONE("ILQGSolver::ForwardPass");
     double cost = 0;
     const int T = prob_->get_T();
     const Eigen::MatrixXd control_limits = dynamics_solver_->get_control_limits();
@@ -173,8 +175,9 @@ double ILQGSolver::ForwardPass(const double alpha, Eigen::MatrixXdRefConst ref_x
 
 void ILQGSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("ILQGSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
-    Timer planning_timer, backward_pass_timer, line_search_timer;
+    Timer planning_timer, backward_pass_timer, line_search_timer, update_timer;
     // TODO: This is an interesting approach but might give us incorrect results.
     prob_->DisableStochasticUpdates();
 
@@ -217,9 +220,12 @@ void ILQGSolver::Solve(Eigen::MatrixXd& solution)
             break;
         }
 
+        if (CheckTimeBudget(planning_timer, iteration - 1)) break;
+
         // Backwards pass computes the gains
         backward_pass_timer.Reset();
         BackwardPass();
+        RecordTiming(SolverPhase::BackwardPass, backward_pass_timer.GetDuration());
         if (debug_) HIGHLIGHT_NAMED("ILQGSolver", "Backward pass complete in " << backward_pass_timer.GetDuration());
         // if (debug_) HIGHLIGHT_NAMED("ILQGSolver", "Backward pass complete in " << backward_pass_timer.GetDuration());
 
@@ -236,6 +242,9 @@ void ILQGSolver::Solve(Eigen::MatrixXd& solution)
         // perform a linear search to find the best rate
         for (int ai = 0; ai < alpha_space.rows(); ++ai)
         {
+            // Out of time: keep the best step found so far
+            if (ai > 0 && IsTimeBudgetExceeded(planning_timer)) break;
+
             double alpha = alpha_space(ai);
             double cost = ForwardPass(alpha, ref_x, ref_u);
 
@@ -249,6 +258,8 @@ void ILQGSolver::Solve(Eigen::MatrixXd& solution)
             // break;
         }
 
+        RecordTiming(SolverPhase::LineSearch, line_search_timer.GetDuration());
+
         // finite checks
         if (!new_U.allFinite() || !std::isfinite(current_cost))
         {
@@ -294,8 +305,10 @@ void ILQGSolver::Solve(Eigen::MatrixXd& solution)
         }
 
         last_cost = current_cost;
+        update_timer.Reset();
         for (int t = 0; t < T - 1; ++t)
             prob_->Update(new_U.col(t), t);
+        RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
         prob_->SetCostEvolution(iteration, current_cost);
     }
 
@@ -46,6 +46,7 @@ void ILQRSolver::SpecifyProblem(PlanningProblemPtr pointer)
 
 void ILQRSolver::BackwardPass()
 {
+    EXOTICA_PROFILE_ZONE("ILQRSolver::BackwardPass");
     constexpr double min_clamp_ = -1e10;
     constexpr double max_clamp_ = 1e10;
     const int T = prob_->get_T();
@@ -101,6 +102,7 @@ void ILQRSolver::BackwardPass()
 
 double ILQRSolver::ForwardPass(const double alpha, Eigen::MatrixXdRefConst ref_x, Eigen::MatrixXdRefConst ref_u)
 {
+    EXOTICA_PROFILE_ZONE("ILQRSolver::ForwardPass");
     double cost = 0;
     const int T = prob_->get_T();
     const Eigen::MatrixXd control_limits = dynamics_solver_->get_control_limits();
@@ -129,8 +131,9 @@ double ILQRSolver::ForwardPass(const double alpha, Eigen::MatrixXdRefConst ref_x
 
 void ILQRSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("ILQRSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
-    Timer planning_timer, backward_pass_timer, line_search_timer;
+    Timer planning_timer, backward_pass_timer, line_search_timer, update_timer;
 
     const int T = prob_->get_T();
     const int NU = prob_->GetScene()->get_num_controls();
@@ -139,6 +142,7 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
     prob_->PreUpdate();
 
+    update_timer.Reset();
     double cost = 0;
     for (int t = 0; t < T - 1; ++t)
     {
@@ -146,6 +150,7 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
 
         cost += dt * (prob_->GetControlCost(t) + prob_->GetStateCost(t));
     }
+    RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
 
     // add terminal cost
     cost += prob_->GetStateCost(T - 1);
@@ -184,10 +189,13 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
             break;
         }
 
+        if (CheckTimeBudget(planning_timer, iteration - 1)) break;
+
         // Backwards pass computes the gains
         backward_pass_timer.Reset();
         BackwardPass();
         time_taken_backward_pass = backward_pass_timer.GetDuration();
+        RecordTiming(SolverPhase::BackwardPass, time_taken_backward_pass);
 
         // Forward pass to compute new control trajectory
         line_search_timer.Reset();
@@ -200,6 +208,9 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
         double best_alpha = 0;
         for (int ai = 0; ai < alpha_space.size(); ++ai)
         {
+            // Out of time: keep the last accepted controls
+            if (ai > 0 && IsTimeBudgetExceeded(planning_timer)) break;
+
             const double& alpha = alpha_space(ai);
             double rollout_cost = ForwardPass(alpha, ref_x, ref_u);
 
@@ -221,6 +232,7 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
         }
 
         time_taken_forward_pass = line_search_timer.GetDuration();
+        RecordTiming(SolverPhase::LineSearch, time_taken_forward_pass);
 
         if (debug_)
         {
@@ -288,8 +300,10 @@ void ILQRSolver::Solve(Eigen::MatrixXd& solution)
         }
 
         // Roll-out
+        update_timer.Reset();
         for (int t = 0; t < T - 1; ++t)
             prob_->Update(new_U.col(t), t);
+        RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
 
         // Set cost evolution
         prob_->SetCostEvolution(iteration, cost);
@@ -70,10 +70,11 @@ void LevenbergMarquardtSolver::SpecifyProblem(PlanningProblemPtr pointer)
 
 void LevenbergMarquardtSolver::Solve(Eigen::MatrixXd& solution)
 {
+    EXOTICA_PROFILE_ZONE("LevenbergMarquardtSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
 
     prob_->ResetCostEvolution(GetNumberOfMaxIterations() + 1);
-    Timer timer;
+    Timer timer, update_timer;
 
     q_ = prob_->ApplyStartState();
     if (prob_->N != q_.rows()) ThrowNamed("Wrong size q0 size=" << q_.rows() << ", required size=" << prob_->N);
@@ -83,7 +84,11 @@ void LevenbergMarquardtSolver::Solve(Eigen::MatrixXd& solution)
     lambda_ = parameters_.Damping;  // Reset initial damping
     for (int i = 0; i < GetNumberOfMaxIterations(); ++i)
     {
+        if (CheckTimeBudget(timer, i)) break;
+
+        update_timer.Reset();
         prob_->Update(q_);
+        RecordTiming(SolverPhase::ProblemUpdate, update_timer.GetDuration());
 
         yd_.noalias() = prob_->cost.S * prob_->cost.ydiff;
 
@@ -65,9 +65,12 @@ public:
         double t = 0;
         space_->copyState(result, state);
 
+        // Simulate directly in the memory of the OMPL state and control
+        Eigen::Map<Eigen::VectorXd> x(result->as<ob::RealVectorStateSpace::StateType>()->values, dynamics_solver_->get_num_state());
+        const Eigen::Map<const Eigen::VectorXd> u(control->as<oc::RealVectorControlSpace::ControlType>()->values, dynamics_solver_->get_num_controls());
         while (t < duration)
         {
-            Integrate(result, control, timeStep_);
+            dynamics_solver_->SimulateInPlace(x, u, timeStep_);
             t += timeStep_;
         }
     }
@@ -86,21 +89,6 @@ private:
     double timeStep_ = 0.0;
     oc::SpaceInformationPtr space_;
     DynamicsSolverPtr dynamics_solver_;
-
-    void Integrate(ob::State *ob_x, const oc::Control *oc_u, double dt) const
-    {
-        const int NU = dynamics_solver_->get_num_controls();
-        const int NX = dynamics_solver_->get_num_positions() + dynamics_solver_->get_num_velocities();
-
-        double *x = ob_x->as<ob::RealVectorStateSpace::StateType>()->values;
-        double *u = oc_u->as<oc::RealVectorControlSpace::ControlType>()->values;
-
-        Eigen::VectorXd eig_x = Eigen::Map<Eigen::VectorXd>(x, NX);
-        Eigen::VectorXd eig_u = Eigen::Map<Eigen::VectorXd>(u, NU);
-
-        Eigen::VectorXd x_new = dynamics_solver_->Simulate(eig_x, eig_u, dt);
-        std::memcpy(x, x_new.data(), NX * sizeof(double));
-    }
 };
 
 class OMPLControlSolver : public MotionSolver
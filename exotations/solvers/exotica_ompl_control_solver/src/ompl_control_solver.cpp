@@ -124,6 +124,7 @@ void OMPLControlSolver::Setup()
 
 void OMPLControlSolver::Solve(Eigen::MatrixXd &solution)
 {
+    EXOTICA_PROFILE_ZONE("OMPLControlSolver::Solve");
     if (!prob_) ThrowNamed("Solver has not been initialized!");
     Timer planning_timer, backward_pass_timer, line_search_timer;
 
@@ -135,7 +136,7 @@ void OMPLControlSolver::Solve(Eigen::MatrixXd &solution)
     const double dt = dynamics_solver_->get_dt();
 
     Setup();
-    ob::PlannerStatus solved = setup_->solve(init_.MaxIterationTime);
+    ob::PlannerStatus solved = setup_->solve(CapTimeout(init_.MaxIterationTime));
 
     if (solved)
     {
@@ -31,7 +31,9 @@
 #define EXOTICA_OMPL_SOLVER_OMPL_EXO_H_
 
 #include <exotica_core/problems/sampling_problem.h>
+#include <exotica_core/tools/continuous_motion_validator.h>
 
+#include <ompl/base/MotionValidator.h>
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/base/StateSpace.h>
 #include <ompl/base/StateValidityChecker.h>
@@ -85,6 +85,14 @@ public:
     int MilestoneCount();
     bool IsMultiQuery() const;
     void SetMultiQuery(bool val);
+    /// \brief Saves the roadmap together with the robot and world it was computed for.
+    void SaveRoadmap(const std::string& file_name);
+    /// \brief Loads a roadmap saved with SaveRoadmap and enables multi-query planning.
+    /// If the world has changed since, the roadmap is discarded before the next query since PRM does not revalidate edges.
+    void LoadRoadmap(const std::string& file_name);
+
+protected:
+    void ClearRoadmapQuery() override;
 };
 
 class LazyPRMSolver : public OMPLSolver<SamplingProblem>, Instantiable<LazyPRMSolverInitializer>
@@ -99,6 +107,15 @@ public:
     int MilestoneCount();
     bool IsMultiQuery() const;
     void SetMultiQuery(bool val);
+    /// \brief Saves the roadmap together with the robot and world it was computed for.
+    void SaveRoadmap(const std::string& file_name);
+    /// \brief Loads a roadmap saved with SaveRoadmap and enables multi-query planning.
+    /// Loaded vertices and edges are revalidated lazily when used by a query.
+    void LoadRoadmap(const std::string& file_name);
+
+protected:
+    void InvalidateRoadmap() override;
+    void ClearRoadmapQuery() override;
 };
 
 class RRTStarSolver : public OMPLSolver<SamplingProblem>, Instantiable<RRTStarSolverInitializer>
@@ -75,6 +75,20 @@ protected:
     }
 
     void SetGoalState(Eigen::VectorXdRefConst qT, const double eps = 0);
+    void SetupStateSpace();
+
+    /// \brief Invalidates a roadmap kept across queries after the world has changed. Discards the roadmap by default.
+    virtual void InvalidateRoadmap();
+    /// \brief Removes the start and goal states of the previous query from a roadmap kept across queries.
+    virtual void ClearRoadmapQuery() {}
+    /// \brief Stores the planner data together with the robot and world keys it was computed for.
+    void StoreRoadmap(const std::string &file_name);
+    /// \brief Loads planner data stored with StoreRoadmap.
+    /// @param[out] data Loaded planner data.
+    /// @return Whether the roadmap was computed for the current world. Throws if it was computed for a different robot.
+    bool LoadRoadmapData(const std::string &file_name, ompl::base::PlannerData &data);
+    std::string GetRobotKey() const;
+
     void PreSolve();
     void PostSolve();
     void GetPath(Eigen::MatrixXd &traj, ompl::base::PlannerTerminationCondition &ptc);
@@ -85,7 +99,9 @@ protected:
     ConfiguredPlannerAllocator planner_allocator_;
     std::string algorithm_;
     bool multi_query_ = false;
+    std::size_t roadmap_world_hash_ = 0;  //!< World the kept roadmap was validated against, 0 if unknown
     std::vector<double> bounds_;  // original bounds for locked state space
+    ContinuousMotionCheckerPtr continuous_motion_checker_;  // only set for continuous motion validation
 };
 }  // namespace exotica
 
@@ -191,6 +191,26 @@ void PRMSolver::SetMultiQuery(bool val)
     multi_query_ = val;
 }
 
+void PRMSolver::SaveRoadmap(const std::string &file_name)
+{
+    StoreRoadmap(file_name);
+}
+
+void PRMSolver::LoadRoadmap(const std::string &file_name)
+{
+    ompl::base::PlannerData data(ompl_simple_setup_->getSpaceInformation());
+    if (!LoadRoadmapData(file_name, data)) WARNING_NAMED(algorithm_, "Roadmap " << file_name << " was computed for a different world and will be discarded.");
+    ompl_ptr<ompl::geometric::PRM> prm = std::make_shared<ompl::geometric::PRM>(data);
+    prm->setName(algorithm_);
+    ompl_simple_setup_->setPlanner(prm);
+    multi_query_ = true;
+}
+
+void PRMSolver::ClearRoadmapQuery()
+{
+    ClearQuery();
+}
+
 LazyPRMSolver::LazyPRMSolver() = default;
 
 void LazyPRMSolver::Instantiate(const LazyPRMSolverInitializer &init)
@@ -240,4 +260,31 @@ void LazyPRMSolver::SetMultiQuery(bool val)
 {
     multi_query_ = val;
 }
+
+void LazyPRMSolver::SaveRoadmap(const std::string &file_name)
+{
+    StoreRoadmap(file_name);
+}
+
+void LazyPRMSolver::LoadRoadmap(const std::string &file_name)
+{
+    ompl::base::PlannerData data(ompl_simple_setup_->getSpaceInformation());
+    LoadRoadmapData(file_name, data);
+    ompl_ptr<ompl::geometric::LazyPRM> prm = std::make_shared<ompl::geometric::LazyPRM>(data);
+    prm->setName(algorithm_);
+    ompl_simple_setup_->setPlanner(prm);
+    multi_query_ = true;
+}
+
+void LazyPRMSolver::InvalidateRoadmap()
+{
+    // Keep the graph, vertices and edges are checked again when a query uses them
+    ompl_ptr<ompl::geometric::LazyPRM> prm = ompl_cast<ompl::geometric::LazyPRM>(ompl_simple_setup_->getPlanner());
+    prm->clearValidity();
+}
+
+void LazyPRMSolver::ClearRoadmapQuery()
+{
+    ClearQuery();
+}
 }  // namespace exotica
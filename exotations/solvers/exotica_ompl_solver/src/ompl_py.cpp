@@ -71,6 +71,8 @@ PYBIND11_MODULE(exotica_ompl_solver_py, module)
     prm.def("setup", &PRMSolver::Setup);
     prm.def("edge_count", &PRMSolver::EdgeCount);
     prm.def("milestone_count", &PRMSolver::MilestoneCount);
+    prm.def("save_roadmap", &PRMSolver::SaveRoadmap);
+    prm.def("load_roadmap", &PRMSolver::LoadRoadmap);
 
     py::class_<LazyPRMSolver, std::shared_ptr<LazyPRMSolver>, OMPLSolver<SamplingProblem>> lprm(module, "LazyPRMSolver");
     lprm.def_property("multi_query", &LazyPRMSolver::IsMultiQuery, &LazyPRMSolver::SetMultiQuery);
@@ -79,4 +81,6 @@ PYBIND11_MODULE(exotica_ompl_solver_py, module)
     lprm.def("setup", &LazyPRMSolver::Setup);
     lprm.def("edge_count", &LazyPRMSolver::EdgeCount);
     lprm.def("milestone_count", &LazyPRMSolver::MilestoneCount);
+    lprm.def("save_roadmap", &LazyPRMSolver::SaveRoadmap);
+    lprm.def("load_roadmap", &LazyPRMSolver::LoadRoadmap);
 }
@@ -29,6 +29,9 @@
 
 #include <exotica_ompl_solver/ompl_solver.h>
 
+#include <fstream>
+
+#include <ompl/base/PlannerDataStorage.h>
 #include <ompl/util/Console.h>
 #include <ompl/util/RandomNumbers.h>
 
@@ -62,6 +65,20 @@ void OMPLSolver<ProblemType>::SpecifyProblem(PlanningProblemPtr pointer)
     ompl_simple_setup_->setStateValidityChecker(ompl::base::StateValidityCheckerPtr(new OMPLStateValidityChecker(ompl_simple_setup_->getSpaceInformation(), prob_)));
     ompl_simple_setup_->setPlannerAllocator(boost::bind(planner_allocator_, _1, algorithm_));
 
+    continuous_motion_checker_.reset();
+    if (init_.ContinuousMotionValidation)
+    {
+        // Motions are checked along straight lines in the exotica state, which is only how RN state spaces interpolate
+        if (prob_->GetScene()->GetKinematicTree().GetControlledBaseType() == BaseType::FLOATING || init_.IsDubinsStateSpace)
+            ThrowNamed("Continuous motion validation requires a fixed or planar base without Dubins state space.");
+        continuous_motion_checker_ = std::make_shared<ContinuousMotionChecker>(prob_->GetScene(), init_.ContinuousMotionValidationSelfCollision, init_.ContinuousMotionValidationTolerance);
+        const std::shared_ptr<OMPLStateSpace> state_space = std::static_pointer_cast<OMPLStateSpace>(state_space_);
+        ompl_simple_setup_->getSpaceInformation()->setMotionValidator(std::make_shared<OMPLContinuousMotionValidator>(ompl_simple_setup_->getSpaceInformation(), continuous_motion_checker_, [state_space](const ompl::base::State *state, Eigen::VectorXd &q, double &t) {
+            state_space->OMPLToExoticaState(state, q);
+            t = 0.0;
+        }));
+    }
+
     if (init_.Projection.rows() > 0)
     {
         std::vector<int> project_vars(init_.Projection.rows());
@@ -97,9 +114,75 @@ void OMPLSolver<ProblemType>::PreSolve()
             planner->clear();
         ompl_simple_setup_->getPlanner()->setProblemDefinition(ompl_simple_setup_->getProblemDefinition());
     }
+    else
+    {
+        // Keep the roadmap, but only as long as it was built for the current world
+        ompl_simple_setup_->getProblemDefinition()->clearSolutionPaths();
+        ClearRoadmapQuery();
+        const std::size_t world_hash = prob_->GetScene()->GetWorldHash();
+        if (roadmap_world_hash_ != 0 && roadmap_world_hash_ != world_hash)
+        {
+            if (debug_) HIGHLIGHT_NAMED(algorithm_, "World has changed, invalidating roadmap");
+            InvalidateRoadmap();
+        }
+        roadmap_world_hash_ = world_hash;
+    }
+    // Objects may have been attached to the robot since the last query
+    if (continuous_motion_checker_) continuous_motion_checker_->UpdateLeverArms();
     ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->resetMotionCounter();
 }
 
+template <class ProblemType>
+void OMPLSolver<ProblemType>::InvalidateRoadmap()
+{
+    const ompl::base::PlannerPtr planner = ompl_simple_setup_->getPlanner();
+    if (planner) planner->clear();
+}
+
+template <class ProblemType>
+std::string OMPLSolver<ProblemType>::GetRobotKey() const
+{
+    std::string key = prob_->GetScene()->GetKinematicTree().GetRobotModel()->getName();
+    for (const std::string &joint : prob_->GetScene()->GetControlledJointNames()) key += " " + joint;
+    return key;
+}
+
+template <class ProblemType>
+void OMPLSolver<ProblemType>::StoreRoadmap(const std::string &file_name)
+{
+    if (!ompl_simple_setup_ || !ompl_simple_setup_->getPlanner()) ThrowNamed("No roadmap to store, solve the problem first.");
+
+    ompl::base::PlannerData data(ompl_simple_setup_->getSpaceInformation());
+    ompl_simple_setup_->getPlanner()->getPlannerData(data);
+    ompl::base::PlannerDataStorage().store(data, file_name.c_str());
+
+    std::ofstream key_file(file_name + ".key");
+    if (!key_file) ThrowNamed("Cannot write roadmap key file " << file_name << ".key");
+    key_file << GetRobotKey() << '\n'
+             << prob_->GetScene()->GetWorldHash() << '\n';
+}
+
+template <class ProblemType>
+bool OMPLSolver<ProblemType>::LoadRoadmapData(const std::string &file_name, ompl::base::PlannerData &data)
+{
+    if (!ompl_simple_setup_) ThrowNamed("Problem has not been specified.");
+
+    std::ifstream key_file(file_name + ".key");
+    std::string robot_key;
+    std::size_t world_hash = 0;
+    if (!key_file || !std::getline(key_file, robot_key) || !(key_file >> world_hash)) ThrowNamed("Cannot read roadmap key file " << file_name << ".key");
+    if (robot_key != GetRobotKey()) ThrowNamed("Roadmap " << file_name << " was computed for a different robot: " << robot_key);
+
+    // The state space has to be set up to deserialise the states
+    SetupStateSpace();
+    ompl::base::PlannerDataStorage().load(file_name.c_str(), data);
+    if (data.numVertices() == 0) ThrowNamed("Roadmap " << file_name << " is empty or could not be loaded.");
+
+    // The roadmap is now valid for the world it was stored with; the next query revalidates it if that differs.
+    roadmap_world_hash_ = world_hash;
+    return world_hash == prob_->GetScene()->GetWorldHash();
+}
+
 template <class ProblemType>
 void OMPLSolver<ProblemType>::PostSolve()
 {
@@ -191,9 +274,26 @@ void OMPLSolver<ProblemType>::GetPath(Eigen::MatrixXd &traj, ompl::base::Planner
     }
 }
 
+template <class ProblemType>
+void OMPLSolver<ProblemType>::SetupStateSpace()
+{
+    if (!state_space_->as<OMPLStateSpace>()->isLocked())
+    {
+        state_space_->as<OMPLStateSpace>()->SetBounds(prob_);
+        bounds_ = prob_->GetBounds();
+    }
+    else if (!bounds_.empty() && bounds_ != prob_->GetBounds())
+    {
+        ThrowPretty("Cannot set new bounds on locked state space!");
+    }
+
+    ompl_simple_setup_->getSpaceInformation()->setup();
+}
+
 template <class ProblemType>
 void OMPLSolver<ProblemType>::Solve(Eigen::MatrixXd &solution)
 {
+    EXOTICA_PROFILE_ZONE("OMPLSolver::Solve");
     // Set log level
     ompl::msg::setLogLevel(debug_ ? ompl::msg::LogLevel::LOG_DEBUG : ompl::msg::LogLevel::LOG_WARN);
 
@@ -215,17 +315,7 @@ void OMPLSolver<ProblemType>::Solve(Eigen::MatrixXd &solution)
         }
     }
 
-    if (!state_space_->as<OMPLStateSpace>()->isLocked())
-    {
-        state_space_->as<OMPLStateSpace>()->SetBounds(prob_);
-        bounds_ = prob_->GetBounds();
-    }
-    else if (!bounds_.empty() && bounds_ != prob_->GetBounds())
-    {
-        ThrowPretty("Cannot set new bounds on locked state space!");
-    }
-
-    ompl_simple_setup_->getSpaceInformation()->setup();
+    SetupStateSpace();
 
     ompl_simple_setup_->setup();
 
@@ -249,7 +339,7 @@ void OMPLSolver<ProblemType>::Solve(Eigen::MatrixXd &solution)
 
     PreSolve();
     ompl::time::point start = ompl::time::now();
-    ompl::base::PlannerTerminationCondition ptc = ompl::base::timedPlannerTerminationCondition(init_.Timeout - ompl::time::seconds(ompl::time::now() - start));
+    ompl::base::PlannerTerminationCondition ptc = ompl::base::timedPlannerTerminationCondition(CapTimeout(init_.Timeout) - ompl::time::seconds(ompl::time::now() - start));
 
     Timer t;
     if (ompl_simple_setup_->solve(ptc) == ompl::base::PlannerStatus::EXACT_SOLUTION && ompl_simple_setup_->haveSolutionPath())
@@ -30,11 +30,15 @@
 #ifndef TIME_INDEXED_RRT_CONNECT_SOLVER_TIME_INDEXED_RRT_CONNECT_H_
 #define TIME_INDEXED_RRT_CONNECT_SOLVER_TIME_INDEXED_RRT_CONNECT_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include <exotica_core/motion_solver.h>
 #include <exotica_core/problems/time_indexed_sampling_problem.h>
+#include <exotica_core/tools/continuous_motion_validator.h>
 
+#include <ompl/base/MotionValidator.h>
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/base/StateSpace.h>
 #include <ompl/base/StateValidityChecker.h>
@@ -97,8 +101,24 @@ public:
 
     bool isValid(const ompl::base::State *state, double &dist) const override;
 
+    /// \brief Caches up to size validity results in a direct-mapped table keyed by the state quantized to resolution.
+    /// States closer than the resolution share their result. A size of 0 disables the cache.
+    void SetCache(int size, double resolution);
+    /// \brief Discards all cached results and resets the statistics, e.g. when the problem has changed.
+    void ClearCache();
+    std::size_t GetCacheHits() const { return cache_hits_; }
+    std::size_t GetCacheMisses() const { return cache_misses_; }
+
 protected:
     TimeIndexedSamplingProblemPtr prob_;
+
+    std::size_t cache_size_ = 0;
+    double cache_resolution_ = 1e-6;
+    mutable std::vector<int64_t> cache_keys_;  ///< Quantized (q, t) of each slot
+    mutable std::vector<int8_t> cache_results_;  ///< -1 empty, 0 invalid, 1 valid
+    mutable std::vector<int64_t> key_;
+    mutable std::size_t cache_hits_ = 0;
+    mutable std::size_t cache_misses_ = 0;
 };
 
 typedef boost::function<ompl::base::PlannerPtr(const ompl::base::SpaceInformationPtr &si, const std::string &name)> ConfiguredPlannerAllocator;
@@ -111,6 +131,11 @@ public:
     void SpecifyProblem(PlanningProblemPtr pointer) override;
     void SetPlannerTerminationCondition(const std::shared_ptr<ompl::base::PlannerTerminationCondition> &ptc);
 
+    /// \brief Number of state validity checks of the last Solve answered by the validity cache.
+    std::size_t GetValidityCacheHits() const;
+    /// \brief Number of state validity checks of the last Solve that had to be evaluated.
+    std::size_t GetValidityCacheMisses() const;
+
 protected:
     template <typename T>
     static ompl::base::PlannerPtr allocatePlanner(const ompl::base::SpaceInformationPtr &si, const std::string &new_name)
@@ -131,6 +156,8 @@ protected:
     ConfiguredPlannerAllocator planner_allocator_;
     std::string algorithm_;
     std::shared_ptr<ompl::base::PlannerTerminationCondition> ptc_;
+    ContinuousMotionCheckerPtr continuous_motion_checker_;
+    std::shared_ptr<OMPLTimeIndexedStateValidityChecker> validity_checker_;
 };
 
 using namespace ompl;
@@ -162,6 +189,18 @@ public:
         return maxDistance_;
     }
 
+    /// \brief In lazy mode only the states are checked while growing the trees. The motions along a
+    /// candidate connection are checked once the trees meet and invalid subtrees are pruned.
+    void setLazy(bool lazy)
+    {
+        lazy_ = lazy;
+    }
+
+    bool isLazy() const
+    {
+        return lazy_;
+    }
+
     /// \brief Set a different nearest neighbors datastructure
     template <template <typename T> class NN>
     void setNearestNeighbors()
@@ -188,6 +227,10 @@ protected:
         const base::State *root = nullptr;
         base::State *state = nullptr;
         Motion *parent = nullptr;
+        /// \brief Whether the motion from the parent has been checked
+        bool valid = false;
+        /// \brief Motions that have this motion as parent, used to prune subtrees
+        std::vector<Motion *> children;
     };
 
     /// \brief A nearest-neighbor datastructure representing a tree of motions
@@ -279,6 +322,16 @@ protected:
     /// \brief Grow a tree towards a random state
     GrowState growTree(TreeData &tree, TreeGrowingInfo &tgi, Motion *rmotion);
 
+    /// \brief Adds a motion from parent to a copy of state to a tree. In lazy mode the motion is checked later, see checkPathToRoot.
+    Motion *addMotion(TreeData &tree, Motion *parent, const base::State *state);
+
+    /// \brief Checks the unchecked motions between a motion and the root of its tree (lazy mode).
+    /// Prunes the subtree below the first invalid motion.
+    bool checkPathToRoot(TreeData &tree, Motion *motion, bool start);
+
+    /// \brief Removes a motion and all of its descendants from a tree
+    void removeSubtree(TreeData &tree, Motion *motion);
+
     /// \brief State sampler
     base::StateSamplerPtr sampler_;
 
@@ -298,6 +351,8 @@ protected:
     std::pair<base::State *, base::State *> connectionPoint_;
 
     bool reverse_check_;
+
+    bool lazy_ = false;
 };
 }  // namespace exotica
 
@@ -27,6 +27,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <cmath>
+
 #include <exotica_time_indexed_rrt_connect_solver/time_indexed_rrt_connect.h>
 #include <ompl/geometric/planners/rrt/RRTConnect.h>
 #include <ompl/util/RandomNumbers.h>
@@ -89,7 +92,34 @@ bool OMPLTimeIndexedStateValidityChecker::isValid(const ompl::base::State *state
     double t;
     std::static_pointer_cast<OMPLTimeIndexedRNStateSpace>(si_->getStateSpace())->OMPLToExoticaState(state, q, t);
 
-    if (!prob_->IsValid(q, t))
+    std::size_t slot = 0;
+    if (cache_size_ > 0)
+    {
+        // FNV-1a over the quantized state selects the slot, the stored key resolves collisions
+        std::size_t hash = 14695981039346656037ULL;
+        for (int i = 0; i <= prob_->N; ++i)
+        {
+            key_[i] = std::llround((i < prob_->N ? q(i) : t) / cache_resolution_);
+            hash = (hash ^ static_cast<std::size_t>(key_[i])) * 1099511628211ULL;
+        }
+        slot = hash % cache_size_;
+        if (cache_results_[slot] >= 0 && std::equal(key_.begin(), key_.end(), cache_keys_.begin() + slot * key_.size()))
+        {
+            ++cache_hits_;
+            dist = cache_results_[slot] ? 0.0 : -1.0;
+            return cache_results_[slot];
+        }
+        ++cache_misses_;
+    }
+
+    const bool valid = prob_->IsValid(q, t);
+    if (cache_size_ > 0)
+    {
+        std::copy(key_.begin(), key_.end(), cache_keys_.begin() + slot * key_.size());
+        cache_results_[slot] = valid;
+    }
+
+    if (!valid)
     {
         dist = -1;
         return false;
@@ -97,6 +127,25 @@ bool OMPLTimeIndexedStateValidityChecker::isValid(const ompl::base::State *state
     return true;
 }
 
+void OMPLTimeIndexedStateValidityChecker::SetCache(int size, double resolution)
+{
+    if (size < 0) ThrowPretty("Cache size has to be non-negative, got " << size);
+    if (resolution <= 0.0) ThrowPretty("Cache resolution has to be positive, got " << resolution);
+    cache_size_ = size;
+    cache_resolution_ = resolution;
+    key_.resize(prob_->N + 1);
+    cache_keys_.resize(cache_size_ * key_.size());
+    cache_results_.resize(cache_size_);
+    ClearCache();
+}
+
+void OMPLTimeIndexedStateValidityChecker::ClearCache()
+{
+    std::fill(cache_results_.begin(), cache_results_.end(), -1);
+    cache_hits_ = 0;
+    cache_misses_ = 0;
+}
+
 // The solver
 void TimeIndexedRRTConnectSolver::Instantiate(const TimeIndexedRRTConnectSolverInitializer &init)
 {
@@ -118,13 +167,23 @@ void TimeIndexedRRTConnectSolver::SpecifyProblem(PlanningProblemPtr pointer)
     prob_ = std::static_pointer_cast<TimeIndexedSamplingProblem>(pointer);
     state_space_.reset(new OMPLTimeIndexedRNStateSpace(prob_, this->parameters_));
     ompl_simple_setup_.reset(new ompl::geometric::SimpleSetup(state_space_));
-    ompl_simple_setup_->setStateValidityChecker(ompl::base::StateValidityCheckerPtr(new OMPLTimeIndexedStateValidityChecker(ompl_simple_setup_->getSpaceInformation(), prob_)));
+    validity_checker_ = std::make_shared<OMPLTimeIndexedStateValidityChecker>(ompl_simple_setup_->getSpaceInformation(), prob_);
+    validity_checker_->SetCache(this->parameters_.ValidityCacheSize, this->parameters_.ValidityCacheResolution);
+    ompl_simple_setup_->setStateValidityChecker(validity_checker_);
     ompl_simple_setup_->setPlannerAllocator(boost::bind(planner_allocator_, _1, "Exotica_" + algorithm_));
     ompl_simple_setup_->getSpaceInformation()->setStateValidityCheckingResolution(this->parameters_.ValidityCheckResolution);
+    continuous_motion_checker_.reset();
+    if (this->parameters_.ContinuousMotionValidation)
+    {
+        continuous_motion_checker_ = std::make_shared<ContinuousMotionChecker>(prob_->GetScene(), this->parameters_.ContinuousMotionValidationSelfCollision, this->parameters_.ContinuousMotionValidationTolerance, this->parameters_.MaxObstacleSpeed);
+        const std::shared_ptr<OMPLTimeIndexedRNStateSpace> state_space = std::static_pointer_cast<OMPLTimeIndexedRNStateSpace>(state_space_);
+        ompl_simple_setup_->getSpaceInformation()->setMotionValidator(std::make_shared<OMPLContinuousMotionValidator>(ompl_simple_setup_->getSpaceInformation(), continuous_motion_checker_, [state_space](const ompl::base::State *state, Eigen::VectorXd &q, double &t) { state_space->OMPLToExoticaState(state, q, t); }));
+    }
 
     ompl_simple_setup_->getSpaceInformation()->setup();
     ompl_simple_setup_->setup();
     if (ompl_simple_setup_->getPlanner()->params().hasParam("Range")) ompl_simple_setup_->getPlanner()->params().setParam("Range", this->parameters_.Range);
+    std::static_pointer_cast<OMPLTimeIndexedRRTConnect>(ompl_simple_setup_->getPlanner())->setLazy(this->parameters_.LazyCollisionChecking);
 }
 
 void TimeIndexedRRTConnectSolver::PreSolve()
@@ -133,6 +192,8 @@ void TimeIndexedRRTConnectSolver::PreSolve()
     ompl_simple_setup_->getProblemDefinition()->clearSolutionPaths();
     const ompl::base::PlannerPtr planner = ompl_simple_setup_->getPlanner();
     if (planner) planner->clear();
+    // Objects may have been attached to the robot since the last query
+    if (continuous_motion_checker_) continuous_motion_checker_->UpdateLeverArms();
     ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->resetMotionCounter();
     ompl_simple_setup_->getPlanner()->setProblemDefinition(ompl_simple_setup_->getProblemDefinition());
 }
@@ -143,6 +204,7 @@ void TimeIndexedRRTConnectSolver::PostSolve()
     int v = ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->getValidMotionCount();
     int iv = ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->getInvalidMotionCount();
     CONSOLE_BRIDGE_logDebug("There were %d valid motions and %d invalid motions.", v, iv);
+    if (this->parameters_.ValidityCacheSize > 0) CONSOLE_BRIDGE_logDebug("The validity cache answered %zu of %zu state checks.", validity_checker_->GetCacheHits(), validity_checker_->GetCacheHits() + validity_checker_->GetCacheMisses());
 
     if (ompl_simple_setup_->getProblemDefinition()->hasApproximateSolution())
         CONSOLE_BRIDGE_logWarn("Computed solution is approximate");
@@ -235,8 +297,12 @@ void TimeIndexedRRTConnectSolver::GetPath(Eigen::MatrixXd &traj, ompl::base::Pla
 
 void TimeIndexedRRTConnectSolver::Solve(Eigen::MatrixXd &solution)
 {
+    EXOTICA_PROFILE_ZONE("TimeIndexedRRTConnectSolver::Solve");
     Timer timer;
 
+    // Validity results of previous queries may be outdated
+    validity_checker_->ClearCache();
+
     // Reset bounds on time space
     ompl::base::TimeStateSpace *time_space = ompl_simple_setup_->getStateSpace()->as<ompl::base::CompoundStateSpace>()->getSubspace(1)->as<ompl::base::TimeStateSpace>();
     time_space->setBounds(prob_->GetStartTime(), prob_->GetGoalTime());
@@ -252,11 +318,11 @@ void TimeIndexedRRTConnectSolver::Solve(Eigen::MatrixXd &solution)
 
     PreSolve();
     ompl::time::point start = ompl::time::now();
-    if (!ptc_)
-        ptc_.reset(new ompl::base::PlannerTerminationCondition(ompl::base::timedPlannerTerminationCondition(this->parameters_.Timeout - ompl::time::seconds(ompl::time::now() - start))));
-    if (ompl_simple_setup_->solve(*ptc_) == ompl::base::PlannerStatus::EXACT_SOLUTION && ompl_simple_setup_->haveSolutionPath())
+    // A condition set with SetPlannerTerminationCondition takes precedence, otherwise the deadline starts with this query
+    ompl::base::PlannerTerminationCondition ptc = ptc_ ? *ptc_ : ompl::base::timedPlannerTerminationCondition(CapTimeout(this->parameters_.Timeout) - ompl::time::seconds(ompl::time::now() - start));
+    if (ompl_simple_setup_->solve(ptc) == ompl::base::PlannerStatus::EXACT_SOLUTION && ompl_simple_setup_->haveSolutionPath())
     {
-        GetPath(solution, *ptc_);
+        GetPath(solution, ptc);
     }
     PostSolve();
 
@@ -268,6 +334,16 @@ void TimeIndexedRRTConnectSolver::SetPlannerTerminationCondition(const std::shar
     ptc_ = ptc;
 }
 
+std::size_t TimeIndexedRRTConnectSolver::GetValidityCacheHits() const
+{
+    return validity_checker_ ? validity_checker_->GetCacheHits() : 0;
+}
+
+std::size_t TimeIndexedRRTConnectSolver::GetValidityCacheMisses() const
+{
+    return validity_checker_ ? validity_checker_->GetCacheMisses() : 0;
+}
+
 OMPLTimeIndexedRRTConnect::OMPLTimeIndexedRRTConnect(const base::SpaceInformationPtr &si) : base::Planner(si, "OMPLTimeIndexedRRTConnect")
 {
     specs_.recognizedGoal = base::GOAL_SAMPLEABLE_REGION;
@@ -354,18 +430,17 @@ OMPLTimeIndexedRRTConnect::GrowState OMPLTimeIndexedRRTConnect::growTree(TreeDat
     // if we are in the start tree, we just check the motion like we normally do;
     // if we are in the goal tree, we need to check the motion in reverse, but checkMotion() assumes the first state it receives as argument is valid,
     // so we check that one first
-    bool validMotion = tgi.start ? si_->checkMotion(nmotion->state, dstate) : si_->getStateValidityChecker()->isValid(dstate) && si_->checkMotion(dstate, nmotion->state);
+    // in lazy mode, the motion is only checked once the trees connect
+    bool validMotion;
+    if (lazy_)
+        validMotion = si_->getStateValidityChecker()->isValid(dstate);
+    else
+        validMotion = tgi.start ? si_->checkMotion(nmotion->state, dstate) : si_->getStateValidityChecker()->isValid(dstate) && si_->checkMotion(dstate, nmotion->state);
 
     if (validMotion)
     {
         // create a motion
-        Motion *motion = new Motion(si_);
-        si_->copyState(motion->state, dstate);
-        motion->parent = nmotion;
-        motion->root = nmotion->root;
-        tgi.xmotion = motion;
-
-        tree->add(motion);
+        tgi.xmotion = addMotion(tree, nmotion, dstate);
         if (reach)
         {
             return REACHED;
@@ -379,6 +454,55 @@ OMPLTimeIndexedRRTConnect::GrowState OMPLTimeIndexedRRTConnect::growTree(TreeDat
         return TRAPPED;
 }
 
+OMPLTimeIndexedRRTConnect::Motion *OMPLTimeIndexedRRTConnect::addMotion(TreeData &tree, Motion *parent, const base::State *state)
+{
+    Motion *motion = new Motion(si_);
+    si_->copyState(motion->state, state);
+    motion->parent = parent;
+    motion->root = parent->root;
+    motion->valid = !lazy_;
+    parent->children.push_back(motion);
+    tree->add(motion);
+    return motion;
+}
+
+bool OMPLTimeIndexedRRTConnect::checkPathToRoot(TreeData &tree, Motion *motion, bool start)
+{
+    for (Motion *m = motion; m->parent != nullptr; m = m->parent)
+    {
+        if (m->valid) continue;
+        // motions in the goal tree go backwards in time, see growTree
+        if (!(start ? si_->checkMotion(m->parent->state, m->state) : si_->checkMotion(m->state, m->parent->state)))
+        {
+            removeSubtree(tree, m);
+            return false;
+        }
+        m->valid = true;
+    }
+    return true;
+}
+
+void OMPLTimeIndexedRRTConnect::removeSubtree(TreeData &tree, Motion *motion)
+{
+    // The parent stays in the tree
+    if (motion->parent)
+    {
+        std::vector<Motion *> &siblings = motion->parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), motion));
+    }
+
+    std::vector<Motion *> subtree(1, motion);
+    while (!subtree.empty())
+    {
+        Motion *m = subtree.back();
+        subtree.pop_back();
+        subtree.insert(subtree.end(), m->children.begin(), m->children.end());
+        tree->remove(m);
+        si_->freeState(m->state);
+        delete m;
+    }
+}
+
 ompl::base::PlannerStatus OMPLTimeIndexedRRTConnect::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
@@ -480,6 +604,9 @@ ompl::base::PlannerStatus OMPLTimeIndexedRRTConnect::solve(const base::PlannerTe
             // if we connected the trees in a valid way (start and goal pair is valid)
             if (gsc == REACHED && goal->isStartGoalPairValid(startMotion->root, goalMotion->root))
             {
+                // in lazy mode, the motions along the connection are checked now; invalid branches are pruned and planning continues
+                if (lazy_ && !(checkPathToRoot(tStart_, startMotion, true) && checkPathToRoot(tGoal_, goalMotion, false))) continue;
+
                 // it must be the case that either the start tree or the goal tree has made some progress
                 // so one of the parents is not nullptr. We go one step 'back' to avoid having a duplicate state
                 // on the solution path
@@ -0,0 +1,323 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <limits>
+
+#include <exotica_core/exotica_core.h>
+#include <exotica_core/tools/continuous_motion_checker.h>
+#include <exotica_core/tools/test_helpers.h>
+#include <exotica_time_indexed_rrt_connect_solver/time_indexed_rrt_connect.h>
+#include <geometric_shapes/shapes.h>
+#include <gtest/gtest.h>
+#include <ompl/base/ScopedState.h>
+
+using namespace exotica;
+
+// A sphere of radius 0.1 at 0.5 m from a revolute joint, which itself slides along x.
+static const std::string slider_arm_urdf_ = "<robot name=\"slider_arm\"><link name=\"base\"/><link name=\"carriage\"/><link name=\"arm\"><collision><origin xyz=\"0.5 0 0\"/><geometry><sphere radius=\"0.1\"/></geometry></collision></link><joint name=\"slide\" type=\"prismatic\"><parent link=\"base\"/><child link=\"carriage\"/><axis xyz=\"1 0 0\"/><limit effort=\"1\" velocity=\"1\" lower=\"-2\" upper=\"2\"/></joint><joint name=\"rotate\" type=\"revolute\"><parent link=\"carriage\"/><child link=\"arm\"/><axis xyz=\"0 0 1\"/><limit effort=\"1\" velocity=\"1\" lower=\"-3.14\" upper=\"3.14\"/></joint></robot>";
+static const std::string slider_arm_srdf_ = "<robot name=\"slider_arm\"><group name=\"arm\"><chain base_link=\"base\" tip_link=\"arm\"/></group><virtual_joint name=\"world_joint\" type=\"fixed\" parent_frame=\"world_frame\" child_link=\"base\"/></robot>";
+
+// Two spheres of radius 0.1 sliding along x, 1 m apart at zero.
+static const std::string slider_pair_urdf_ = "<robot name=\"slider_pair\"><link name=\"base\"/><link name=\"left\"><collision><geometry><sphere radius=\"0.1\"/></geometry></collision></link><link name=\"right\"><collision><geometry><sphere radius=\"0.1\"/></geometry></collision></link><joint name=\"left_slide\" type=\"prismatic\"><parent link=\"base\"/><child link=\"left\"/><axis xyz=\"1 0 0\"/><limit effort=\"1\" velocity=\"1\" lower=\"-2\" upper=\"2\"/></joint><joint name=\"right_slide\" type=\"prismatic\"><parent link=\"base\"/><child link=\"right\"/><origin xyz=\"1 0 0\"/><axis xyz=\"1 0 0\"/><limit effort=\"1\" velocity=\"1\" lower=\"-2\" upper=\"2\"/></joint></robot>";
+static const std::string slider_pair_srdf_ = "<robot name=\"slider_pair\"><group name=\"arm\"><joint name=\"left_slide\"/><joint name=\"right_slide\"/></group><virtual_joint name=\"world_joint\" type=\"fixed\" parent_frame=\"world_frame\" child_link=\"base\"/></robot>";
+
+constexpr double radius_ = 0.1;
+constexpr double tolerance_ = 1e-3;
+
+Initializer SceneInitializer(const std::string& urdf, const std::string& srdf)
+{
+    return Initializer("exotica/Scene", {{"Name", std::string("MyScene")},
+                                         {"JointGroup", std::string("arm")},
+                                         {"URDF", urdf},
+                                         {"SRDF", srdf},
+                                         {"AlwaysUpdateCollisionScene", std::string("1")},
+                                         {"CollisionScene", std::vector<Initializer>({Initializer("exotica/CollisionSceneFCLLatest", {{"Name", std::string("MyCollisionScene")}})})}});
+}
+
+void AddSphereObstacle(ScenePtr scene, const Eigen::Vector3d& position)
+{
+    scene->AddObjectToEnvironment("Obstacle", KDL::Frame(KDL::Vector(position(0), position(1), position(2))), std::make_shared<shapes::Sphere>(radius_));
+}
+
+TimeIndexedSamplingProblemPtr CreateProblem(const Eigen::VectorXd& start_state = Eigen::VectorXd(), const Eigen::VectorXd& goal = Eigen::VectorXd())
+{
+    Initializer problem("exotica/TimeIndexedSamplingProblem", {{"Name", std::string("MyProblem")},
+                                                              {"PlanningScene", SceneInitializer(slider_arm_urdf_, slider_arm_srdf_)},
+                                                              {"Maps", std::vector<Initializer>({Initializer("exotica/CollisionCheck", {{"Name", std::string("Collision")}})})},
+                                                              {"Equality", std::vector<Initializer>({Initializer("exotica/Task", {{"Task", std::string("Collision")}})})},
+                                                              {"StartState", start_state},
+                                                              {"Goal", goal},
+                                                              {"GoalTime", 10.0}});
+    return std::static_pointer_cast<TimeIndexedSamplingProblem>(Setup::CreateProblem(problem));
+}
+
+/// \brief Adds a thin wall at x = 0.5 that the sphere of the slider arm can only pass above y = 0.35.
+void AddWall(ScenePtr scene)
+{
+    scene->AddObjectToEnvironment("Wall", KDL::Frame(KDL::Vector(0.5, -0.325, 0.0)), std::make_shared<shapes::Box>(0.02, 1.35, 0.5));
+}
+
+double GetMinimumDistance(ScenePtr scene, Eigen::VectorXdRefConst x, bool self)
+{
+    scene->Update(x);
+    scene->GetCollisionScene()->UpdateCollisionObjectTransforms();
+    const std::vector<CollisionProxy> proxies = self ? scene->GetCollisionScene()->GetRobotToRobotCollisionDistance(10.0) : scene->GetCollisionScene()->GetRobotToWorldCollisionDistance(10.0);
+    double distance = std::numeric_limits<double>::infinity();
+    for (const CollisionProxy& proxy : proxies) distance = std::min(distance, proxy.distance);
+    return distance;
+}
+
+/// \brief Checks that the motion is reported in contact at the first time of contact, i.e. between the time the distance
+/// falls below the tolerance and the time of contact, and that the advancement never passed the contact.
+void CheckContact(ContinuousMotionChecker& checker, ScenePtr scene, const Eigen::VectorXd& x1, const Eigen::VectorXd& x2, double s_tolerance, double s_contact, bool self)
+{
+    double last_valid = -1.0;
+    EXPECT_FALSE(checker.CheckMotion(x1, x2, last_valid));
+    TEST_COUT << "Contact at " << last_valid << ", expected in [" << s_tolerance << ", " << s_contact << "] after " << checker.GetNumberOfDistanceQueries() << " distance queries";
+    EXPECT_GE(last_valid, s_tolerance - 1e-6);
+    EXPECT_LE(last_valid, s_contact + 1e-6);
+    EXPECT_GE(GetMinimumDistance(scene, x1 + last_valid * (x2 - x1), self), -1e-6);
+}
+
+TEST(ContinuousMotionChecker, TranslationTowardsObstacle)
+{
+    ScenePtr scene = Setup::CreateScene(SceneInitializer(slider_arm_urdf_, slider_arm_srdf_));
+    AddSphereObstacle(scene, Eigen::Vector3d(1.5, 0.0, 0.0));
+    ContinuousMotionChecker checker(scene, false, tolerance_);
+    EXPECT_DOUBLE_EQ(checker.GetLeverArms()(0), 1.0);
+
+    // The gap between the spheres is 0.8 - x for the arm at zero.
+    const Eigen::Vector2d x1(0.0, 0.0);
+    CheckContact(checker, scene, x1, Eigen::Vector2d(1.0, 0.0), 0.8 - tolerance_, 0.8, false);
+
+    // A motion that stops short of the obstacle is valid. The obstacle is further than the motion, a single query suffices.
+    double last_valid = -1.0;
+    EXPECT_TRUE(checker.CheckMotion(x1, Eigen::Vector2d(0.5, 0.0), last_valid));
+    EXPECT_EQ(last_valid, 1.0);
+    EXPECT_EQ(checker.GetNumberOfDistanceQueries(), 1);
+}
+
+TEST(ContinuousMotionChecker, RotationTowardsObstacle)
+{
+    ScenePtr scene = Setup::CreateScene(SceneInitializer(slider_arm_urdf_, slider_arm_srdf_));
+    AddSphereObstacle(scene, Eigen::Vector3d(0.0, 0.5, 0.0));
+    ContinuousMotionChecker checker(scene, false, tolerance_);
+
+    // Rotating by pi/2 moves the sphere onto the obstacle. The centres are sin(delta / 2) apart for the remaining angle delta.
+    const auto fraction = [](double distance) { return 1.0 - 2.0 * std::asin(distance) / M_PI_2; };
+    CheckContact(checker, scene, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(0.0, M_PI_2), fraction(2.0 * radius_ + tolerance_), fraction(2.0 * radius_), false);
+}
+
+TEST(ContinuousMotionChecker, SelfCollision)
+{
+    ScenePtr scene = Setup::CreateScene(SceneInitializer(slider_pair_urdf_, slider_pair_srdf_));
+
+    // Both spheres move towards each other, the gap is 0.8 - s.
+    const Eigen::Vector2d x1(0.0, 0.0), x2(0.5, -0.5);
+    ContinuousMotionChecker checker(scene, true, tolerance_);
+    CheckContact(checker, scene, x1, x2, 0.8 - tolerance_, 0.8, true);
+
+    double last_valid = -1.0;
+    ContinuousMotionChecker world_only_checker(scene, false, tolerance_);
+    EXPECT_TRUE(world_only_checker.CheckMotion(x1, x2, last_valid));
+    EXPECT_EQ(last_valid, 1.0);
+}
+
+TEST(OMPLContinuousMotionValidator, ReportsFirstTimeOfContact)
+{
+    TimeIndexedSamplingProblemPtr problem = CreateProblem();
+    AddSphereObstacle(problem->GetScene(), Eigen::Vector3d(1.5, 0.0, 0.0));
+
+    auto state_space = std::make_shared<OMPLTimeIndexedRNStateSpace>(problem, TimeIndexedRRTConnectSolverInitializer());
+    auto si = std::make_shared<ompl::base::SpaceInformation>(state_space);
+    si->setStateValidityChecker(std::make_shared<OMPLTimeIndexedStateValidityChecker>(si, problem));
+    auto checker = std::make_shared<ContinuousMotionChecker>(problem->GetScene(), false, tolerance_);
+    si->setMotionValidator(std::make_shared<OMPLContinuousMotionValidator>(si, checker, [state_space](const ompl::base::State* state, Eigen::VectorXd& q, double& t) { state_space->OMPLToExoticaState(state, q, t); }));
+    si->setup();
+
+    ompl::base::ScopedState<> s1(state_space), s2(state_space), s3(state_space), last_valid_state(state_space);
+    state_space->ExoticaToOMPLState(Eigen::Vector2d(0.0, 0.0), 1.0, s1.get());
+    state_space->ExoticaToOMPLState(Eigen::Vector2d(1.0, 0.0), 3.0, s2.get());
+    state_space->ExoticaToOMPLState(Eigen::Vector2d(0.5, 0.0), 3.0, s3.get());
+
+    // The last valid state is the first time of contact, interpolated in joint space and time
+    std::pair<ompl::base::State*, double> last_valid(last_valid_state.get(), -1.0);
+    EXPECT_FALSE(si->checkMotion(s1.get(), s2.get(), last_valid));
+    EXPECT_GE(last_valid.second, 0.8 - tolerance_ - 1e-6);
+    EXPECT_LE(last_valid.second, 0.8 + 1e-6);
+    Eigen::VectorXd q;
+    double t;
+    state_space->OMPLToExoticaState(last_valid_state.get(), q, t);
+    EXPECT_NEAR(q(0), last_valid.second, 1e-9);
+    EXPECT_NEAR(q(1), 0.0, 1e-9);
+    EXPECT_NEAR(t, 1.0 + 2.0 * last_valid.second, 1e-9);
+
+    EXPECT_TRUE(si->checkMotion(s1.get(), s3.get(), last_valid));
+    EXPECT_EQ(last_valid.second, 1.0);
+    EXPECT_TRUE(si->checkMotion(s1.get(), s3.get()));
+    EXPECT_FALSE(si->checkMotion(s1.get(), s2.get()));
+    EXPECT_EQ(si->getMotionValidator()->getValidMotionCount(), 2u);
+    EXPECT_EQ(si->getMotionValidator()->getInvalidMotionCount(), 2u);
+}
+
+/// \brief Exposes the start tree of the planner to build it motion by motion.
+class StartTreeRRTConnect : public OMPLTimeIndexedRRTConnect
+{
+public:
+    StartTreeRRTConnect(const ompl::base::SpaceInformationPtr& si) : OMPLTimeIndexedRRTConnect(si)
+    {
+        setLazy(true);
+        setup();
+    }
+
+    Motion* AddRoot(const ompl::base::State* state)
+    {
+        Motion* motion = new Motion(si_);
+        si_->copyState(motion->state, state);
+        motion->root = motion->state;
+        tStart_->add(motion);
+        return motion;
+    }
+
+    Motion* AddMotion(Motion* parent, const ompl::base::State* state) { return addMotion(tStart_, parent, state); }
+    bool CheckPathToRoot(Motion* motion) { return checkPathToRoot(tStart_, motion, true); }
+    std::size_t GetStartTreeSize() const { return tStart_->size(); }
+};
+
+TEST(OMPLTimeIndexedRRTConnect, LazyCheckingPrunesInvalidSubtrees)
+{
+    TimeIndexedSamplingProblemPtr problem = CreateProblem();
+    AddWall(problem->GetScene());
+
+    auto state_space = std::make_shared<OMPLTimeIndexedRNStateSpace>(problem, TimeIndexedRRTConnectSolverInitializer());
+    auto si = std::make_shared<ompl::base::SpaceInformation>(state_space);
+    si->setStateValidityChecker(std::make_shared<OMPLTimeIndexedStateValidityChecker>(si, problem));
+    si->setStateValidityCheckingResolution(0.01);
+    si->setup();
+    const ompl::base::MotionValidatorPtr& motion_validator = si->getMotionValidator();
+
+    const auto create_state = [&](double x, double angle, double t) {
+        ompl::base::ScopedState<> state(state_space);
+        state_space->ExoticaToOMPLState(Eigen::Vector2d(x, angle), t, state.get());
+        return state;
+    };
+
+    // The motion from a to b passes the sphere through the wall, all other motions and all states are valid.
+    StartTreeRRTConnect planner(si);
+    auto root = planner.AddRoot(create_state(-1.0, 0.0, 0.0).get());
+    auto a = planner.AddMotion(root, create_state(-0.5, 0.0, 1.0).get());
+    auto b = planner.AddMotion(a, create_state(1.0, 0.0, 3.0).get());
+    auto c = planner.AddMotion(b, create_state(1.5, 0.0, 4.0).get());
+    auto d = planner.AddMotion(a, create_state(-0.5, 1.5, 2.0).get());
+    EXPECT_EQ(planner.GetStartTreeSize(), 5u);
+    EXPECT_EQ(a->children.size(), 2u);
+
+    // Lazy mode defers checking the motions until a path to the root is requested
+    EXPECT_EQ(motion_validator->getValidMotionCount() + motion_validator->getInvalidMotionCount(), 0u);
+
+    // Checking from c finds b -> c valid and a -> b invalid, which prunes b and c
+    EXPECT_FALSE(planner.CheckPathToRoot(c));
+    EXPECT_EQ(motion_validator->getValidMotionCount(), 1u);
+    EXPECT_EQ(motion_validator->getInvalidMotionCount(), 1u);
+    EXPECT_EQ(planner.GetStartTreeSize(), 3u);
+    ASSERT_EQ(a->children.size(), 1u);
+    EXPECT_EQ(a->children[0], d);
+
+    // The remaining branch is checked once
+    EXPECT_TRUE(planner.CheckPathToRoot(d));
+    EXPECT_EQ(motion_validator->getValidMotionCount(), 3u);
+    EXPECT_TRUE(planner.CheckPathToRoot(d));
+    EXPECT_EQ(motion_validator->getValidMotionCount(), 3u);
+    EXPECT_EQ(motion_validator->getInvalidMotionCount(), 1u);
+}
+
+TEST(TimeIndexedRRTConnectSolver, LazyCheckingWithValidityCache)
+{
+    TimeIndexedSamplingProblemPtr problem = CreateProblem(Eigen::Vector2d(-1.0, 0.0), Eigen::Vector2d(1.0, 0.0));
+    AddWall(problem->GetScene());
+
+    Initializer solver_init("exotica/TimeIndexedRRTConnectSolver", {{"Name", std::string("MySolver")},
+                                                                   {"LazyCollisionChecking", std::string("1")},
+                                                                   {"ValidityCacheSize", 10000},
+                                                                   {"AddTimeIntoSolution", std::string("1")},
+                                                                   {"RandomSeed", 42},
+                                                                   {"Timeout", 10.0}});
+    std::shared_ptr<TimeIndexedRRTConnectSolver> solver = std::static_pointer_cast<TimeIndexedRRTConnectSolver>(Setup::CreateSolver(solver_init));
+    solver->SpecifyProblem(problem);
+    Eigen::MatrixXd solution;
+    solver->Solve(solution);
+    ASSERT_GT(solution.rows(), 1);
+
+    // The goal is checked when it is set and again when the planner samples it
+    TEST_COUT << "Validity cache hits: " << solver->GetValidityCacheHits() << ", misses: " << solver->GetValidityCacheMisses();
+    EXPECT_GT(solver->GetValidityCacheHits(), 0u);
+    EXPECT_GT(solver->GetValidityCacheMisses(), 0u);
+
+    // Lazy checking defers motion checks, so the motions between the waypoints have to be valid as well
+    for (int i = 0; i + 1 < solution.rows(); ++i)
+    {
+        for (int k = 0; k <= 10; ++k)
+        {
+            const double s = 0.1 * k;
+            const Eigen::VectorXd state = (1.0 - s) * solution.row(i).transpose() + s * solution.row(i + 1).transpose();
+            EXPECT_TRUE(problem->IsValid(state.tail(2), state(0))) << "Invalid state at " << s << " between waypoints " << i << " and " << i + 1;
+        }
+    }
+}
+
+TEST(TimeIndexedRRTConnectSolver, TimeBudgetAppliesToEverySolve)
+{
+    TimeIndexedSamplingProblemPtr problem = CreateProblem(Eigen::Vector2d(-1.0, 0.0), Eigen::Vector2d(1.0, 0.0));
+    AddWall(problem->GetScene());
+
+    Initializer solver_init("exotica/TimeIndexedRRTConnectSolver", {{"Name", std::string("MySolver")},
+                                                                   {"RandomSeed", 42},
+                                                                   {"Timeout", 10.0}});
+    std::shared_ptr<TimeIndexedRRTConnectSolver> solver = std::static_pointer_cast<TimeIndexedRRTConnectSolver>(Setup::CreateSolver(solver_init));
+    solver->SpecifyProblem(problem);
+
+    // Each query gets its own deadline, i.e., a later query neither inherits an expired one nor ignores a changed budget
+    for (double max_planning_time : {5.0, 5.0, 2.0})
+    {
+        solver->SetMaxPlanningTime(max_planning_time);
+        Eigen::MatrixXd solution;
+        solver->Solve(solution);
+        EXPECT_GT(solution.rows(), 1);
+        EXPECT_LT(solver->GetPlanningTime(), max_planning_time + 0.5);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    Setup::Destroy();
+    return ret;
+}
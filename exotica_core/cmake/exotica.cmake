@@ -4,5 +4,11 @@ add_compile_options(-Wfloat-conversion -Wall)
 # gcc only: -Wno-maybe-uninitialized
 # add_compile_options(-Werror)
 
+# Scoped profiler zones (EXOTICA_PROFILE_ZONE) compile to nothing unless enabled.
+option(EXOTICA_ENABLE_PROFILER "Record profiler zones in Scene, task maps and solvers" OFF)
+if(EXOTICA_ENABLE_PROFILER)
+  add_definitions(-DEXOTICA_ENABLE_PROFILER)
+endif()
+
 # MoveIt Core Robot Model isnt aligned :'(
 #add_definitions(-DEIGEN_MAX_ALIGN_BYTES=0 -DEIGEN_DONT_VECTORIZE)
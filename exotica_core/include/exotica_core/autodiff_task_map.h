@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_AUTODIFF_TASK_MAP_H_
+#define EXOTICA_CORE_AUTODIFF_TASK_MAP_H_
+
+#include <exotica_core/task_map.h>
+#include <exotica_core/tools/autodiff_chain_hessian.h>
+#include <exotica_core/tools/autodiff_chain_jacobian.h>
+#include <exotica_core/tools/functor.h>
+
+namespace exotica
+{
+/// \brief Task map base class generating phi, the Jacobian and the Hessian from a single scalar-templated function.
+///
+/// The derived class (CRTP) implements
+///
+///     template <typename T>
+///     void Eval(const InputVector<T>& frames, ValueVector<T>& phi, int i) const;
+///
+/// which maps FramesPerEval consecutive frames of kinematics[0] (group i) to ValuesPerEval task space values.
+/// Each frame enters as its position (3 values) followed, if WithOrientation is set, by its rotation matrix
+/// (9 values, column-major); use Position() and Rotation() to unpack them. The derivatives are computed by
+/// forward-mode automatic differentiation chained with the kinematic Jacobians/Hessians of the frames.
+/// Every output has to depend on at least one input.
+template <class Derived, int FramesPerEval, int ValuesPerEval, bool WithOrientation = true>
+class AutoDiffTaskMap : public TaskMap
+{
+public:
+    static constexpr int FrameInputDim = WithOrientation ? 12 : 3;
+    static constexpr int InputDim = FrameInputDim * FramesPerEval;
+
+    template <typename T>
+    using InputVector = Eigen::Matrix<T, InputDim, 1>;
+    template <typename T>
+    using ValueVector = Eigen::Matrix<T, ValuesPerEval, 1>;
+    typedef Eigen::Matrix<double, InputDim, Eigen::Dynamic> InputJacobianType;
+    typedef Eigen::Array<Eigen::MatrixXd, InputDim, 1> InputHessianType;
+
+    using TaskMap::Update;
+
+    void Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi) override
+    {
+        if (phi.rows() != ValuesPerEval * NumberOfEvaluations()) ThrowNamed("Wrong size of phi!");
+        InputVector<double> x;
+        ValueVector<double> value;
+        for (int i = 0; i < NumberOfEvaluations(); ++i)
+        {
+            for (int k = 0; k < FramesPerEval; ++k) SetFrameInput(kinematics[0].Phi(i * FramesPerEval + k), k, x);
+            derived().Eval(x, value, i);
+            phi.template segment<ValuesPerEval>(i * ValuesPerEval) = value;
+        }
+    }
+
+    void Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian) override
+    {
+        if (phi.rows() != ValuesPerEval * NumberOfEvaluations()) ThrowNamed("Wrong size of phi!");
+        if (jacobian.rows() != phi.rows() || jacobian.cols() != kinematics[0].jacobian(0).data.cols()) ThrowNamed("Wrong size of jacobian! " << kinematics[0].jacobian(0).data.cols());
+
+        const Eigen::Index n = jacobian.cols();
+        input_jacobian_.resize(InputDim, n);
+        value_jacobian_.resize(ValuesPerEval, n);
+        for (int i = 0; i < NumberOfEvaluations(); ++i)
+        {
+            for (int k = 0; k < FramesPerEval; ++k) SetFrameInput(kinematics[0].Phi(i * FramesPerEval + k), kinematics[0].jacobian(i * FramesPerEval + k).data, k, input_, input_jacobian_);
+            Eigen::AutoDiffChainJacobian<EvalFunctor> autodiff(derived(), i);
+            autodiff(input_, value_, value_jacobian_, input_jacobian_);
+            phi.template segment<ValuesPerEval>(i * ValuesPerEval) = value_;
+            jacobian.template middleRows<ValuesPerEval>(i * ValuesPerEval) = value_jacobian_;
+        }
+    }
+
+    void Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian, HessianRef hessian) override
+    {
+        if (phi.rows() != ValuesPerEval * NumberOfEvaluations()) ThrowNamed("Wrong size of phi!");
+        if (jacobian.rows() != phi.rows() || jacobian.cols() != kinematics[0].jacobian(0).data.cols()) ThrowNamed("Wrong size of jacobian! " << kinematics[0].jacobian(0).data.cols());
+        if (hessian.rows() != phi.rows()) ThrowNamed("Wrong size of hessian! " << hessian.rows());
+
+        const Eigen::Index n = jacobian.cols();
+        input_jacobian_.resize(InputDim, n);
+        value_jacobian_.resize(ValuesPerEval, n);
+        for (int k = 0; k < InputDim; ++k) input_hessian_(k).resize(n, n);
+        for (int i = 0; i < NumberOfEvaluations(); ++i)
+        {
+            for (int k = 0; k < FramesPerEval; ++k) SetFrameInput(kinematics[0].Phi(i * FramesPerEval + k), kinematics[0].jacobian(i * FramesPerEval + k).data, kinematics[0].hessian(i * FramesPerEval + k), k, input_, input_jacobian_, input_hessian_);
+            Eigen::AutoDiffChainHessian<EvalFunctor> autodiff(derived(), i);
+            autodiff(input_, value_, value_jacobian_, value_hessian_, input_jacobian_, input_hessian_);
+            phi.template segment<ValuesPerEval>(i * ValuesPerEval) = value_;
+            jacobian.template middleRows<ValuesPerEval>(i * ValuesPerEval) = value_jacobian_;
+            for (int j = 0; j < ValuesPerEval; ++j) hessian(i * ValuesPerEval + j) = value_hessian_(j);
+        }
+    }
+
+    int TaskSpaceDim() override { return ValuesPerEval * NumberOfEvaluations(); }
+
+    /// \brief Returns the position of the k-th frame of an evaluation.
+    template <typename T>
+    static Eigen::Matrix<T, 3, 1> Position(const InputVector<T>& x, int k)
+    {
+        return x.template segment<3>(FrameInputDim * k);
+    }
+
+    /// \brief Returns the rotation matrix of the k-th frame of an evaluation (requires WithOrientation).
+    template <typename T>
+    static Eigen::Matrix<T, 3, 3> Rotation(const InputVector<T>& x, int k)
+    {
+        static_assert(WithOrientation, "Frame orientations are not part of the input, set WithOrientation.");
+        return Eigen::Map<const Eigen::Matrix<T, 3, 3>>(x.data() + FrameInputDim * k + 3);
+    }
+
+    /// \brief Fills the inputs of the k-th frame and their derivatives w.r.t. the joints from the kinematic Jacobian (6 x N) and Hessian.
+    /// The angular part of the kinematic Hessian is expected in the layout of KinematicTree::ComputeH, i.e., hessian(3 + l)(b, a) = d omega_b(l) / d q_a.
+    static void SetFrameInput(const Eigen::Vector3d& position, const Eigen::Matrix3d& rotation, const Eigen::MatrixXd& frame_jacobian, const Hessian* frame_hessian, int k,
+                              InputVector<double>& x, InputJacobianType& input_jacobian, InputHessianType* input_hessian)
+    {
+        const int offset = FrameInputDim * k;
+        x.template segment<3>(offset) = position;
+        input_jacobian.template middleRows<3>(offset) = frame_jacobian.topRows<3>();
+        if (input_hessian)
+            for (int l = 0; l < 3; ++l) (*input_hessian)(offset + l) = (*frame_hessian)(l);
+
+        if (!WithOrientation) return;
+
+        // The columns r of the rotation matrix move with dr/dq_a = omega_a x r.
+        const Eigen::Index n = frame_jacobian.cols();
+        for (int c = 0; c < 3; ++c)
+        {
+            const int column_offset = offset + 3 + 3 * c;
+            const Eigen::Vector3d r = rotation.col(c);
+            x.template segment<3>(column_offset) = r;
+            for (Eigen::Index a = 0; a < n; ++a)
+                input_jacobian.template block<3, 1>(column_offset, a) = frame_jacobian.col(a).tail<3>().cross(r);
+
+            if (!input_hessian) continue;
+            // d^2 r / dq_a dq_b = (d omega_b / dq_a) x r + omega_b x (omega_a x r)
+            for (int l = 0; l < 3; ++l) (*input_hessian)(column_offset + l).setZero(n, n);
+            for (Eigen::Index a = 0; a < n; ++a)
+            {
+                const Eigen::Vector3d dr_a = input_jacobian.template block<3, 1>(column_offset, a);
+                for (Eigen::Index b = 0; b < n; ++b)
+                {
+                    const Eigen::Vector3d domega((*frame_hessian)(3)(b, a), (*frame_hessian)(4)(b, a), (*frame_hessian)(5)(b, a));
+                    const Eigen::Vector3d ddr = domega.cross(r) + frame_jacobian.col(b).tail<3>().cross(dr_a);
+                    for (int l = 0; l < 3; ++l) (*input_hessian)(column_offset + l)(a, b) = ddr(l);
+                }
+            }
+        }
+    }
+
+protected:
+    /// Number of groups of FramesPerEval frames the map is evaluated for.
+    int NumberOfEvaluations() const { return kinematics[0].Phi.rows() / FramesPerEval; }
+
+private:
+    /// Adapts Derived::Eval to the functor interface of the autodiff tools.
+    struct EvalFunctor : public FunctorBase<double, InputDim, ValuesPerEval, Eigen::Dynamic>
+    {
+        EvalFunctor(const Derived& map, int i) : map(map), i(i) {}
+
+        template <typename T>
+        void operator()(const InputVector<T>& x, ValueVector<T>& phi) const
+        {
+            map.Eval(x, phi, i);
+        }
+
+        const Derived& map;
+        const int i;
+    };
+
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    static Eigen::Vector3d GetPosition(const KDL::Frame& frame) { return Eigen::Map<const Eigen::Vector3d>(frame.p.data); }
+    static Eigen::Matrix3d GetRotation(const KDL::Frame& frame) { return Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(frame.M.data); }
+
+    static void SetFrameInput(const KDL::Frame& frame, int k, InputVector<double>& x)
+    {
+        x.template segment<3>(FrameInputDim * k) = GetPosition(frame);
+        if (WithOrientation) Eigen::Map<Eigen::Matrix3d>(x.data() + FrameInputDim * k + 3) = GetRotation(frame);
+    }
+
+    static void SetFrameInput(const KDL::Frame& frame, const Eigen::MatrixXd& frame_jacobian, int k, InputVector<double>& x, InputJacobianType& input_jacobian)
+    {
+        SetFrameInput(GetPosition(frame), GetRotation(frame), frame_jacobian, nullptr, k, x, input_jacobian, nullptr);
+    }
+
+    static void SetFrameInput(const KDL::Frame& frame, const Eigen::MatrixXd& frame_jacobian, const Hessian& frame_hessian, int k, InputVector<double>& x, InputJacobianType& input_jacobian, InputHessianType& input_hessian)
+    {
+        SetFrameInput(GetPosition(frame), GetRotation(frame), frame_jacobian, &frame_hessian, k, x, input_jacobian, &input_hessian);
+    }
+
+    // Workspaces reused across updates
+    InputVector<double> input_;
+    ValueVector<double> value_;
+    InputJacobianType input_jacobian_;
+    Eigen::Matrix<double, ValuesPerEval, Eigen::Dynamic> value_jacobian_;
+    InputHessianType input_hessian_;
+    typename Eigen::AutoDiffChainHessian<EvalFunctor>::HessianType value_hessian_;
+};
+}  // namespace exotica
+
+#endif  // EXOTICA_CORE_AUTODIFF_TASK_MAP_H_
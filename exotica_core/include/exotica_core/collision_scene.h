@@ -231,7 +231,7 @@ public:
     /// @param[in]  name    Name of the collision object to query.
     virtual Eigen::Vector3d GetTranslation(const std::string& name) = 0;
 
-    void SetACM(const AllowedCollisionMatrix& acm)
+    virtual void SetACM(const AllowedCollisionMatrix& acm)
     {
         acm_ = acm;
     }
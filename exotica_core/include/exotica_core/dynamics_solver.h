@@ -130,6 +130,11 @@ public:
     // TODO: To be deprecated - or at least remove its use - as it's difficult to get partial derivatives.
     StateVector Simulate(const StateVector& x, const ControlVector& u, T t);
 
+    /// \brief Simulates the dynamic system like Simulate, but overwrites x with the resulting state.
+    ///
+    /// Works on caller-owned memory, e.g. an Eigen::Map of a planner's state, and reuses internal buffers across calls.
+    void SimulateInPlace(Eigen::Ref<StateVector> x, const Eigen::Ref<const ControlVector>& u, T t);
+
     /// \brief Return the difference of two state vectors.
     ///     Used when e.g. angle differences need to be wrapped from [-pi; pi]
     ///     Returns x_1-x_2
@@ -230,6 +235,8 @@ private:
     Eigen::VectorXd raw_control_limits_low_, raw_control_limits_high_;
     Eigen::MatrixXd dStateDelta_;
     Hessian ddStateDelta_;
+    StateVector simulate_x_, simulate_x_next_;  ///< Buffers of SimulateInPlace
+    ControlVector simulate_u_;                  ///< Buffer of SimulateInPlace
 
 protected:
     int num_controls_ = -1;          ///< Number of controls in the dynamic system.
@@ -253,7 +260,12 @@ protected:
 
     /// \brief Integrates the dynamic system from state x with controls u applied for one timestep dt using the selected integrator.
     // TODO: To be deprecated in favour of explicit call to Integrate in Simulate
-    virtual StateVector SimulateOneStep(const StateVector& x, const ControlVector& u);
+    StateVector SimulateOneStep(const StateVector& x, const ControlVector& u);
+
+    /// \brief Like SimulateOneStep, but writes the next state into xout (sized get_num_state()).
+    ///
+    /// F, Simulate and SimulateInPlace all step through this method; override it to customise the state transition.
+    virtual void SimulateOneStepInPlace(const StateVector& x, const ControlVector& u, StateVector& xout);
 
     void InitializeSecondOrderDerivatives();
     Eigen::Tensor<T, 3> fxx_default_, fuu_default_, fxu_default_;
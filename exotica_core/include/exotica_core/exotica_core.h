@@ -47,6 +47,7 @@
 #include <exotica_core/server.h>
 #include <exotica_core/setup.h>
 #include <exotica_core/tools.h>
+#include <exotica_core/tools/serialization.h>
 #include <exotica_core/version.h>
 
 #endif  // EXOTICA_CORE_H_
@@ -44,7 +44,7 @@ public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
     std::string name;
-    shapes::ShapePtr shape = nullptr;
+    shapes::ShapeConstPtr shape = nullptr;
     std::string shape_resource_path = "";
     KDL::Frame frame = KDL::Frame::Identity();
     Eigen::Vector3d scale = Eigen::Vector3d::Ones();
@@ -58,7 +58,8 @@ enum KinematicRequestFlags
     KIN_FK = 0,
     KIN_J = 2,
     KIN_FK_VEL = 4,
-    KIN_H = 8
+    KIN_H = 8,
+    KIN_COM = 16  ///< Composite center of mass of the robot (and its Jacobian if KIN_J is set)
 };
 
 enum JointLimitType
@@ -150,6 +151,12 @@ public:
     BaseType GetControlledBaseType() const;
     std::shared_ptr<KinematicResponse> RequestFrames(const KinematicsRequest& request);
     void Update(Eigen::VectorXdRefConst x);
+
+    /// @brief Sets a single controlled joint and recomputes the frames of the subtree below it and the requested frames.
+    /// Jacobians and Hessians are not updated. Used for perturbing one joint at a time, e.g. for finite differences.
+    /// @param i Index of the controlled joint.
+    /// @param value New joint value.
+    void UpdateControlledJoint(int i, double value);
     void ResetJointLimits();
     const Eigen::MatrixXd& GetJointLimits() const { return joint_limits_; }
     void SetJointLimitsLower(Eigen::VectorXdRefConst lower_in);
@@ -166,6 +173,10 @@ public:
     const Eigen::VectorXd& GetVelocityLimits() const { return velocity_limits_; }
     int GetNumControlledJoints() const;
     int GetNumModelJoints() const;
+
+    /// \brief Returns a counter which is incremented whenever the joint state, the structure, the joint limits or the requested frames of the tree change.
+    /// Results computed from the tree are current as long as the revision has not changed.
+    unsigned int GetRevision() const { return revision_; }
     void PublishFrames(const std::string& tf_prefix = "exotica");
 
     const std::vector<std::string>& GetControlledJointNames() const
@@ -192,6 +203,24 @@ public:
 
     Eigen::VectorXd GetControlledLinkMass() const;
 
+    /// @brief Returns the total mass of the robot links and attached objects. Updated if KIN_COM was requested.
+    double GetTotalMass() const { return total_mass_; }
+
+    /// @brief Returns the center of mass of the robot links and attached objects in the root frame. Updated if KIN_COM was requested.
+    const Eigen::Vector3d& GetCenterOfMass() const { return center_of_mass_; }
+
+    /// @brief Returns the 3 x N Jacobian of the center of mass in the root frame. Updated if KIN_COM and KIN_J were requested.
+    const Eigen::MatrixXd& GetCenterOfMassJacobian() const { return center_of_mass_jacobian_; }
+
+    /// @brief Returns the mass of the subtree rooted at the given link (robot links and attached objects only). Requires KIN_COM.
+    double GetSubtreeMass(const std::string& link) const;
+
+    /// @brief Returns the center of mass of the subtree rooted at the given link in the root frame. Requires KIN_COM.
+    Eigen::Vector3d GetSubtreeCenterOfMass(const std::string& link) const;
+
+    /// @brief Returns the 3 x N Jacobian of the center of mass of the subtree rooted at the given link in the root frame. Requires KIN_COM.
+    Eigen::MatrixXd GetSubtreeCenterOfMassJacobian(const std::string& link) const;
+
     KDL::Frame FK(KinematicFrame& frame) const;
     KDL::Frame FK(std::shared_ptr<KinematicElement> element_A, const KDL::Frame& offset_a, std::shared_ptr<KinematicElement> element_B, const KDL::Frame& offset_b) const;
     KDL::Frame FK(const std::string& element_A, const KDL::Frame& offset_a, const std::string& element_B, const KDL::Frame& offset_b) const;
@@ -246,7 +275,11 @@ public:
     /// Random state generation
     Eigen::VectorXd GetRandomControlledState();
 
-    void SetKinematicResponse(std::shared_ptr<KinematicResponse> response_in) { solution_ = response_in; }
+    void SetKinematicResponse(std::shared_ptr<KinematicResponse> response_in)
+    {
+        solution_ = response_in;
+        ++revision_;
+    }
     std::shared_ptr<KinematicResponse> GetKinematicResponse() { return solution_; }
     bool debug = false;
 
@@ -254,12 +287,19 @@ private:
     void BuildTree(const KDL::Tree& RobotKinematics);
     void AddElementFromSegmentMapIterator(KDL::SegmentMap::const_iterator segment, std::shared_ptr<KinematicElement> parent);
     void UpdateTree();
+    void UpdateSubtree(std::shared_ptr<KinematicElement> subtree_root);
     void UpdateFK();
     void UpdateJ();
     void ComputeJ(KinematicFrame& frame, KDL::Jacobian& jacobian) const;
     void UpdateH();
     void ComputeH(KinematicFrame& frame, const KDL::Jacobian& jacobian, exotica::Hessian& hessian) const;
 
+    /// @brief Computes the composite mass and center of mass of every subtree in a single backward pass over the tree.
+    void UpdateCoM(bool update_jacobian);
+    /// @brief Computes the Jacobian of the center of mass of the subtree rooted at element (root frame) from the composite masses.
+    void ComputeCoMJacobian(const KinematicElement* element, Eigen::MatrixXd& jacobian) const;
+    std::shared_ptr<KinematicElement> GetElementForCoM(const std::string& link) const;
+
     // Joint limits
     // TODO: Add effort limits
     Eigen::MatrixXd joint_limits_;
@@ -278,6 +318,7 @@ private:
     int num_controlled_joints_;  //!< Number of controlled joints in the joint group.
     int num_joints_;             //!< Number of joints of the model (including floating/planar base, passive joints, and uncontrolled joints).
     int state_size_ = -1;
+    unsigned int revision_ = 0;  //!< See GetRevision()
     Eigen::VectorXd tree_state_;
     robot_model::RobotModelPtr model_;
     std::string root_joint_name_ = "";
@@ -297,6 +338,14 @@ private:
     std::shared_ptr<KinematicResponse> solution_ = std::make_shared<KinematicResponse>();
     KinematicRequestFlags flags_;
 
+    // Composite rigid bodies (KIN_COM), indexed by element id + 1
+    std::vector<const KinematicElement*> com_traversal_;  //!< Elements in breadth-first order
+    std::vector<double> composite_mass_;                  //!< Mass of the subtree of each element
+    std::vector<KDL::Vector> composite_moment_;           //!< First moment of mass (mass times center of mass, world frame) of the subtree of each element
+    double total_mass_ = 0.0;
+    Eigen::Vector3d center_of_mass_ = Eigen::Vector3d::Zero();
+    Eigen::MatrixXd center_of_mass_jacobian_;
+
     std::vector<tf::StampedTransform> debug_tree_;
     std::vector<tf::StampedTransform> debug_frames_;
     ros::Publisher shapes_pub_;
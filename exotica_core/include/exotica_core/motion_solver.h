@@ -30,15 +30,29 @@
 #ifndef EXOTICA_CORE_MOTION_SOLVER_H_
 #define EXOTICA_CORE_MOTION_SOLVER_H_
 
+#include <algorithm>
+#include <array>
+
 #include <exotica_core/factory.h>
 #include <exotica_core/object.h>
 #include <exotica_core/planning_problem.h>
 #include <exotica_core/property.h>
+#include <exotica_core/tools/timer.h>
 
 #define REGISTER_MOTIONSOLVER_TYPE(TYPE, DERIV) EXOTICA_CORE_REGISTER(exotica::MotionSolver, TYPE, DERIV)
 
 namespace exotica
 {
+/// Solver phases whose durations are recorded, see MotionSolver::GetTimings.
+enum class SolverPhase
+{
+    ProblemUpdate,
+    BackwardPass,
+    LineSearch,
+    Sweep,
+    NumPhases
+};
+
 class MotionSolver : public Object, Uncopyable, public virtual InstantiableBase
 {
 public:
@@ -57,10 +71,74 @@ public:
     int GetNumberOfMaxIterations() { return max_iterations_; }
     double GetPlanningTime() { return planning_time_; }
 
+    /// \brief Sets the wall-clock time budget of each call to Solve in seconds (0: unlimited).
+    /// Solvers check the budget between iterations and line-search steps and return the best solution found so far
+    /// with TerminationCriterion::TimeLimit once it is exceeded.
+    void SetMaxPlanningTime(double max_planning_time)
+    {
+        if (max_planning_time < 0.0) ThrowPretty("Maximum planning time needs to be non-negative.");
+        max_planning_time_ = max_planning_time;
+    }
+    double GetMaxPlanningTime() const { return max_planning_time_; }
+
+    /// \brief Durations in seconds of the solver phases (e.g. "BackwardPass", "LineSearch", "ProblemUpdate"), one sample per occurrence, oldest first.
+    /// Samples accumulate over calls to Solve until ClearTimings is called. Only the most recent GetMaxTimingSamples() samples of each phase are kept.
+    std::map<std::string, std::vector<double>> GetTimings() const;
+    /// \brief Histogram of the timing samples of a phase with num_bins equal bins between the shortest and longest sample.
+    /// @return Bin counts and the num_bins + 1 bin edges.
+    std::pair<Eigen::VectorXi, Eigen::VectorXd> GetTimingHistogram(const std::string& phase, int num_bins = 10) const;
+    void ClearTimings();
+
+    /// \brief Sets the number of timing samples kept per phase (0: timings are not recorded). Clears the recorded timings.
+    void SetMaxTimingSamples(int max_timing_samples);
+    int GetMaxTimingSamples() const { return max_timing_samples_; }
+
+    static const char* GetPhaseName(SolverPhase phase);
+
 protected:
+    /// \brief Whether the time budget set by SetMaxPlanningTime has been used up since planning_timer was started.
+    bool IsTimeBudgetExceeded(const Timer& planning_timer) const
+    {
+        return max_planning_time_ > 0.0 && planning_timer.GetDuration() >= max_planning_time_;
+    }
+    /// \brief Ends the iterations of a solver once the time budget is used up: sets the termination criterion of the problem
+    /// to TimeLimit and reports the number of completed iterations in debug mode.
+    /// @return Whether the time budget is used up.
+    bool CheckTimeBudget(const Timer& planning_timer, int iterations);
+    /// \brief Caps a solver-specific timeout in seconds by the time budget set with SetMaxPlanningTime.
+    double CapTimeout(double timeout) const
+    {
+        return max_planning_time_ > 0.0 ? std::min(timeout, max_planning_time_) : timeout;
+    }
+    void RecordTiming(SolverPhase phase, double duration)
+    {
+        if (max_timing_samples_ == 0) return;
+        TimingSamples& timing = timings_[static_cast<int>(phase)];
+        if (timing.samples.size() < static_cast<std::size_t>(max_timing_samples_))
+        {
+            timing.samples.push_back(duration);
+        }
+        else
+        {
+            // Ring buffer: overwrite the oldest sample
+            timing.samples[timing.oldest] = duration;
+            timing.oldest = (timing.oldest + 1) % timing.samples.size();
+        }
+    }
+
     PlanningProblemPtr problem_;
     double planning_time_ = -1;
     int max_iterations_ = 100;
+    double max_planning_time_ = 0.0;
+
+    /// Timing samples of a phase, a ring buffer of at most max_timing_samples_ entries
+    struct TimingSamples
+    {
+        std::vector<double> samples;
+        std::size_t oldest = 0;  ///< Index of the oldest sample once the buffer is full
+    };
+    std::array<TimingSamples, static_cast<int>(SolverPhase::NumPhases)> timings_;
+    int max_timing_samples_ = 10000;
 };
 
 typedef std::shared_ptr<exotica::MotionSolver> MotionSolverPtr;
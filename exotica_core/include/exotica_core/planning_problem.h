@@ -57,7 +57,8 @@ enum class TerminationCriterion
     GradientTolerance,
     Divergence,
     UserDefined,
-    Convergence
+    Convergence,
+    TimeLimit
     // Condition,
 };
 
@@ -82,13 +83,29 @@ public:
 
     virtual void PreUpdate();
     unsigned int GetNumberOfProblemUpdates() const { return number_of_problem_updates_; }
-    void ResetNumberOfProblemUpdates() { number_of_problem_updates_ = 0; }
+    /// \brief Returns the number of updates which reused the kinematics of the previous update at the same state.
+    unsigned int GetNumberOfProblemUpdateCacheHits() const { return number_of_problem_update_cache_hits_; }
+    /// \brief Returns the fraction of updates which reused the kinematics of the previous update.
+    double GetProblemUpdateCacheHitRate() const;
+    void ResetNumberOfProblemUpdates()
+    {
+        number_of_problem_updates_ = 0;
+        number_of_problem_update_cache_hits_ = 0;
+    }
+    bool GetUseUpdateCache() const { return use_update_cache_; }
+    void SetUseUpdateCache(bool use_update_cache);
+    /// \brief Forces the next update to re-evaluate the task maps, e.g., after changing the parameters of a task map directly.
+    void InvalidateUpdateCache() { update_cache_valid_ = false; }
     std::pair<std::vector<double>, std::vector<double>> GetCostEvolution() const;
     int GetNumberOfIterations() const;
     double GetCostEvolution(int index) const;
     void ResetCostEvolution(size_t size);
     void SetCostEvolution(int index, double value);
     KinematicRequestFlags GetFlags() const { return flags_; }
+    /// \brief Returns the wall-clock time in seconds it took to create and instantiate the problem in Setup::CreateProblem.
+    double GetConstructionTime() const { return construction_time_; }
+    /// \brief Returns the change in resident memory of the process in bytes while the problem was created in Setup::CreateProblem.
+    long GetConstructionMemory() const { return construction_memory_; }
     /// \brief Evaluates whether the problem is valid.
     virtual bool IsValid() { ThrowNamed("Not implemented"); };
     TerminationCriterion termination_criterion;
@@ -99,6 +116,12 @@ public:
     [[deprecated("Replaced by Scene::get_num_controls")]] int get_num_controls() const;
 
 protected:
+    /// \brief Returns true if the problem was last updated at x and neither the kinematic tree nor the problem changed since.
+    /// In this case the scene and the task maps do not need to be updated again and a cache hit is counted.
+    bool IsUpdateCached(Eigen::VectorXdRefConst x);
+    /// \brief Marks the problem as updated at x. To be called after the scene and the task maps have been updated.
+    void SetUpdateCache(Eigen::VectorXdRefConst x);
+
     void UpdateTaskKinematics(std::shared_ptr<KinematicResponse> response);
     void UpdateMultipleTaskKinematics(std::vector<std::shared_ptr<KinematicResponse>> responses);
 
@@ -109,7 +132,18 @@ protected:
     Eigen::VectorXd start_state_;
     double t_start{0.0};                         // Start time, e.g. used for time-indexed references in the Scene
     unsigned int number_of_problem_updates_{0};  // Stores number of times the problem has been updated
+    unsigned int number_of_problem_update_cache_hits_{0};  // Stores number of updates skipped as the problem was already updated at the same state
     std::vector<std::pair<std::chrono::high_resolution_clock::time_point, double>> cost_evolution_;
+
+private:
+    friend class Setup;
+    double construction_time_ = 0.0;
+    long construction_memory_ = 0;
+
+    bool use_update_cache_ = true;
+    bool update_cache_valid_ = false;
+    Eigen::VectorXd update_cache_x_;
+    unsigned int update_cache_revision_ = 0;
 };
 
 typedef Factory<PlanningProblem> PlanningProblemFac;
@@ -173,11 +173,19 @@ public:
     /// \brief Returns the inequality constraint values for the entire trajectory.
     Eigen::VectorXd GetInequality() const;
 
-    /// \brief Returns the sparse Jacobian matrix of the equality constraints over the entire trajectory.
-    Eigen::SparseMatrix<double> GetEqualityJacobian() const;
+    /// \brief Returns the sparse (CSR) Jacobian matrix of the equality constraints over the entire trajectory.
+    /// The sparsity pattern is fixed between calls to PreUpdate; only the values are refreshed after an update.
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& GetEqualityJacobian() const;
 
-    /// \brief Returns the sparse Jacobian matrix of the inequality constraints over the entire trajectory.
-    Eigen::SparseMatrix<double> GetInequalityJacobian() const;
+    /// \brief Returns the sparse (CSR) Jacobian matrix of the inequality constraints over the entire trajectory.
+    /// The sparsity pattern is fixed between calls to PreUpdate; only the values are refreshed after an update.
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& GetInequalityJacobian() const;
+
+    /// \brief Returns the (row, column) indices of the structural non-zeros of the equality constraint Jacobian, in the order of its values.
+    Eigen::Matrix<int, Eigen::Dynamic, 2> GetEqualityJacobianStructure() const;
+
+    /// \brief Returns the (row, column) indices of the structural non-zeros of the inequality constraint Jacobian, in the order of its values.
+    Eigen::Matrix<int, Eigen::Dynamic, 2> GetInequalityJacobianStructure() const;
 
     /// \brief Returns a vector of triplets to fill a sparse Jacobian for the equality constraints.
     std::vector<Eigen::Triplet<double>> GetEqualityJacobianTriplets() const;
@@ -241,6 +249,18 @@ public:
 protected:
     virtual void ReinitializeVariables();
 
+    /// \brief Updates the task spaces at a timestep from the kinematics stored in Phi, jacobian and hessian.
+    virtual void UpdateTaskSpaces(int t);
+
+    /// \brief Builds the CSR pattern of a constraint Jacobian over the trajectory from the active (timestep, task) pairs.
+    void InitializeConstraintJacobian(const TimeIndexedTask& task, const std::vector<std::pair<int, int>>& active_constraints, int dimension, Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian) const;
+
+    /// \brief Writes the current Jacobians of the active constraints into the values of a pattern built by InitializeConstraintJacobian.
+    void RefreshConstraintJacobian(const TimeIndexedTask& task, const std::vector<std::pair<int, int>>& active_constraints, Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian) const;
+
+    static Eigen::Matrix<int, Eigen::Dynamic, 2> GetSparsityStructure(const Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian);
+    static std::vector<Eigen::Triplet<double>> GetTriplets(const Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian);
+
     /// \brief Checks the desired time index for bounds and supports -1 indexing.
     inline void ValidateTimeIndex(int& t_in) const
     {
@@ -280,6 +300,12 @@ protected:
     int active_nonlinear_equality_constraints_dimension_ = 0;
     int active_nonlinear_inequality_constraints_dimension_ = 0;
 
+    // Sparse constraint Jacobians: the pattern is built in PreUpdate from the active constraints, the values are refreshed lazily after an update.
+    mutable Eigen::SparseMatrix<double, Eigen::RowMajor> equality_jacobian_;
+    mutable Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_jacobian_;
+    mutable bool equality_jacobian_outdated_ = true;
+    mutable bool inequality_jacobian_outdated_ = true;
+
     // Terms related with the joint velocity constraint - the Jacobian triplets are constant so can be cached.
     int joint_velocity_constraint_dimension_ = 0;
     std::vector<Eigen::Triplet<double>> joint_velocity_constraint_jacobian_triplets_;
@@ -59,6 +59,9 @@ public:
     void PreUpdate() override;
     void Update(Eigen::VectorXdRefConst u, int t);
     void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRefConst u, int t);
+    /// \brief Updates knot t like Update(x, u, t), but uses the successor state x_next = Simulate(x, u, tau) computed by the caller.
+    ///        This allows solvers to simulate independent shooting intervals in parallel.
+    void Update(Eigen::VectorXdRefConst x, Eigen::VectorXdRefConst u, Eigen::VectorXdRefConst x_next, int t);
     void UpdateTerminalState(Eigen::VectorXdRefConst x);  // Updates the terminal state and recomputes the terminal cost - this is required e.g. when considering defects in the dynamics
 
     const int& get_T() const;     ///< Returns the number of timesteps in the state trajectory.
@@ -74,6 +77,11 @@ public:
     Eigen::VectorXd get_U(int t) const;        ///< Returns the control state at time t
     void set_U(Eigen::MatrixXdRefConst U_in);  ///< Sets the control trajectory U (can be used as the initial guess)
 
+    /// \brief Advances the horizon by one knot for receding-horizon control (MPC).
+    ///        X and U are shifted in place towards the start, with the last state and control repeated, the start time advances by tau
+    ///        and x_measured becomes the start state. Targets and weights are not shifted.
+    void ShiftHorizon(Eigen::VectorXdRefConst x_measured);
+
     const Eigen::MatrixXd& get_X_star() const;           ///< Returns the target state trajectory X
     void set_X_star(Eigen::MatrixXdRefConst X_star_in);  ///< Sets the target state trajectory X
 
@@ -108,18 +116,18 @@ public:
     double GetStateCost(int t) const;
     double GetControlCost(int t) const;
 
-    Eigen::VectorXd GetStateCostJacobian(int t);    ///< lx
-    Eigen::VectorXd GetControlCostJacobian(int t);  ///< lu
-    Eigen::MatrixXd GetStateCostHessian(int t);     ///< lxx
-    Eigen::MatrixXd GetControlCostHessian(int t);   ///< luu
-    Eigen::MatrixXd GetStateControlCostHessian()
-    {
-        // NOTE: For quadratic costs this is always 0
-        //  thus we return a scalar of size 1 and value 0
-        // This is the same as returning an (int)0 but for type safety
-        //  we instantiate eigen vectors instead.
-        return Eigen::MatrixXd::Zero(scene_->get_num_controls(), scene_->get_num_state_derivative());
-    };  ///< lxu == lux
+    // The cost derivatives are evaluated at the current X and U into preallocated per-knot storage and returned by reference.
+    // The references stay valid until the problem is reinitialized; their content is overwritten by the next call for the same knot.
+    const Eigen::VectorXd& GetStateCostJacobian(int t);    ///< lx
+    const Eigen::VectorXd& GetControlCostJacobian(int t);  ///< lu
+    const Eigen::MatrixXd& GetStateCostHessian(int t);     ///< lxx
+    const Eigen::MatrixXd& GetControlCostHessian(int t);   ///< luu
+    const Eigen::MatrixXd& GetStateControlCostHessian() const { return state_control_cost_hessian_; }  ///< lxu == lux
+
+    /// \brief Whether the cost contains terms coupling state and control. If not, GetStateControlCostHessian is zero and solvers can skip it.
+    bool HasStateControlCostCoupling() const { return false; }
+    /// \brief Whether the control cost Hessian is independent of the knot and the controls, i.e., the control cost is quadratic.
+    bool IsControlCostHessianConstant() const { return loss_type_ == ControlCostLossTermType::L2; }
 
     void OnSolverIterationEnd()
     {
@@ -183,6 +191,7 @@ protected:
     void ReinitializeVariables();
 
     void UpdateTaskMaps(Eigen::VectorXdRefConst x, Eigen::VectorXdRefConst u, int t);
+    void UpdateShootingInterval(Eigen::VectorXdRefConst x_in, Eigen::VectorXdRefConst u_in, const Eigen::Ref<const Eigen::VectorXd>* x_next, int t);
 
     int T_;       ///< Number of time steps
     double tau_;  ///< Time step duration
@@ -205,10 +214,11 @@ protected:
     std::vector<Eigen::MatrixXd> dxdiff_;
     std::vector<Eigen::VectorXd> state_cost_jacobian_;
     std::vector<Eigen::MatrixXd> state_cost_hessian_;
-    std::vector<Eigen::VectorXd> general_cost_jacobian_;
-    std::vector<Eigen::MatrixXd> general_cost_hessian_;
     std::vector<Eigen::VectorXd> control_cost_jacobian_;
     std::vector<Eigen::MatrixXd> control_cost_hessian_;
+    Eigen::MatrixXd state_control_cost_hessian_;  ///< Always zero as the cost has no state-control coupling terms
+    Eigen::VectorXd weighted_ydiff_;              ///< S * ydiff of the general cost
+    Eigen::VectorXd weighted_xdiff_;              ///< Q * xdiff of the state cost
 
     std::vector<std::shared_ptr<KinematicResponse>> kinematic_solutions_;
 
@@ -75,8 +75,10 @@ public:
     double GetRhoNEQ(const std::string& task_name, int t = 0) = delete;
     Eigen::VectorXd GetEquality() const = delete;
     Eigen::VectorXd GetInequality() const = delete;
-    Eigen::SparseMatrix<double> GetEqualityJacobian() const = delete;
-    Eigen::SparseMatrix<double> GetInequalityJacobian() const = delete;
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& GetEqualityJacobian() const = delete;
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& GetInequalityJacobian() const = delete;
+    Eigen::Matrix<int, Eigen::Dynamic, 2> GetEqualityJacobianStructure() const = delete;
+    Eigen::Matrix<int, Eigen::Dynamic, 2> GetInequalityJacobianStructure() const = delete;
     std::vector<Eigen::Triplet<double>> GetEqualityJacobianTriplets() const = delete;
     int get_active_nonlinear_equality_constraints_dimension() const = delete;
     Eigen::VectorXd GetEquality(int t) const = delete;
@@ -94,6 +96,7 @@ public:
 
 private:
     void ReinitializeVariables() override;
+    void UpdateTaskSpaces(int t) override;
 };
 typedef std::shared_ptr<exotica::UnconstrainedTimeIndexedProblem> UnconstrainedTimeIndexedProblemPtr;
 }  // namespace exotica
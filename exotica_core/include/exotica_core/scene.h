@@ -104,6 +104,10 @@ public:
     std::shared_ptr<Trajectory> GetTrajectory(const std::string& link);
     void RemoveTrajectory(const std::string& link);
 
+    /// \brief Precomputes the poses of all trajectory generators (including ones added later) at times offset + k * dt.
+    /// Time-indexed problems set this to their time grid. A non-positive dt disables sampling.
+    void SetTrajectorySampling(double dt, double offset = 0.0);
+
     /// \brief Updates exotica scene object frames from the MoveIt scene.
     void UpdateSceneFrames();
     ///
@@ -160,6 +164,12 @@ public:
     std::string GetScene();
     void CleanScene();
 
+    /// @brief Hash of all objects that are not part of the robot (environment and attached objects).
+    /// @details Covers the name, parent, relative pose and geometry of each object. The hash only changes when the world changes,
+    ///          so it can be used to key results (e.g. roadmaps) that remain valid for as long as the world is static.
+    /// @return Hash of the world, stable across processes.
+    std::size_t GetWorldHash() const;
+
     /// @brief Whether the collision scene transforms get updated on every scene update.
     /// @return Whether collision scene transforms are force updated on every scene update.
     bool AlwaysUpdatesCollisionScene() const { return force_collision_; }
@@ -174,6 +184,8 @@ public:
     const std::map<std::string, std::vector<std::string>>& GetControlledJointToCollisionLinkMap() const { return controlled_joint_to_collision_link_map_; };
     /// @brief Returns world links that are to be excluded from collision checking.
     const std::set<std::string>& get_world_links_to_exclude_from_collision_scene() const { return world_links_to_exclude_from_collision_scene_; }
+    /// @brief Returns the time passed to the last Update or SetModelState call.
+    double get_current_time() const { return current_time_; }
     int get_num_positions() const;
     int get_num_velocities() const;
     int get_num_controls() const;
@@ -221,9 +233,14 @@ private:
     std::vector<std::shared_ptr<KinematicElement>> custom_links_;
 
     std::map<std::string, std::pair<std::weak_ptr<KinematicElement>, std::shared_ptr<Trajectory>>> trajectory_generators_;
+    double trajectory_sample_dt_ = 0.0;
+    double trajectory_sample_offset_ = 0.0;
 
     bool force_collision_;
 
+    /// Time of the last Update or SetModelState call
+    double current_time_ = 0.0;
+
     /// \brief Mapping between model link names and collision links.
     std::map<std::string, std::vector<std::string>> model_link_to_collision_link_map_;
     std::map<std::string, std::vector<std::shared_ptr<KinematicElement>>> model_link_to_collision_element_map_;
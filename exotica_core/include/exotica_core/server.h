@@ -30,9 +30,15 @@
 #ifndef EXOTICA_CORE_SERVER_H_
 #define EXOTICA_CORE_SERVER_H_
 
+#include <functional>
 #include <map>
+#include <mutex>
+#include <tuple>
 #include <vector>
 
+#include <Eigen/Dense>
+#include <geometric_shapes/shapes.h>
+#include <moveit/planning_scene/planning_scene.h>
 #include <moveit/robot_model_loader/robot_model_loader.h>
 #include <ros/ros.h>
 #include <tf/transform_broadcaster.h>
@@ -84,6 +90,31 @@ public:
     /// @return robot model
     robot_model::RobotModelConstPtr GetModel(const std::string &path, const std::string &urdf = "", const std::string &srdf = "");
 
+    /// \brief Get a new planning scene from a scene template
+    /// The template holds the robot model and the geometry of the scene files. It is created on first use and shared
+    /// by all planning scenes created from the same model and scene files. Changes to the returned planning scene are
+    /// stored on top of the template (copy-on-write) and do not affect other scenes.
+    /// @param path Robot model name
+    /// @param model Robot model
+    /// @param scene_files Scene files to load into the template, separated by semicolons
+    /// @return New planning scene
+    planning_scene::PlanningScenePtr GetPlanningScene(const std::string &path, robot_model::RobotModelConstPtr model, const std::string &scene_files = "");
+
+    /// \brief Get a mesh loaded from a resource
+    /// Meshes are loaded once and shared, i.e., the returned mesh must not be modified.
+    /// @param resource Mesh resource path
+    /// @param scale Scale applied to the mesh vertices
+    /// @return Mesh or nullptr if the resource could not be loaded
+    shapes::ShapeConstPtr GetMesh(const std::string &resource, const Eigen::Vector3d &scale = Eigen::Vector3d::Ones());
+
+    /// \brief Clears the cached robot models, scene templates, meshes, and registered caches, e.g., after the files changed on disk
+    void ClearCache();
+
+    /// \brief Registers a cache held outside of the server, e.g., by a plugin, to be cleared by ClearCache
+    /// @param name Unique name of the cache, registering the same name again replaces the previous function
+    /// @param clear Function clearing the cache
+    void RegisterCache(const std::string &name, std::function<void()> clear);
+
     /// \brief Get the name of ther server
     /// @return Server name
     std::string GetName();
@@ -183,6 +214,18 @@ private:
 
     /// \brief Robot model cache
     std::map<std::string, robot_model::RobotModelPtr> robot_models_;
+
+    /// \brief Scene template cache, indexed by robot model name and scene files
+    std::map<std::pair<std::string, std::string>, planning_scene::PlanningSceneConstPtr> planning_scene_templates_;
+
+    /// \brief Mesh cache, indexed by resource path and scale
+    std::map<std::tuple<std::string, double, double, double>, shapes::ShapeConstPtr> meshes_;
+
+    /// \brief Functions clearing the caches registered with RegisterCache, indexed by name
+    std::map<std::string, std::function<void()>> registered_caches_;
+
+    /// \brief Guards the scene template, mesh, and registered caches
+    std::mutex cache_mutex_;
 };
 
 typedef std::shared_ptr<Server> ServerPtr;
@@ -39,6 +39,7 @@
 #include <exotica_core/object.h>
 #include <exotica_core/planning_problem.h>
 #include <exotica_core/property.h>
+#include <exotica_core/tools.h>
 
 #include <pluginlib/class_loader.h>
 
@@ -81,8 +82,13 @@ public:
     }
     static std::shared_ptr<exotica::PlanningProblem> CreateProblem(const Initializer& init)
     {
+        Timer timer;
+        const std::size_t memory = GetResidentSetSize();
         std::shared_ptr<exotica::PlanningProblem> ret = Instance()->problems_.CreateInstance(init.GetName());
         ret->InstantiateInternal(init);
+        ret->construction_time_ = timer.GetDuration();
+        ret->construction_memory_ = static_cast<long>(GetResidentSetSize()) - static_cast<long>(memory);
+        if (ret->debug_) HIGHLIGHT_NAMED(ret->GetObjectName(), "Constructed in " << ret->construction_time_ * 1e3 << "ms, resident memory changed by " << ret->construction_memory_ / 1024 << "kB");
         return ret;
     }
 
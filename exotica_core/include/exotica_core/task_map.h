@@ -49,6 +49,14 @@
 
 namespace exotica
 {
+/// Finite difference scheme used by TaskMap::FiniteDifferenceJacobian.
+enum class FiniteDifferenceMethod
+{
+    Forward,   ///< (phi(q + h) - phi(q)) / h
+    Backward,  ///< (phi(q) - phi(q - h)) / h
+    Central    ///< (phi(q + h) - phi(q - h)) / 2h
+};
+
 class TaskMap : public Object, Uncopyable, public virtual InstantiableBase
 {
 public:
@@ -74,6 +82,20 @@ public:
     virtual void PreUpdate() {}
     virtual std::vector<TaskVectorEntry> GetLieGroupIndices() { return std::vector<TaskVectorEntry>(); }
     std::vector<KinematicFrameRequest> GetFrames() const;
+    /// \brief Additional kinematic quantities the map needs from the KinematicTree (e.g. KIN_COM).
+    virtual KinematicRequestFlags GetKinematicRequestFlags() const { return KIN_FK; }
+
+    /// \brief Approximates the Jacobian of Update(q, phi) by finite differences. Used by Update(q, phi, jacobian) unless the map overrides it.
+    /// The kinematic state at q is restored on return.
+    void FiniteDifferenceJacobian(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian);
+    FiniteDifferenceMethod GetFiniteDifferenceMethod() const { return finite_difference_method_; }
+    void SetFiniteDifferenceMethod(FiniteDifferenceMethod method) { finite_difference_method_ = method; }
+    void SetFiniteDifferenceMethod(const std::string& method);
+    double GetFiniteDifferenceStep() const { return finite_difference_step_; }
+    void SetFiniteDifferenceStep(double step);
+
+    /// \brief Name of the profiler zone that the planning problems open around Update(), "TaskMap::Update/<name>".
+    const char* GetProfilerZoneName() const { return profiler_zone_name_; }
 
     std::vector<KinematicSolution> kinematics = std::vector<KinematicSolution>(1);
     int id = -1;
@@ -86,6 +108,20 @@ public:
 protected:
     std::vector<KinematicFrameRequest> frames_;
     ScenePtr scene_ = nullptr;
+
+    FiniteDifferenceMethod finite_difference_method_ = FiniteDifferenceMethod::Backward;
+    double finite_difference_step_ = 1e-6;
+    bool finite_difference_subtree_updates_ = true;  ///< Only recompute the kinematic subtree below the perturbed joint
+
+private:
+    /// Evaluates phi with the i-th joint set to value and all other joints at q.
+    void UpdatePerturbed(Eigen::VectorXdRefConst q, int i, double value, bool subtree_update, Eigen::VectorXdRef phi);
+
+    const char* profiler_zone_name_ = "TaskMap::Update";
+
+    Eigen::VectorXd finite_difference_q_;
+    Eigen::VectorXd finite_difference_phi_plus_;
+    Eigen::VectorXd finite_difference_phi_minus_;
 };
 
 // Typedefines for some common functionality
@@ -120,7 +120,7 @@ struct TimeIndexedTask : public Task
     std::vector<Eigen::MatrixXd> jacobian;
     std::vector<Eigen::MatrixXd> dPhi_dx;
     std::vector<Eigen::MatrixXd> dPhi_du;
-    std::vector<Eigen::MatrixXd> S;
+    std::vector<Eigen::DiagonalMatrix<double, Eigen::Dynamic>> S;  ///< Diagonal task weights (rho of each task on the rows of its Jacobian) for each time step
     int T;
 };
 
@@ -151,7 +151,7 @@ struct EndPoseTask : public Task
     TaskSpaceVector Phi;
     Eigen::MatrixXd jacobian;
     Hessian hessian;
-    Eigen::MatrixXd S;
+    Eigen::DiagonalMatrix<double, Eigen::Dynamic> S;  ///< Diagonal task weights (rho of each task on the rows of its Jacobian)
 };
 
 struct SamplingTask : public Task
@@ -173,7 +173,7 @@ struct SamplingTask : public Task
     TaskSpaceVector y;
     Eigen::VectorXd ydiff;
     TaskSpaceVector Phi;
-    Eigen::MatrixXd S;
+    Eigen::DiagonalMatrix<double, Eigen::Dynamic> S;  ///< Diagonal task weights (rho of each task on the rows of its Jacobian)
 };
 }  // namespace exotica
 
@@ -37,6 +37,7 @@
 #include <exotica_core/tools/conversions.h>
 #include <exotica_core/tools/exception.h>
 #include <exotica_core/tools/printable.h>
+#include <exotica_core/tools/profiler.h>
 #include <exotica_core/tools/timer.h>
 #include <exotica_core/tools/uncopyable.h>
 #include <exotica_core/version.h>
@@ -118,6 +119,9 @@ std::string LoadFile(const std::string& path);
 
 bool PathExists(const std::string& path);
 
+/// \brief Returns the resident set size of the process in bytes, or 0 if it is not available on this platform.
+std::size_t GetResidentSetSize();
+
 /// \brief Argument position.
 ///        Used as parameter to refer to an argument.
 enum ArgumentPosition
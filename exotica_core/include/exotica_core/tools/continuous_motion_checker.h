@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_CONTINUOUS_MOTION_CHECKER_H_
+#define EXOTICA_CORE_CONTINUOUS_MOTION_CHECKER_H_
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+#include <exotica_core/scene.h>
+
+namespace exotica
+{
+/// \brief Collision checking of straight joint space motions by conservative advancement.
+///
+/// Any point of the robot moves at most GetDisplacementBound(dx) for a joint space motion dx. The bound is the sum of
+/// per-joint lever arms, i.e. the largest distance between a joint axis and any point of the collision geometry
+/// downstream of that joint (after scaling and padding), and holds for all configurations.
+/// Starting from the first state, the motion is advanced by the fraction that is guaranteed to be collision free given
+/// the current distance to the environment (and between robot links). Distance queries only consider pairs whose
+/// bounding volumes are closer than the remaining displacement, so a motion far from any obstacle costs a single query.
+///
+/// Requires a collision scene implementing GetRobotToWorldCollisionDistance (and GetRobotToRobotCollisionDistance when
+/// checking self-collisions). The environment is assumed to move no faster than max_world_speed.
+class ContinuousMotionChecker
+{
+public:
+    /// @param scene            Scene whose robot and collision scene are checked.
+    /// @param self_collision   Whether to check collisions between robot links.
+    /// @param tolerance        Distance [m] below which the robot is considered in contact.
+    /// @param max_world_speed  Upper bound on the speed [m/s] of moving world objects, used when the motion spans time.
+    ContinuousMotionChecker(ScenePtr scene, bool self_collision = true, double tolerance = 1e-3, double max_world_speed = 0.0);
+
+    /// \brief Recomputes the lever arms, e.g. after attaching objects to the robot.
+    void UpdateLeverArms();
+
+    /// \brief Checks the straight line motion from x1 at time t1 to x2 at time t2. The first state is assumed to be valid.
+    /// @param[out] last_valid  Fraction of the motion up to which it is collision free, i.e. the first time of contact within the tolerance. 1 if the motion is valid.
+    /// @return Whether the motion is collision free.
+    bool CheckMotion(Eigen::VectorXdRefConst x1, Eigen::VectorXdRefConst x2, double& last_valid, double t1 = 0.0, double t2 = 0.0);
+
+    /// \brief Upper bound on the distance moved by any point of the robot for the joint space displacement dx.
+    double GetDisplacementBound(Eigen::VectorXdRefConst dx) const { return lever_arms_.dot(dx.cwiseAbs()); }
+    const Eigen::VectorXd& GetLeverArms() const { return lever_arms_; }
+
+    /// \brief Number of distance queries performed by the last call to CheckMotion.
+    int GetNumberOfDistanceQueries() const { return num_distance_queries_; }
+
+private:
+    double GetMinimumDistance(bool self, double margin);
+
+    ScenePtr scene_;
+    bool self_collision_;
+    double tolerance_;
+    double max_world_speed_;
+    Eigen::VectorXd lever_arms_;  ///< Per controlled joint, [m/rad] for revolute and 1 for prismatic joints
+    Eigen::VectorXd x_;           ///< Interpolated state
+    int num_distance_queries_ = 0;
+};
+
+typedef std::shared_ptr<ContinuousMotionChecker> ContinuousMotionCheckerPtr;
+}  // namespace exotica
+
+#endif  // EXOTICA_CORE_CONTINUOUS_MOTION_CHECKER_H_
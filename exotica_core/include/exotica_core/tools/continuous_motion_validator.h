@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_CONTINUOUS_MOTION_VALIDATOR_H_
+#define EXOTICA_CORE_CONTINUOUS_MOTION_VALIDATOR_H_
+
+#include <functional>
+#include <utility>
+
+#include <exotica_core/tools/continuous_motion_checker.h>
+
+#include <ompl/base/MotionValidator.h>
+#include <ompl/base/SpaceInformation.h>
+
+namespace exotica
+{
+/// \brief Validates OMPL motions with a ContinuousMotionChecker instead of sampling states along the motion.
+/// Collisions are checked continuously, the remaining constraints of the problem are checked at the end state.
+///
+/// Header-only so that exotica_core does not depend on OMPL; include it from solvers that do.
+class OMPLContinuousMotionValidator : public ompl::base::MotionValidator
+{
+public:
+    /// Converts an OMPL state to the configuration and time checked by the ContinuousMotionChecker.
+    typedef std::function<void(const ompl::base::State *, Eigen::VectorXd &, double &)> StateConversion;
+
+    OMPLContinuousMotionValidator(const ompl::base::SpaceInformationPtr &si, const ContinuousMotionCheckerPtr &checker, const StateConversion &to_exotica_state) : ompl::base::MotionValidator(si), checker_(checker), to_exotica_state_(to_exotica_state)
+    {
+    }
+
+    bool checkMotion(const ompl::base::State *s1, const ompl::base::State *s2) const override
+    {
+        double last_valid;
+        if (!si_->isValid(s2))
+        {
+            ++invalid_;
+            return false;
+        }
+
+        to_exotica_state_(s1, q1_, t1_);
+        to_exotica_state_(s2, q2_, t2_);
+        if (!checker_->CheckMotion(q1_, q2_, last_valid, t1_, t2_))
+        {
+            ++invalid_;
+            return false;
+        }
+        ++valid_;
+        return true;
+    }
+
+    /// \brief Checks the motion and reports the last valid state, which is the first time of contact when in collision.
+    bool checkMotion(const ompl::base::State *s1, const ompl::base::State *s2, std::pair<ompl::base::State *, double> &last_valid) const override
+    {
+        to_exotica_state_(s1, q1_, t1_);
+        to_exotica_state_(s2, q2_, t2_);
+        bool result = checker_->CheckMotion(q1_, q2_, last_valid.second, t1_, t2_);
+        if (result && !si_->isValid(s2))
+        {
+            // Only the end state violates the problem, stop one segment short of it as the discrete validator does
+            const unsigned int segments = si_->getStateSpace()->validSegmentCount(s1, s2);
+            last_valid.second = segments > 1 ? static_cast<double>(segments - 1) / segments : 0.0;
+            result = false;
+        }
+
+        if (result)
+        {
+            ++valid_;
+        }
+        else
+        {
+            if (last_valid.first) si_->getStateSpace()->interpolate(s1, s2, last_valid.second, last_valid.first);
+            ++invalid_;
+        }
+        return result;
+    }
+
+protected:
+    ContinuousMotionCheckerPtr checker_;
+    StateConversion to_exotica_state_;
+    mutable Eigen::VectorXd q1_;
+    mutable Eigen::VectorXd q2_;
+    mutable double t1_ = 0.0;
+    mutable double t2_ = 0.0;
+};
+}  // namespace exotica
+
+#endif  // EXOTICA_CORE_CONTINUOUS_MOTION_VALIDATOR_H_
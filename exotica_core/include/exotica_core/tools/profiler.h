@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_PROFILER_H_
+#define EXOTICA_CORE_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <exotica_core/tools/uncopyable.h>
+
+namespace exotica
+{
+/// Aggregated timings of one profiler zone across all threads.
+struct ProfilerZoneStatistics
+{
+    std::string name;
+    std::size_t calls = 0;
+    double total = 0.0;  ///< Inclusive time spent in the zone [s]
+    double min = 0.0;    ///< Shortest call [s]
+    double max = 0.0;    ///< Longest call [s]
+
+    inline double Mean() const { return calls > 0 ? total / static_cast<double>(calls) : 0.0; }
+};
+
+/// \brief Hierarchical scoped profiler.
+///
+/// Zones are opened with EXOTICA_PROFILE_ZONE and closed at the end of the enclosing scope.
+/// Every thread records into its own ring buffer of the most recent events and its own table
+/// of aggregated statistics, so recording only takes an uncontended lock. Ring buffers grow on
+/// demand up to the buffer size. When a thread exits, its statistics are folded into a shared
+/// table and its events move to a shared buffer holding the most recent events of exited threads.
+/// Zone names must outlive the profiler: use string literals or names returned by Intern().
+///
+/// The zones compile to nothing unless EXOTICA_ENABLE_PROFILER is defined (CMake option of the
+/// same name), in which case recording can still be toggled at runtime with SetEnabled().
+class Profiler : Uncopyable
+{
+public:
+    struct Event
+    {
+        const char* name;
+        std::int64_t begin;  ///< [ns] since the profiler epoch
+        std::int64_t end;    ///< [ns] since the profiler epoch
+        int depth;           ///< Nesting level of the zone within its thread
+    };
+
+    static Profiler& Instance();
+
+    inline bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled);
+
+    /// Number of events kept for the trace per running thread and for all exited threads together.
+    /// Statistics are aggregated over all events regardless.
+    void SetBufferSize(std::size_t size);
+    std::size_t GetBufferSize() const;
+
+    /// Returns a pointer to a unique copy of name that stays valid for the lifetime of the process.
+    static const char* Intern(const std::string& name);
+
+    /// Nanoseconds since the profiler epoch.
+    std::int64_t Now() const;
+
+    /// Opens a zone on the calling thread and returns its depth.
+    int Begin();
+    /// Closes the zone opened by the matching Begin() call.
+    void End(const char* name, std::int64_t begin, int depth);
+
+    /// Statistics of all zones, merged across threads and sorted by descending total time.
+    std::vector<ProfilerZoneStatistics> GetSummary() const;
+    /// Human readable table of GetSummary().
+    std::string GetSummaryTable() const;
+    /// Buffered events in the Chrome trace event format (load in chrome://tracing or Perfetto).
+    std::string GetChromeTrace() const;
+    void ExportChromeTrace(const std::string& file_name) const;
+
+    /// Discards all recorded events and statistics.
+    void Reset();
+
+private:
+    Profiler();
+    struct ThreadBuffer;
+    struct ThreadBufferOwner;
+    ThreadBuffer& GetThreadBuffer();
+    /// Merges the statistics of an exiting thread into retired_ and moves its events to retired_threads_.
+    void RetireThreadBuffer(const std::shared_ptr<ThreadBuffer>& buffer);
+    /// Drops the oldest events of exited threads beyond the buffer size. Requires threads_lock_.
+    void TrimRetiredEvents();
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<std::size_t> buffer_size_;
+    std::chrono::steady_clock::time_point epoch_;
+    mutable std::mutex threads_lock_;
+    std::vector<std::shared_ptr<ThreadBuffer>> threads_;
+    std::shared_ptr<ThreadBuffer> retired_;                      ///< Statistics of exited threads, guarded by threads_lock_
+    std::deque<std::shared_ptr<ThreadBuffer>> retired_threads_;  ///< Events of exited threads in order of exit, guarded by threads_lock_
+    std::size_t retired_events_ = 0;                             ///< Number of events in retired_threads_
+    int next_thread_id_ = 0;
+};
+
+/// RAII profiler zone, see EXOTICA_PROFILE_ZONE.
+class ProfilerZone
+{
+public:
+    explicit ProfilerZone(const char* name) : name_(name)
+    {
+        Profiler& profiler = Profiler::Instance();
+        if (!profiler.IsEnabled()) return;
+        depth_ = profiler.Begin();
+        begin_ = profiler.Now();
+    }
+
+    ~ProfilerZone()
+    {
+        if (depth_ >= 0) Profiler::Instance().End(name_, begin_, depth_);
+    }
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    const char* name_;
+    std::int64_t begin_ = 0;
+    int depth_ = -1;
+};
+}  // namespace exotica
+
+#define EXOTICA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define EXOTICA_PROFILE_CONCAT(a, b) EXOTICA_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef EXOTICA_ENABLE_PROFILER
+/// Profiles the enclosing scope. name must be a string literal or a pointer returned by Profiler::Intern().
+#define EXOTICA_PROFILE_ZONE(name) ::exotica::ProfilerZone EXOTICA_PROFILE_CONCAT(exotica_profiler_zone_, __LINE__)(name)
+#else
+#define EXOTICA_PROFILE_ZONE(name)
+#endif
+
+#endif  // EXOTICA_CORE_PROFILER_H_
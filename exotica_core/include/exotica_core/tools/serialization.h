@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXOTICA_CORE_SERIALIZATION_H_
+#define EXOTICA_CORE_SERIALIZATION_H_
+
+#include <cstddef>
+#include <string>
+
+#include <Eigen/Dense>
+
+#include <exotica_core/property.h>
+#include <exotica_core/trajectory.h>
+
+namespace exotica
+{
+/// \brief Compact binary serialization of initializers, trajectories and matrices (e.g. solutions).
+///
+/// A buffer starts with a 16 byte header (magic "EXOB", format version, record type, reserved) followed by the record.
+/// Strings and arrays are length prefixed. Matrix coefficients are stored column-major and 8-byte aligned relative to
+/// the start of the buffer, so that a memory-mapped buffer can be read without copying using MapMatrix.
+/// Values are stored in host byte order.
+///
+/// Initializer properties keep their C++ type, i.e. a serialized typed initializer is restored without parsing strings.
+/// Supported property types are the ones used by initializer definitions: bool, int, double, std::string,
+/// Eigen::VectorXd, Eigen::Vector2d/3d/4d, Eigen::VectorXi, std::vector<std::string>, std::vector<int>, std::vector<bool>,
+/// exotica::Initializer and std::vector<exotica::Initializer>.
+enum class BinaryRecordType : uint32_t
+{
+    Initializer = 1,
+    Trajectory = 2,
+    Matrix = 3
+};
+
+std::string SerializeInitializer(const Initializer& init);
+Initializer DeserializeInitializer(const std::string& buffer);
+
+/// \brief Serializes the waypoints and radius of a trajectory.
+std::string SerializeTrajectory(const Trajectory& trajectory);
+Trajectory DeserializeTrajectory(const std::string& buffer);
+
+std::string SerializeMatrix(Eigen::MatrixXdRefConst matrix);
+Eigen::MatrixXd DeserializeMatrix(const std::string& buffer);
+
+/// \brief Maps a serialized matrix in place, e.g. from a memory-mapped file. The buffer has to be 8-byte aligned and outlive the map.
+Eigen::Map<const Eigen::MatrixXd> MapMatrix(const char* buffer, std::size_t size);
+
+/// \brief Returns the record type stored in the header of a serialized buffer.
+BinaryRecordType GetBinaryRecordType(const std::string& buffer);
+
+void SaveBinary(const std::string& file_name, const std::string& buffer);
+std::string LoadBinary(const std::string& file_name);
+}  // namespace exotica
+
+#endif  // EXOTICA_CORE_SERIALIZATION_H_
@@ -34,6 +34,7 @@
 #include <Eigen/Dense>
 #include <kdl/trajectory_composite.hpp>
 #include <memory>
+#include <vector>
 
 namespace exotica
 {
@@ -48,15 +49,34 @@ public:
     KDL::Twist GetVelocity(double t);
     KDL::Twist GetAcceleration(double t);
     double GetDuration();
-    Eigen::MatrixXd GetData();
-    double GetRadius();
+    Eigen::MatrixXd GetData() const;
+    double GetRadius() const;
     std::string ToString();
 
+    /// \brief Precomputes the poses on the time grid through offset with spacing dt within the duration of the trajectory.
+    /// GetPosition returns the stored sample when queried on this grid. A non-positive dt disables sampling.
+    /// Changing the offset by a whole multiple of dt keeps the samples. At most MaxSamples poses are stored, later times are interpolated.
+    void SetSampling(double dt, double offset = 0.0);
+
+    static constexpr std::size_t MaxSamples = 100000;
+
 protected:
     void ConstructFromData(Eigen::MatrixXdRefConst data, double radius);
+    KDL::Frame InterpolatePosition(double t) const;
+
     double radius_;
     Eigen::MatrixXd data_;
     std::shared_ptr<KDL::Trajectory_Composite> trajectory_;
+
+    // Precompiled form of the composite trajectory used by GetPosition: every segment moves linearly in time,
+    // i.e. linear interpolation of the position and SLERP of the orientation between consecutive waypoints.
+    Eigen::VectorXd segment_end_time_;  ///< Cumulative end time of each segment (sorted, for binary search)
+    Eigen::Matrix3Xd waypoint_position_;
+    Eigen::Matrix4Xd waypoint_rotation_;  ///< Quaternion coefficients (x, y, z, w) with consecutive waypoints in the same hemisphere
+
+    double sample_dt_ = 0.0;
+    double sample_phase_ = 0.0;  ///< Time of the first sample, in [0, sample_dt_)
+    std::vector<KDL::Frame> samples_;
 };
 }  // namespace exotica
 
@@ -302,7 +302,7 @@ struct ArrayFloat
     ArrayFloat() = default;
     ~ArrayFloat() = default;
 
-    ArrayFloat(double* data_in, unsigned int size)
+    ArrayFloat(const double* data_in, unsigned int size)
     {
         data.resize(size);
         for (unsigned int i = 0; i < size; ++i)
@@ -340,7 +340,7 @@ struct ArrayInt
 {
     ArrayInt() = default;
 
-    ArrayInt(unsigned int* data, unsigned int size)
+    ArrayInt(const unsigned int* data, unsigned int size)
     {
         array.resize(size);
         for (unsigned int i = 0; i < size; ++i)
@@ -358,9 +358,9 @@ struct ArrayInt
 struct GeometryMeshBufferData
 {
     GeometryMeshBufferData() = default;
-    GeometryMeshBufferData(shapes::ShapePtr shape_in)
+    GeometryMeshBufferData(shapes::ShapeConstPtr shape_in)
     {
-        std::shared_ptr<shapes::Mesh> shape = std::static_pointer_cast<shapes::Mesh>(shape_in);
+        std::shared_ptr<const shapes::Mesh> shape = std::static_pointer_cast<const shapes::Mesh>(shape_in);
         attributes.insert(std::make_pair<std::string, ArrayFloat>("position", ArrayFloat(shape->vertices, shape->vertex_count * 3)));
         if (shape->vertex_normals)
             attributes.insert(std::make_pair<std::string, ArrayFloat>("normal", ArrayFloat(shape->vertex_normals, shape->vertex_count * 3)));
@@ -377,7 +377,7 @@ struct GeometryMeshBuffer : Geometry
 {
     GeometryMeshBuffer() : Geometry("BufferGeometry", ""){};
 
-    GeometryMeshBuffer(shapes::ShapePtr shape_in, const std::string& uuid_in = "") : Geometry("BufferGeometry", uuid_in)
+    GeometryMeshBuffer(shapes::ShapeConstPtr shape_in, const std::string& uuid_in = "") : Geometry("BufferGeometry", uuid_in)
     {
         data = GeometryMeshBufferData(shape_in);
     };
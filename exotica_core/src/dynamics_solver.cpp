@@ -75,6 +75,14 @@ void AbstractDynamicsSolver<T, NX, NU>::SetDt(double dt_in)
 
 template <typename T, int NX, int NU>
 Eigen::Matrix<T, NX, 1> AbstractDynamicsSolver<T, NX, NU>::SimulateOneStep(const StateVector& x, const ControlVector& u)
+{
+    StateVector xout(get_num_state());
+    SimulateOneStepInPlace(x, u, xout);
+    return xout;
+}
+
+template <typename T, int NX, int NU>
+void AbstractDynamicsSolver<T, NX, NU>::SimulateOneStepInPlace(const StateVector& x, const ControlVector& u, StateVector& xout)
 {
     switch (integrator_)
     {
@@ -82,11 +90,9 @@ Eigen::Matrix<T, NX, 1> AbstractDynamicsSolver<T, NX, NU>::SimulateOneStep(const
         case Integrator::RK1:
         case Integrator::SymplecticEuler:
         {
-            StateVector xdot = f(x, u);
-            StateVector xout(get_num_state());
-            Integrate(x, xdot, dt_, xout);
-            return xout;
+            Integrate(x, f(x, u), dt_, xout);
         }
+        break;
         // NB: RK2 and RK4 are currently deactivated as we do not yet have correct derivatives for state transitions.
         /*// Explicit trapezoid rule (RK2)
         case Integrator::RK2:
@@ -139,10 +145,9 @@ void AbstractDynamicsSolver<T, NX, NU>::Integrate(const StateVector& x, const St
         // Semi-implicit Euler
         case Integrator::SymplecticEuler:
         {
-            StateVector dx_new(get_num_state_derivative());
-            dx_new.head(num_positions_) = dt * x.tail(num_velocities_) + (dt * dt) * dx.tail(num_velocities_);
-            dx_new.tail(num_velocities_) = dt * dx.tail(num_velocities_);
-            xout.noalias() = x + dx_new;
+            // Coefficient-wise, i.e., allocation-free and safe if xout aliases x
+            xout.head(num_positions_) = x.head(num_positions_) + dt * x.tail(num_velocities_) + (dt * dt) * dx.tail(num_velocities_);
+            xout.tail(num_velocities_) = x.tail(num_velocities_) + dt * dx.tail(num_velocities_);
 
             // xout.tail(num_velocities_).noalias() = x.tail(num_velocities_) + dt * dx.tail(num_velocities_);  // Integrate acceleration to velocity
             // xout.head(num_positions_).noalias() = x.head(num_positions_) + dt * xout.tail(num_velocities_);  // Integrate position with new velocity
@@ -158,13 +163,27 @@ void AbstractDynamicsSolver<T, NX, NU>::Integrate(const StateVector& x, const St
 template <typename T, int NX, int NU>
 Eigen::Matrix<T, NX, 1> AbstractDynamicsSolver<T, NX, NU>::Simulate(const StateVector& x, const ControlVector& u, T t)
 {
-    const int num_timesteps = static_cast<int>(t / dt_);
     StateVector x_t_plus_1 = x;
+    SimulateInPlace(x_t_plus_1, u, t);
+    return x_t_plus_1;
+}
+
+template <typename T, int NX, int NU>
+void AbstractDynamicsSolver<T, NX, NU>::SimulateInPlace(Eigen::Ref<StateVector> x, const Eigen::Ref<const ControlVector>& u, T t)
+{
+    const int num_timesteps = static_cast<int>(t / dt_);
+    if (num_timesteps == 0) return;
+
+    // The buffers only allocate on the first call or when the dimensions change.
+    simulate_x_ = x;
+    simulate_u_ = u;
+    simulate_x_next_.resize(x.rows());
     for (int i = 0; i < num_timesteps; ++i)
     {
-        x_t_plus_1 = SimulateOneStep(x_t_plus_1, u);
+        SimulateOneStepInPlace(simulate_x_, simulate_u_, simulate_x_next_);
+        simulate_x_.swap(simulate_x_next_);
     }
-    return x_t_plus_1;
+    x = simulate_x_;
 }
 
 template <typename T, int NX, int NU>
@@ -339,6 +358,7 @@ Eigen::Matrix<T, NU, 1> AbstractDynamicsSolver<T, NX, NU>::InverseDynamics(const
 template <typename T, int NX, int NU>
 Eigen::Matrix<T, NX, NX> AbstractDynamicsSolver<T, NX, NU>::fx_fd(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("DynamicsSolver::fx_fd");
     const int nx = get_num_state();
     const int ndx = get_num_state_derivative();
 
@@ -378,6 +398,7 @@ Eigen::Matrix<T, NX, NX> AbstractDynamicsSolver<T, NX, NU>::fx(const StateVector
 template <typename T, int NX, int NU>
 Eigen::Matrix<T, NX, NU> AbstractDynamicsSolver<T, NX, NU>::fu_fd(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("DynamicsSolver::fu_fd");
     const int ndx = get_num_state_derivative();
 
     // Finite differences
@@ -406,6 +427,7 @@ Eigen::Matrix<T, NX, NU> AbstractDynamicsSolver<T, NX, NU>::fu(const StateVector
 template <typename T, int NX, int NU>
 void AbstractDynamicsSolver<T, NX, NU>::ComputeDerivatives(const StateVector& x, const ControlVector& u)
 {
+    EXOTICA_PROFILE_ZONE("DynamicsSolver::ComputeDerivatives");
     // Compute derivatives of differential dynamics
     fx_ = fx(x, u);
     fu_ = fu(x, u);
@@ -407,7 +407,7 @@ void KinematicTree::BuildTree(const KDL::Tree& robot_kinematics)
                         std::shared_ptr<urdf::Mesh> mesh = std::static_pointer_cast<urdf::Mesh>(ToStdPtr(urdf_visual->geometry));
                         visual.shape_resource_path = mesh->filename;
                         visual.scale = Eigen::Vector3d(mesh->scale.x, mesh->scale.y, mesh->scale.z);
-                        visual.shape.reset(shapes::createMeshFromResource(mesh->filename));
+                        visual.shape = Server::Instance()->GetMesh(mesh->filename);
                     }
                     break;
                     default:
@@ -497,6 +497,7 @@ void KinematicTree::ChangeParent(const std::string& name, const std::string& par
     parent->children.push_back(child);
     child->UpdateClosestRobotLink();
     debug_scene_changed_ = true;
+    ++revision_;
 }
 
 std::shared_ptr<KinematicElement> KinematicTree::AddEnvironmentElement(const std::string& name, const Eigen::Isometry3d& transform, const std::string& parent, shapes::ShapeConstPtr shape, const KDL::RigidBodyInertia& inertia, const Eigen::Vector4d& color, const std::vector<VisualElement>& visual, bool is_controlled)
@@ -527,7 +528,7 @@ std::shared_ptr<KinematicElement> KinematicTree::AddElement(const std::string& n
         ThrowPretty("Path cannot be resolved.");
     }
 
-    shapes::ShapePtr shape = shapes::ShapePtr(shapes::createMeshFromResource(shape_path, scale));
+    shapes::ShapeConstPtr shape = Server::Instance()->GetMesh(shape_path, scale);
     std::shared_ptr<KinematicElement> element = AddElement(name, transform, parent, shape, inertia, color, visual, is_controlled);
     element->shape_resource_path = shape_path;
     element->scale = scale;
@@ -627,11 +628,13 @@ int KinematicTree::IsControlledLink(const std::string& link_name)
 
 std::shared_ptr<KinematicResponse> KinematicTree::RequestFrames(const KinematicsRequest& request)
 {
+    ++revision_;
     flags_ = request.flags;
     if (flags_ & KIN_H) flags_ = flags_ | KIN_J;
     solution_.reset(new KinematicResponse(flags_, request.frames.size(), num_controlled_joints_));
 
     state_size_ = num_controlled_joints_;
+    if (flags_ & KIN_COM) center_of_mass_jacobian_.setZero(3, num_controlled_joints_);
 
     for (int i = 0; i < request.frames.size(); ++i)
     {
@@ -677,6 +680,7 @@ std::shared_ptr<KinematicResponse> KinematicTree::RequestFrames(const Kinematics
 
 void KinematicTree::Update(Eigen::VectorXdRefConst x)
 {
+    EXOTICA_PROFILE_ZONE("KinematicTree::Update");
     if (x.size() != state_size_) ThrowPretty("Wrong state vector size! Got " << x.size() << " expected " << state_size_);
 
     for (int i = 0; i < num_controlled_joints_; ++i)
@@ -689,14 +693,41 @@ void KinematicTree::Update(Eigen::VectorXdRefConst x)
     UpdateFK();
     if (flags_ & KIN_J) UpdateJ();
     if (flags_ & KIN_J && flags_ & KIN_H) UpdateH();
+    if (flags_ & KIN_COM) UpdateCoM(flags_ & KIN_J);
     if (debug) PublishFrames();
 }
 
+void KinematicTree::UpdateControlledJoint(int i, double value)
+{
+    if (i < 0 || i >= num_controlled_joints_) ThrowPretty("Invalid controlled joint index " << i << ", expected 0 to " << num_controlled_joints_ - 1);
+
+    std::shared_ptr<KinematicElement> joint = controlled_joints_[i].lock();
+    tree_state_(joint->id) = value;
+    solution_->x(i) = value;
+
+    // Only the subtree below the joint (and below the joints mimicking it) moves.
+    UpdateSubtree(joint);
+    for (const std::weak_ptr<KinematicElement>& welement : tree_)
+    {
+        std::shared_ptr<KinematicElement> element = welement.lock();
+        if (element && element->is_mimic_joint && element->mimic_joint_id == joint->id) UpdateSubtree(element);
+    }
+
+    UpdateFK();
+    if (flags_ & KIN_COM) UpdateCoM(false);
+}
+
 void KinematicTree::UpdateTree()
 {
+    UpdateSubtree(root_);
+}
+
+void KinematicTree::UpdateSubtree(std::shared_ptr<KinematicElement> subtree_root)
+{
+    ++revision_;
     std::queue<std::shared_ptr<KinematicElement>> elements;
-    elements.push(root_);
-    root_->RemoveExpiredChildren();
+    elements.push(subtree_root);
+    subtree_root->RemoveExpiredChildren();
     while (elements.size() > 0)
     {
         auto element = elements.front();
@@ -858,6 +889,7 @@ KDL::Frame KinematicTree::FK(const std::string& element_A, const KDL::Frame& off
 
 void KinematicTree::UpdateFK()
 {
+    EXOTICA_PROFILE_ZONE("KinematicTree::UpdateFK");
     int i = 0;
     for (KinematicFrame& frame : solution_->frame)
     {
@@ -979,6 +1011,7 @@ void KinematicTree::ComputeH(KinematicFrame& frame, const KDL::Jacobian& jacobia
 
 void KinematicTree::UpdateJ()
 {
+    EXOTICA_PROFILE_ZONE("KinematicTree::UpdateJ");
     int i = 0;
     for (KinematicFrame& frame : solution_->frame)
     {
@@ -989,6 +1022,7 @@ void KinematicTree::UpdateJ()
 
 void KinematicTree::UpdateH()
 {
+    EXOTICA_PROFILE_ZONE("KinematicTree::UpdateH");
     int i = 0;
     for (KinematicFrame& frame : solution_->frame)
     {
@@ -997,6 +1031,133 @@ void KinematicTree::UpdateH()
     }
 }
 
+void KinematicTree::UpdateCoM(bool update_jacobian)
+{
+    // Breadth-first order: every element is preceded by its parent.
+    com_traversal_.clear();
+    com_traversal_.push_back(root_.get());
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < com_traversal_.size(); ++i)
+    {
+        size = std::max(size, static_cast<std::size_t>(com_traversal_[i]->id + 2));
+        for (const std::weak_ptr<KinematicElement>& child : com_traversal_[i]->children)
+        {
+            std::shared_ptr<KinematicElement> child_element = child.lock();
+            if (child_element) com_traversal_.push_back(child_element.get());
+        }
+    }
+
+    // Accumulate composite masses from the leaves towards the root.
+    composite_mass_.assign(size, 0.0);
+    composite_moment_.assign(size, KDL::Vector::Zero());
+    for (auto it = com_traversal_.rbegin(); it != com_traversal_.rend(); ++it)
+    {
+        const KinematicElement* element = *it;
+        const int i = element->id + 1;
+        if (element->is_robot_link || element->closest_robot_link.lock())  // Only for robot links and attached objects
+        {
+            const KDL::RigidBodyInertia& inertia = element->segment.getInertia();
+            composite_mass_[i] += inertia.getMass();
+            composite_moment_[i] += (element->frame * inertia.getCOG()) * inertia.getMass();
+        }
+        std::shared_ptr<KinematicElement> parent = element->parent.lock();
+        if (parent)
+        {
+            composite_mass_[parent->id + 1] += composite_mass_[i];
+            composite_moment_[parent->id + 1] += composite_moment_[i];
+        }
+    }
+
+    total_mass_ = composite_mass_[root_->id + 1];
+    if (total_mass_ > 0.0)
+    {
+        const KDL::Vector com = root_->frame.Inverse() * (composite_moment_[root_->id + 1] / total_mass_);
+        center_of_mass_ = Eigen::Map<const Eigen::Vector3d>(com.data);
+    }
+    else
+    {
+        center_of_mass_.setZero();
+    }
+    if (update_jacobian) ComputeCoMJacobian(root_.get(), center_of_mass_jacobian_);
+}
+
+void KinematicTree::ComputeCoMJacobian(const KinematicElement* element, Eigen::MatrixXd& jacobian) const
+{
+    jacobian.setZero(3, num_controlled_joints_);
+    const double mass = composite_mass_[element->id + 1];
+    if (mass <= 0.0) return;
+
+    const KDL::Rotation root_rotation_inverse = root_->frame.M.Inverse();
+    // Velocity of a point rigidly attached to the child link of a joint per unit joint velocity (cf. ComputeJ).
+    auto add_column = [&](const KinematicElement* joint, const KDL::Vector& point, double weight) {
+        KDL::Frame segment_reference;
+        std::shared_ptr<KinematicElement> parent = joint->parent.lock();
+        if (parent != nullptr) segment_reference = parent->frame;
+        const KDL::Vector velocity = root_rotation_inverse * (segment_reference.M * joint->segment.twist(tree_state_(joint->id), 1.0)).RefPoint(point - joint->frame.p).vel;
+        jacobian.col(joint->control_id) += weight * Eigen::Map<const Eigen::Vector3d>(velocity.data);
+    };
+
+    // Joints inside the subtree move the composite body of their child link.
+    std::vector<const KinematicElement*> stack;
+    for (const std::weak_ptr<KinematicElement>& child : element->children)
+    {
+        std::shared_ptr<KinematicElement> child_element = child.lock();
+        if (child_element) stack.push_back(child_element.get());
+    }
+    while (!stack.empty())
+    {
+        const KinematicElement* it = stack.back();
+        stack.pop_back();
+        const double subtree_mass = composite_mass_[it->id + 1];
+        if (subtree_mass <= 0.0) continue;  // Massless subtrees do not contribute
+        if (it->is_controlled) add_column(it, composite_moment_[it->id + 1] / subtree_mass, subtree_mass / mass);
+        for (const std::weak_ptr<KinematicElement>& child : it->children)
+        {
+            std::shared_ptr<KinematicElement> child_element = child.lock();
+            if (child_element) stack.push_back(child_element.get());
+        }
+    }
+
+    // Joints between the root and the subtree move the whole subtree.
+    const KDL::Vector com = composite_moment_[element->id + 1] / mass;
+    std::shared_ptr<KinematicElement> ancestor;
+    for (const KinematicElement* it = element; it != nullptr; it = ancestor.get())
+    {
+        if (it->is_controlled) add_column(it, com, 1.0);
+        ancestor = it->parent.lock();
+    }
+}
+
+std::shared_ptr<KinematicElement> KinematicTree::GetElementForCoM(const std::string& link) const
+{
+    if (!(flags_ & KIN_COM)) ThrowPretty("The center of mass has not been requested (KIN_COM)!");
+    auto it = tree_map_.find(link);
+    if (it == tree_map_.end()) ThrowPretty("Can't find link '" << link << "'!");
+    std::shared_ptr<KinematicElement> element = it->second.lock();
+    if (element->id + 1 >= static_cast<int>(composite_mass_.size())) ThrowPretty("Link '" << link << "' was added after the last update!");
+    return element;
+}
+
+double KinematicTree::GetSubtreeMass(const std::string& link) const
+{
+    return composite_mass_[GetElementForCoM(link)->id + 1];
+}
+
+Eigen::Vector3d KinematicTree::GetSubtreeCenterOfMass(const std::string& link) const
+{
+    const int i = GetElementForCoM(link)->id + 1;
+    if (composite_mass_[i] <= 0.0) return Eigen::Vector3d::Zero();
+    const KDL::Vector com = root_->frame.Inverse() * (composite_moment_[i] / composite_mass_[i]);
+    return Eigen::Map<const Eigen::Vector3d>(com.data);
+}
+
+Eigen::MatrixXd KinematicTree::GetSubtreeCenterOfMassJacobian(const std::string& link) const
+{
+    Eigen::MatrixXd jacobian;
+    ComputeCoMJacobian(GetElementForCoM(link).get(), jacobian);
+    return jacobian;
+}
+
 exotica::BaseType KinematicTree::GetModelBaseType() const
 {
     return model_base_type_;
@@ -1278,6 +1439,7 @@ void KinematicTree::ResetJointLimits()
 
 void KinematicTree::UpdateJointLimits()
 {
+    ++revision_;
     joint_limits_.setZero();
     for (int i = 0; i < num_controlled_joints_; ++i)
     {
@@ -38,7 +38,10 @@ namespace exotica
 void MotionSolver::InstantiateBase(const Initializer& init)
 {
     Object::InstantiateObject(init);
-    SetNumberOfMaxIterations(MotionSolverInitializer(init).MaxIterations);
+    MotionSolverInitializer motion_solver_init(init);
+    SetNumberOfMaxIterations(motion_solver_init.MaxIterations);
+    SetMaxPlanningTime(motion_solver_init.MaxPlanningTime);
+    SetMaxTimingSamples(motion_solver_init.MaxTimingSamples);
 }
 
 void MotionSolver::SpecifyProblem(PlanningProblemPtr pointer)
@@ -46,6 +49,84 @@ void MotionSolver::SpecifyProblem(PlanningProblemPtr pointer)
     problem_ = pointer;
 }
 
+bool MotionSolver::CheckTimeBudget(const Timer& planning_timer, int iterations)
+{
+    if (!IsTimeBudgetExceeded(planning_timer)) return false;
+    if (debug_) HIGHLIGHT_NAMED(object_name_, "Time budget of " << max_planning_time_ << " s exhausted after " << iterations << " iterations.");
+    problem_->termination_criterion = TerminationCriterion::TimeLimit;
+    return true;
+}
+
+const char* MotionSolver::GetPhaseName(SolverPhase phase)
+{
+    switch (phase)
+    {
+        case SolverPhase::ProblemUpdate:
+            return "ProblemUpdate";
+        case SolverPhase::BackwardPass:
+            return "BackwardPass";
+        case SolverPhase::LineSearch:
+            return "LineSearch";
+        case SolverPhase::Sweep:
+            return "Sweep";
+        default:
+            ThrowPretty("Unknown solver phase " << static_cast<int>(phase));
+    }
+}
+
+std::map<std::string, std::vector<double>> MotionSolver::GetTimings() const
+{
+    std::map<std::string, std::vector<double>> ret;
+    for (int i = 0; i < static_cast<int>(SolverPhase::NumPhases); ++i)
+    {
+        const TimingSamples& timing = timings_[i];
+        if (timing.samples.empty()) continue;
+        std::vector<double>& samples = ret[GetPhaseName(static_cast<SolverPhase>(i))];
+        samples.reserve(timing.samples.size());
+        samples.insert(samples.end(), timing.samples.begin() + timing.oldest, timing.samples.end());
+        samples.insert(samples.end(), timing.samples.begin(), timing.samples.begin() + timing.oldest);
+    }
+    return ret;
+}
+
+void MotionSolver::ClearTimings()
+{
+    for (TimingSamples& timing : timings_)
+    {
+        timing.samples.clear();
+        timing.oldest = 0;
+    }
+}
+
+void MotionSolver::SetMaxTimingSamples(int max_timing_samples)
+{
+    if (max_timing_samples < 0) ThrowPretty("Maximum number of timing samples needs to be non-negative.");
+    max_timing_samples_ = max_timing_samples;
+    ClearTimings();
+}
+
+std::pair<Eigen::VectorXi, Eigen::VectorXd> MotionSolver::GetTimingHistogram(const std::string& phase, int num_bins) const
+{
+    if (num_bins < 1) ThrowPretty("Number of bins needs to be greater than 0.");
+    const TimingSamples* timing = nullptr;
+    for (int i = 0; i < static_cast<int>(SolverPhase::NumPhases); ++i)
+    {
+        if (phase == GetPhaseName(static_cast<SolverPhase>(i))) timing = &timings_[i];
+    }
+    if (timing == nullptr || timing->samples.empty()) ThrowPretty("No timings recorded for '" << phase << "'.");
+
+    const Eigen::Map<const Eigen::VectorXd> samples(timing->samples.data(), timing->samples.size());
+    const double min = samples.minCoeff(), max = samples.maxCoeff();
+    const Eigen::VectorXd edges = Eigen::VectorXd::LinSpaced(num_bins + 1, min, max);
+    Eigen::VectorXi counts = Eigen::VectorXi::Zero(num_bins);
+    for (Eigen::Index i = 0; i < samples.size(); ++i)
+    {
+        const int bin = max > min ? static_cast<int>((samples(i) - min) / (max - min) * num_bins) : 0;
+        ++counts(std::min(bin, num_bins - 1));
+    }
+    return {counts, edges};
+}
+
 std::string MotionSolver::Print(const std::string& prepend) const
 {
     std::string ret = Object::Print(prepend);
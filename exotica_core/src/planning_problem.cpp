@@ -85,9 +85,37 @@ Eigen::VectorXd PlanningProblem::ApplyStartState(bool update_traj)
 
 void PlanningProblem::PreUpdate()
 {
+    InvalidateUpdateCache();
     for (auto& it : task_maps_) it.second->PreUpdate();
 }
 
+double PlanningProblem::GetProblemUpdateCacheHitRate() const
+{
+    const unsigned int total = number_of_problem_updates_ + number_of_problem_update_cache_hits_;
+    return total > 0 ? static_cast<double>(number_of_problem_update_cache_hits_) / static_cast<double>(total) : 0.0;
+}
+
+void PlanningProblem::SetUseUpdateCache(bool use_update_cache)
+{
+    use_update_cache_ = use_update_cache;
+    InvalidateUpdateCache();
+}
+
+bool PlanningProblem::IsUpdateCached(Eigen::VectorXdRefConst x)
+{
+    if (!use_update_cache_ || !update_cache_valid_ || update_cache_revision_ != scene_->GetKinematicTree().GetRevision() || update_cache_x_.size() != x.size() || update_cache_x_ != x) return false;
+    ++number_of_problem_update_cache_hits_;
+    return true;
+}
+
+void PlanningProblem::SetUpdateCache(Eigen::VectorXdRefConst x)
+{
+    if (!use_update_cache_) return;
+    update_cache_x_ = x;
+    update_cache_revision_ = scene_->GetKinematicTree().GetRevision();
+    update_cache_valid_ = true;
+}
+
 void PlanningProblem::SetStartState(Eigen::VectorXdRefConst x)
 {
     // NB: start_state_ has the size nq+nv
@@ -138,6 +166,7 @@ Eigen::VectorXd PlanningProblem::GetStartState() const
 void PlanningProblem::SetStartTime(double t)
 {
     t_start = t;
+    InvalidateUpdateCache();
 }
 
 double PlanningProblem::GetStartTime() const
@@ -179,6 +208,9 @@ void PlanningProblem::InstantiateBase(const Initializer& init_in)
     if (init.StartTime < 0) ThrowNamed("Invalid start time " << init.StartTime);
     t_start = init.StartTime;
 
+    use_update_cache_ = init.UseUpdateCache;
+    InvalidateUpdateCache();
+
     // Set the derivative order for Kinematics
     switch (init.DerivativeOrder)
     {
@@ -213,6 +245,7 @@ void PlanningProblem::InstantiateBase(const Initializer& init_in)
             ThrowNamed("Map '" + new_map->GetObjectName() + "' already exists!");
         }
         std::vector<KinematicFrameRequest> frames = new_map->GetFrames();
+        request.flags = request.flags | new_map->GetKinematicRequestFlags();
 
         for (size_t i = 0; i < new_map->kinematics.size(); ++i)
             new_map->kinematics[i] = KinematicSolution(id, frames.size());
@@ -316,6 +349,8 @@ double PlanningProblem::GetCostEvolution(int index) const
 
 void PlanningProblem::ResetCostEvolution(size_t size)
 {
+    // A new solve may follow changes to task map parameters which are not tracked by the update cache.
+    InvalidateUpdateCache();
     cost_evolution_.resize(size);
     cost_evolution_.assign(size, std::make_pair<std::chrono::high_resolution_clock::time_point, double>(std::chrono::high_resolution_clock::now(), std::numeric_limits<double>::quiet_NaN()));
 }
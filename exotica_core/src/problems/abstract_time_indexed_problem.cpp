@@ -171,6 +171,14 @@ void AbstractTimeIndexedProblem::PreUpdate()
         }
     }
 
+    InitializeConstraintJacobian(equality, active_nonlinear_equality_constraints_, active_nonlinear_equality_constraints_dimension_, equality_jacobian_);
+    InitializeConstraintJacobian(inequality, active_nonlinear_inequality_constraints_, active_nonlinear_inequality_constraints_dimension_, inequality_jacobian_);
+    equality_jacobian_outdated_ = true;
+    inequality_jacobian_outdated_ = true;
+
+    // Sample the trajectories of moving objects on the time grid of the problem
+    scene_->SetTrajectorySampling(tau_, t_start);
+
     // Update joint velocity constraints
     q_dot_max_ = scene_->GetKinematicTree().GetVelocityLimits();
     xdiff_max_ = q_dot_max_ * tau_;
@@ -211,10 +219,19 @@ void AbstractTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_trajectory_in)
     if (x_trajectory_in.size() != (T_ - 1) * N)
         ThrowPretty("To update using the trajectory Update method, please use a trajectory of size N x (T-1) (" << N * (T_ - 1) << "), given: " << x_trajectory_in.size());
 
+    // Only the task spaces (e.g., goals) need to be updated if neither the trajectory nor the scene changed
+    if (IsUpdateCached(x_trajectory_in))
+    {
+        number_of_problem_update_cache_hits_ += T_ - 2;  // Count one hit per timestep
+        for (int t = 1; t < T_; ++t) UpdateTaskSpaces(t);
+        return;
+    }
+
     for (int t = 1; t < T_; ++t)
     {
         Update(x_trajectory_in.segment((t - 1) * N, N), t);
     }
+    SetUpdateCache(x_trajectory_in);
 }
 
 void AbstractTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t)
@@ -249,6 +266,7 @@ void AbstractTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t)
         // Only update TaskMap if rho is not 0
         if (tasks_[i]->is_used)
         {
+            EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
             if (flags_ & KIN_H)
             {
                 tasks_[i]->Update(x[t],
@@ -269,6 +287,13 @@ void AbstractTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t)
             }
         }
     }
+    UpdateTaskSpaces(t);
+    if (t > 0) xdiff[t] = x[t] - x[t - 1];
+    ++number_of_problem_updates_;
+}
+
+void AbstractTimeIndexedProblem::UpdateTaskSpaces(int t)
+{
     if (flags_ & KIN_H)
     {
         cost.Update(Phi[t], jacobian[t], hessian[t], t);
@@ -287,8 +312,8 @@ void AbstractTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t)
         inequality.Update(Phi[t], t);
         equality.Update(Phi[t], t);
     }
-    if (t > 0) xdiff[t] = x[t] - x[t - 1];
-    ++number_of_problem_updates_;
+    equality_jacobian_outdated_ = true;
+    inequality_jacobian_outdated_ = true;
 }
 
 double AbstractTimeIndexedProblem::get_ct() const
@@ -311,8 +336,10 @@ Eigen::RowVectorXd AbstractTimeIndexedProblem::GetCostJacobian() const
     Eigen::RowVectorXd jac = Eigen::RowVectorXd::Zero(N * (T_ - 1));
     for (int t = 1; t < T_; ++t)
     {
-        jac.segment((t - 1) * N, N) += GetScalarTaskJacobian(t) + GetScalarTransitionJacobian(t);
-        if (t > 1) jac.segment((t - 2) * N, N) -= GetScalarTransitionJacobian(t);
+        // Accumulate in place rather than through the per-timestep row vectors of GetScalarTaskJacobian/GetScalarTransitionJacobian.
+        jac.segment((t - 1) * N, N).noalias() += (2.0 * ct) * (cost.S[t] * cost.ydiff[t]).transpose() * cost.jacobian[t];
+        jac.segment((t - 1) * N, N).noalias() += (2.0 * ct) * xdiff[t].transpose() * W;
+        if (t > 1) jac.segment((t - 2) * N, N).noalias() -= (2.0 * ct) * xdiff[t].transpose() * W;
     }
     return jac;
 }
@@ -326,7 +353,7 @@ double AbstractTimeIndexedProblem::GetScalarTaskCost(int t) const
 Eigen::RowVectorXd AbstractTimeIndexedProblem::GetScalarTaskJacobian(int t) const
 {
     ValidateTimeIndex(t);
-    return cost.jacobian[t].transpose() * cost.S[t] * cost.ydiff[t] * 2.0 * ct;
+    return cost.jacobian[t].transpose() * (cost.S[t] * cost.ydiff[t]) * 2.0 * ct;
 }
 
 double AbstractTimeIndexedProblem::GetScalarTransitionCost(int t) const
@@ -366,46 +393,24 @@ Eigen::VectorXd AbstractTimeIndexedProblem::GetEquality() const
     return eq;
 }
 
-Eigen::SparseMatrix<double> AbstractTimeIndexedProblem::GetEqualityJacobian() const
+const Eigen::SparseMatrix<double, Eigen::RowMajor>& AbstractTimeIndexedProblem::GetEqualityJacobian() const
 {
-    Eigen::SparseMatrix<double> jac(active_nonlinear_equality_constraints_dimension_, N * (T_ - 1));
-    std::vector<Eigen::Triplet<double>> triplet_list = GetEqualityJacobianTriplets();
-    jac.setFromTriplets(triplet_list.begin(), triplet_list.end());
-    return jac;
+    if (equality_jacobian_outdated_)
+    {
+        RefreshConstraintJacobian(equality, active_nonlinear_equality_constraints_, equality_jacobian_);
+        equality_jacobian_outdated_ = false;
+    }
+    return equality_jacobian_;
 }
 
-std::vector<Eigen::Triplet<double>> AbstractTimeIndexedProblem::GetEqualityJacobianTriplets() const
+Eigen::Matrix<int, Eigen::Dynamic, 2> AbstractTimeIndexedProblem::GetEqualityJacobianStructure() const
 {
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> triplet_list;
-    triplet_list.reserve(active_nonlinear_equality_constraints_dimension_ * N);
-    int start = 0;
-    for (const auto& constraint : active_nonlinear_equality_constraints_)
-    {
-        // First is timestep, second is task id
-        const TaskIndexing task = equality.indexing[constraint.second];
-
-        const int row_start = start;
-        const int row_length = task.length_jacobian;
-        const int column_start = (constraint.first - 1) * N;  // (t - 1) * N
-        const int column_length = N;
-
-        const Eigen::MatrixXd jacobian = equality.rho[constraint.first](task.id) * equality.jacobian[constraint.first].middleRows(task.start_jacobian, task.length_jacobian);
-        int row_idx = 0;
-        for (int row = row_start; row < row_start + row_length; ++row)
-        {
-            int column_idx = 0;
-            for (int column = column_start; column < column_start + column_length; ++column)
-            {
-                triplet_list.emplace_back(Eigen::Triplet<double>(row, column, jacobian(row_idx, column_idx)));
-                ++column_idx;
-            }
-            ++row_idx;
-        }
+    return GetSparsityStructure(equality_jacobian_);
+}
 
-        start += task.length_jacobian;
-    }
-    return triplet_list;
+std::vector<Eigen::Triplet<double>> AbstractTimeIndexedProblem::GetEqualityJacobianTriplets() const
+{
+    return GetTriplets(GetEqualityJacobian());
 }
 
 Eigen::VectorXd AbstractTimeIndexedProblem::GetEquality(int t) const
@@ -435,58 +440,102 @@ Eigen::VectorXd AbstractTimeIndexedProblem::GetInequality() const
     return neq;
 }
 
-Eigen::SparseMatrix<double> AbstractTimeIndexedProblem::GetInequalityJacobian() const
+const Eigen::SparseMatrix<double, Eigen::RowMajor>& AbstractTimeIndexedProblem::GetInequalityJacobian() const
 {
-    Eigen::SparseMatrix<double> jac(active_nonlinear_inequality_constraints_dimension_, N * (T_ - 1));
-    std::vector<Eigen::Triplet<double>> triplet_list = GetInequalityJacobianTriplets();
-    jac.setFromTriplets(triplet_list.begin(), triplet_list.end());
-    return jac;
+    if (inequality_jacobian_outdated_)
+    {
+        RefreshConstraintJacobian(inequality, active_nonlinear_inequality_constraints_, inequality_jacobian_);
+        inequality_jacobian_outdated_ = false;
+    }
+    return inequality_jacobian_;
+}
+
+Eigen::Matrix<int, Eigen::Dynamic, 2> AbstractTimeIndexedProblem::GetInequalityJacobianStructure() const
+{
+    return GetSparsityStructure(inequality_jacobian_);
 }
 
 std::vector<Eigen::Triplet<double>> AbstractTimeIndexedProblem::GetInequalityJacobianTriplets() const
 {
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> triplet_list;
-    triplet_list.reserve(active_nonlinear_inequality_constraints_dimension_ * N);
-    int start = 0;
-    for (const auto& constraint : active_nonlinear_inequality_constraints_)
+    return GetTriplets(GetInequalityJacobian());
+}
+
+Eigen::VectorXd AbstractTimeIndexedProblem::GetInequality(int t) const
+{
+    ValidateTimeIndex(t);
+    return inequality.S[t] * inequality.ydiff[t];
+}
+
+Eigen::MatrixXd AbstractTimeIndexedProblem::GetInequalityJacobian(int t) const
+{
+    ValidateTimeIndex(t);
+    return inequality.S[t] * inequality.jacobian[t];
+}
+
+void AbstractTimeIndexedProblem::InitializeConstraintJacobian(const TimeIndexedTask& task, const std::vector<std::pair<int, int>>& active_constraints, int dimension, Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian) const
+{
+    // Each active constraint (t, id) occupies the rows of the task and the N columns of x(t).
+    // Entries are inserted row by row in increasing column order, so the values of a constraint
+    // form a contiguous row-major block in the compressed storage.
+    jacobian.resize(dimension, N * (T_ - 1));
+    jacobian.reserve(Eigen::VectorXi::Constant(dimension, N));
+    int row = 0;
+    for (const auto& constraint : active_constraints)
     {
         // First is timestep, second is task id
-        const TaskIndexing task = inequality.indexing[constraint.second];
-
-        const int row_start = start;
-        const int row_length = task.length_jacobian;
+        const TaskIndexing& task_indexing = task.indexing[constraint.second];
         const int column_start = (constraint.first - 1) * N;  // (t - 1) * N
-        const int column_length = N;
-
-        const Eigen::MatrixXd jacobian = inequality.rho[constraint.first](task.id) * inequality.jacobian[constraint.first].middleRows(task.start_jacobian, task.length_jacobian);
-        int row_idx = 0;
-        for (int row = row_start; row < row_start + row_length; ++row)
+        for (int i = 0; i < task_indexing.length_jacobian; ++i, ++row)
         {
-            int column_idx = 0;
-            for (int column = column_start; column < column_start + column_length; ++column)
+            for (int column = column_start; column < column_start + N; ++column)
             {
-                triplet_list.emplace_back(Eigen::Triplet<double>(row, column, jacobian(row_idx, column_idx)));
-                ++column_idx;
+                jacobian.insert(row, column) = 0.0;
             }
-            ++row_idx;
         }
+    }
+    jacobian.makeCompressed();
+}
 
-        start += task.length_jacobian;
+void AbstractTimeIndexedProblem::RefreshConstraintJacobian(const TimeIndexedTask& task, const std::vector<std::pair<int, int>>& active_constraints, Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian) const
+{
+    double* values = jacobian.valuePtr();
+    for (const auto& constraint : active_constraints)
+    {
+        // First is timestep, second is task id
+        const TaskIndexing& task_indexing = task.indexing[constraint.second];
+        Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> block(values, task_indexing.length_jacobian, N);
+        block.noalias() = task.rho[constraint.first](task_indexing.id) * task.jacobian[constraint.first].middleRows(task_indexing.start_jacobian, task_indexing.length_jacobian);
+        values += task_indexing.length_jacobian * N;
     }
-    return triplet_list;
 }
 
-Eigen::VectorXd AbstractTimeIndexedProblem::GetInequality(int t) const
+Eigen::Matrix<int, Eigen::Dynamic, 2> AbstractTimeIndexedProblem::GetSparsityStructure(const Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian)
 {
-    ValidateTimeIndex(t);
-    return inequality.S[t] * inequality.ydiff[t];
+    Eigen::Matrix<int, Eigen::Dynamic, 2> structure(jacobian.nonZeros(), 2);
+    int k = 0;
+    for (int row = 0; row < jacobian.outerSize(); ++row)
+    {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(jacobian, row); it; ++it, ++k)
+        {
+            structure(k, 0) = it.row();
+            structure(k, 1) = it.col();
+        }
+    }
+    return structure;
 }
 
-Eigen::MatrixXd AbstractTimeIndexedProblem::GetInequalityJacobian(int t) const
+std::vector<Eigen::Triplet<double>> AbstractTimeIndexedProblem::GetTriplets(const Eigen::SparseMatrix<double, Eigen::RowMajor>& jacobian)
 {
-    ValidateTimeIndex(t);
-    return inequality.S[t] * inequality.jacobian[t];
+    std::vector<Eigen::Triplet<double>> triplet_list;
+    triplet_list.reserve(jacobian.nonZeros());
+    for (int row = 0; row < jacobian.outerSize(); ++row)
+    {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(jacobian, row); it; ++it)
+        {
+            triplet_list.emplace_back(it.row(), it.col(), it.value());
+        }
+    }
+    return triplet_list;
 }
 
 int AbstractTimeIndexedProblem::get_joint_velocity_constraint_dimension() const
@@ -112,7 +112,7 @@ double BoundedEndPoseProblem::GetScalarCost() const
 
 Eigen::RowVectorXd BoundedEndPoseProblem::GetScalarJacobian() const
 {
-    return cost.jacobian.transpose() * cost.S * cost.ydiff * 2.0;
+    return cost.jacobian.transpose() * (cost.S * cost.ydiff) * 2.0;
 }
 
 double BoundedEndPoseProblem::GetScalarTaskCost(const std::string& task_name) const
@@ -129,34 +129,41 @@ double BoundedEndPoseProblem::GetScalarTaskCost(const std::string& task_name) co
 
 void BoundedEndPoseProblem::Update(Eigen::VectorXdRefConst x)
 {
-    scene_->Update(x, t_start);
-    Phi.SetZero(length_Phi);
-    if (flags_ & KIN_J) jacobian.setZero();
-    if (flags_ & KIN_H)
-        for (int i = 0; i < length_jacobian; ++i) hessian(i).setZero();
-    for (int i = 0; i < tasks_.size(); ++i)
-    {
-        if (tasks_[i]->is_used)
+    // The kinematics only need to be re-evaluated if the state or the scene changed
+    if (!IsUpdateCached(x))
+    {
+        scene_->Update(x, t_start);
+        Phi.SetZero(length_Phi);
+        if (flags_ & KIN_J) jacobian.setZero();
+        if (flags_ & KIN_H)
+            for (int i = 0; i < length_jacobian; ++i) hessian(i).setZero();
+        for (int i = 0; i < tasks_.size(); ++i)
         {
-            if (flags_ & KIN_H)
-            {
-                tasks_[i]->Update(x,
-                                  Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
-                                  jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian),
-                                  hessian.segment(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian));
-            }
-            else if (flags_ & KIN_J)
-            {
-                tasks_[i]->Update(x,
-                                  Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
-                                  Eigen::MatrixXdRef(jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian))  // Adding MatrixXdRef(...) is a work-around for issue #737 when using Eigen 3.3.9
-                );
-            }
-            else
+            if (tasks_[i]->is_used)
             {
-                tasks_[i]->Update(x, Phi.data.segment(tasks_[i]->start, tasks_[i]->length));
+                EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
+                if (flags_ & KIN_H)
+                {
+                    tasks_[i]->Update(x,
+                                      Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
+                                      jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian),
+                                      hessian.segment(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian));
+                }
+                else if (flags_ & KIN_J)
+                {
+                    tasks_[i]->Update(x,
+                                      Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
+                                      Eigen::MatrixXdRef(jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian))  // Adding MatrixXdRef(...) is a work-around for issue #737 when using Eigen 3.3.9
+                    );
+                }
+                else
+                {
+                    tasks_[i]->Update(x, Phi.data.segment(tasks_[i]->start, tasks_[i]->length));
+                }
             }
         }
+        SetUpdateCache(x);
+        ++number_of_problem_updates_;
     }
     if (flags_ & KIN_H)
     {
@@ -170,7 +177,6 @@ void BoundedEndPoseProblem::Update(Eigen::VectorXdRefConst x)
     {
         cost.Update(Phi);
     }
-    ++number_of_problem_updates_;
 }
 
 void BoundedEndPoseProblem::SetGoal(const std::string& task_name, Eigen::VectorXdRefConst goal)
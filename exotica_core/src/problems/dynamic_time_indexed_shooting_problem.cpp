@@ -376,10 +376,11 @@ void DynamicTimeIndexedShootingProblem::ReinitializeVariables()
     dxdiff_.assign(T_, Eigen::MatrixXd::Zero(NDX, NDX));
     state_cost_jacobian_.assign(T_, Eigen::VectorXd::Zero(NDX));
     state_cost_hessian_.assign(T_, Eigen::MatrixXd::Zero(NDX, NDX));
-    general_cost_jacobian_.assign(T_, Eigen::VectorXd::Zero(NDX));
-    general_cost_hessian_.assign(T_, Eigen::MatrixXd::Zero(NDX, NDX));
     control_cost_jacobian_.assign(T_ - 1, Eigen::VectorXd::Zero(NU));
     control_cost_hessian_.assign(T_ - 1, Eigen::MatrixXd::Zero(NU, NU));
+    state_control_cost_hessian_.setZero(NU, NDX);
+    weighted_ydiff_.setZero(cost.length_jacobian);
+    weighted_xdiff_.setZero(NDX);
 
     PreUpdate();
 }
@@ -410,12 +411,22 @@ void DynamicTimeIndexedShootingProblem::PreUpdate()
     for (int i = 0; i < tasks_.size(); ++i) tasks_[i]->is_used = false;
     cost.UpdateS();
 
+    // Sample the trajectories of moving objects on the time grid of the problem
+    scene_->SetTrajectorySampling(tau_, t_start);
+
     // Create a new set of kinematic solutions with the size of the trajectory
     // based on the lastest KinematicResponse in order to reflect model state
-    // updates etc.
-    kinematic_solutions_.clear();
-    kinematic_solutions_.resize(T_);
-    for (int i = 0; i < T_; ++i) kinematic_solutions_[i] = std::make_shared<KinematicResponse>(*scene_->GetKinematicTree().GetKinematicResponse());
+    // updates etc. The solutions are reused if T did not change, e.g. when re-solving in a receding-horizon loop.
+    if (static_cast<int>(kinematic_solutions_.size()) != T_)
+    {
+        kinematic_solutions_.clear();
+        kinematic_solutions_.resize(T_);
+        for (int i = 0; i < T_; ++i) kinematic_solutions_[i] = std::make_shared<KinematicResponse>(*scene_->GetKinematicTree().GetKinematicResponse());
+    }
+    else
+    {
+        for (int i = 0; i < T_; ++i) *kinematic_solutions_[i] = *scene_->GetKinematicTree().GetKinematicResponse();
+    }
 
     if (this->parameters_.WarmStartWithInverseDynamics)
     {
@@ -476,6 +487,20 @@ void DynamicTimeIndexedShootingProblem::set_U(Eigen::MatrixXdRefConst U_in)
     U_ = U_in;
 }
 
+void DynamicTimeIndexedShootingProblem::ShiftHorizon(Eigen::VectorXdRefConst x_measured)
+{
+    if (x_measured.rows() != X_.rows()) ThrowPretty("Wrong size of measured state: got " << x_measured.rows() << ", expected " << X_.rows());
+
+    // Column by column to avoid aliasing temporaries
+    for (int t = 0; t < T_ - 1; ++t) X_.col(t) = X_.col(t + 1);
+    for (int t = 0; t < T_ - 2; ++t) U_.col(t) = U_.col(t + 1);
+
+    X_.col(0) = x_measured;
+    if (scene_->get_has_quaternion_floating_base()) NormalizeQuaternionInConfigurationVector(X_.col(0));
+    SetStartState(X_.col(0));
+    t_start += tau_;
+}
+
 const Eigen::MatrixXd& DynamicTimeIndexedShootingProblem::get_X_star() const
 {
     return X_star_;
@@ -525,6 +550,16 @@ void DynamicTimeIndexedShootingProblem::set_Qf(Eigen::MatrixXdRefConst Q_in)
 }
 
 void DynamicTimeIndexedShootingProblem::Update(Eigen::VectorXdRefConst x_in, Eigen::VectorXdRefConst u_in, int t)
+{
+    UpdateShootingInterval(x_in, u_in, nullptr, t);
+}
+
+void DynamicTimeIndexedShootingProblem::Update(Eigen::VectorXdRefConst x_in, Eigen::VectorXdRefConst u_in, Eigen::VectorXdRefConst x_next, int t)
+{
+    UpdateShootingInterval(x_in, u_in, &x_next, t);
+}
+
+void DynamicTimeIndexedShootingProblem::UpdateShootingInterval(Eigen::VectorXdRefConst x_in, Eigen::VectorXdRefConst u_in, const Eigen::Ref<const Eigen::VectorXd>* x_next, int t)
 {
     // We can only update t=0, ..., T-1 - the last state will be created from integrating u_{T-1} to get x_T
     if (t >= (T_ - 1) || t < -1)
@@ -571,8 +606,17 @@ void DynamicTimeIndexedShootingProblem::Update(Eigen::VectorXdRefConst x_in, Eig
     // Actually update the tasks' kinematics mappings.
     PlanningProblem::UpdateMultipleTaskKinematics(kinematics_solutions);
 
-    // Simulate for tau
-    X_.col(t + 1) = scene_->GetDynamicsSolver()->Simulate(X_.col(t), U_.col(t), tau_);
+    // Simulate for tau, unless the successor state has been provided
+    if (x_next)
+    {
+        if (x_next->rows() != X_.rows()) ThrowPretty("Mismatching in size of successor state vector: " << x_next->rows() << " given, expected: " << X_.rows());
+        X_.col(t + 1) = *x_next;
+    }
+    else
+    {
+        X_.col(t + 1) = X_.col(t);
+        scene_->GetDynamicsSolver()->SimulateInPlace(X_.col(t + 1), U_.col(t), tau_);
+    }
 
     // Clamp!
     if (scene_->GetDynamicsSolver()->get_has_state_limits())
@@ -693,6 +737,7 @@ void DynamicTimeIndexedShootingProblem::UpdateTaskMaps(Eigen::VectorXdRefConst x
         // Only update TaskMap if rho is not 0
         if (tasks_[i]->is_used)
         {
+            EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
             if (flags_ & KIN_H)
             {
                 tasks_[i]->Update(x, u,
@@ -740,57 +785,63 @@ double DynamicTimeIndexedShootingProblem::GetStateCost(int t) const
     return state_cost + general_cost;  // TODO: ct scaling
 }
 
-Eigen::VectorXd DynamicTimeIndexedShootingProblem::GetStateCostJacobian(int t)
+const Eigen::VectorXd& DynamicTimeIndexedShootingProblem::GetStateCostJacobian(int t)
 {
     ValidateTimeIndex(t);
 
-    // (NDX,NDX)^T * (NDX,NDX) * (NDX,1) * (1,1) => (NDX,1), TODO: We should change this to RowVectorXd format
+    // State cost
+    // (NDX,NDX)^T * (NDX,NDX) * (NDX,1) => (NDX,1), TODO: We should change this to RowVectorXd format
     dxdiff_[t] = scene_->GetDynamicsSolver()->dStateDelta(X_.col(t), X_star_.col(t), ArgumentPosition::ARG0);
-    state_cost_jacobian_[t].noalias() = dxdiff_[t].transpose() * Q_[t] * X_diff_.col(t) * 2.0;
+    weighted_xdiff_.noalias() = Q_[t] * X_diff_.col(t);
+    state_cost_jacobian_[t].noalias() = dxdiff_[t].transpose() * weighted_xdiff_;
 
+    // General cost
     // m => dimension of task maps, "length_jacobian"
-    // (m,NQ)^T * (m,m) * (m,1) * (1,1) => (NQ,1), TODO: We should change this to RowVectorXd format
-    general_cost_jacobian_[t].noalias() = cost.dPhi_dx[t].transpose() * cost.S[t] * cost.ydiff[t] * 2.0;
+    // (m,NQ)^T * (m,m) * (m,1) => (NQ,1), TODO: We should change this to RowVectorXd format
+    weighted_ydiff_.noalias() = cost.S[t] * cost.ydiff[t];
+    state_cost_jacobian_[t].noalias() += cost.dPhi_dx[t].transpose() * weighted_ydiff_;
 
-    return state_cost_jacobian_[t] + general_cost_jacobian_[t];
+    state_cost_jacobian_[t] *= 2.0;
+    return state_cost_jacobian_[t];
 }
 
-Eigen::MatrixXd DynamicTimeIndexedShootingProblem::GetStateCostHessian(int t)
+const Eigen::MatrixXd& DynamicTimeIndexedShootingProblem::GetStateCostHessian(int t)
 {
     ValidateTimeIndex(t);
 
-    // State Cost
+    // State cost
     dxdiff_[t] = scene_->GetDynamicsSolver()->dStateDelta(X_.col(t), X_star_.col(t), ArgumentPosition::ARG0);
     state_cost_hessian_[t].noalias() = dxdiff_[t].transpose() * Q_[t] * dxdiff_[t];
 
     // For non-Euclidean spaces (i.e. on manifolds), there exists a second derivative of the state delta
     if (scene_->get_has_quaternion_floating_base())
     {
-        Eigen::RowVectorXd xdiffTQ = X_diff_.col(t).transpose() * Q_[t];  // (1*ndx)
+        weighted_xdiff_.noalias() = Q_[t].transpose() * X_diff_.col(t);  // (ndx*1)
         Hessian ddxdiff = scene_->GetDynamicsSolver()->ddStateDelta(X_.col(t), X_star_.col(t), ArgumentPosition::ARG0);
         for (int i = 0; i < ddxdiff.size(); ++i)
         {
-            state_cost_hessian_[t].noalias() += xdiffTQ(i) * ddxdiff(i);
+            state_cost_hessian_[t].noalias() += weighted_xdiff_(i) * ddxdiff(i);
         }
     }
 
-    // General Cost
-    general_cost_hessian_[t].noalias() = cost.dPhi_dx[t].transpose() * cost.S[t] * cost.dPhi_dx[t];
+    // General cost
+    state_cost_hessian_[t].noalias() += cost.dPhi_dx[t].transpose() * cost.S[t] * cost.dPhi_dx[t];
 
     // Contract task-map Hessians
     if (flags_ & KIN_H)
     {
-        Eigen::RowVectorXd ydiffTS = cost.ydiff[t].transpose() * cost.S[t];  // (1*m)
-        for (int i = 0; i < cost.length_jacobian; ++i)                       // length m
+        weighted_ydiff_.noalias() = cost.S[t] * cost.ydiff[t];  // (m*1)
+        for (int i = 0; i < cost.length_jacobian; ++i)          // length m
         {
-            general_cost_hessian_[t].noalias() += ydiffTS(i) * cost.ddPhi_ddx[t](i);
+            state_cost_hessian_[t].noalias() += weighted_ydiff_(i) * cost.ddPhi_ddx[t](i);
         }
     }
 
-    return 2.0 * state_cost_hessian_[t] + 2.0 * general_cost_hessian_[t];
+    state_cost_hessian_[t] *= 2.0;
+    return state_cost_hessian_[t];
 }
 
-Eigen::MatrixXd DynamicTimeIndexedShootingProblem::GetControlCostHessian(int t)
+const Eigen::MatrixXd& DynamicTimeIndexedShootingProblem::GetControlCostHessian(int t)
 {
     if (t >= T_ - 1 || t < -1)
     {
@@ -820,7 +871,8 @@ Eigen::MatrixXd DynamicTimeIndexedShootingProblem::GetControlCostHessian(int t)
         else if (loss_type_ == ControlCostLossTermType::PseudoHuber && huber_rate_(iu) != 0)
             control_cost_hessian_[t](iu, iu) += pseudo_huber_hessian(U_.col(t)[iu], huber_rate_(iu));
     }
-    return control_cost_weight_ * control_cost_hessian_[t];
+    control_cost_hessian_[t] *= control_cost_weight_;
+    return control_cost_hessian_[t];
 }
 
 double DynamicTimeIndexedShootingProblem::GetControlCost(int t) const
@@ -864,7 +916,7 @@ double DynamicTimeIndexedShootingProblem::GetControlCost(int t) const
     return control_cost_weight_ * cost;
 }
 
-Eigen::VectorXd DynamicTimeIndexedShootingProblem::GetControlCostJacobian(int t)
+const Eigen::VectorXd& DynamicTimeIndexedShootingProblem::GetControlCostJacobian(int t)
 {
     if (t >= T_ - 1 || t < -1)
     {
@@ -897,7 +949,8 @@ Eigen::VectorXd DynamicTimeIndexedShootingProblem::GetControlCostJacobian(int t)
         else if (loss_type_ == ControlCostLossTermType::PseudoHuber && huber_rate_(iu) != 0)
             control_cost_jacobian_[t](iu) += pseudo_huber_jacobian(U_.col(t)[iu], huber_rate_(iu));
     }
-    return control_cost_weight_ * control_cost_jacobian_[t];
+    control_cost_jacobian_[t] *= control_cost_weight_;
+    return control_cost_jacobian_[t];
 }
 
 Eigen::MatrixXd DynamicTimeIndexedShootingProblem::get_F(int t) const
@@ -119,7 +119,7 @@ double EndPoseProblem::GetScalarCost()
 
 Eigen::RowVectorXd EndPoseProblem::GetScalarJacobian()
 {
-    return cost.jacobian.transpose() * cost.S * cost.ydiff * 2.0;
+    return cost.jacobian.transpose() * (cost.S * cost.ydiff) * 2.0;
 }
 
 double EndPoseProblem::GetScalarTaskCost(const std::string& task_name) const
@@ -156,34 +156,41 @@ Eigen::MatrixXd EndPoseProblem::GetInequalityJacobian()
 
 void EndPoseProblem::Update(Eigen::VectorXdRefConst x)
 {
-    scene_->Update(x, t_start);
-    Phi.SetZero(length_Phi);
-    if (flags_ & KIN_J) jacobian.setZero();
-    if (flags_ & KIN_H)
-        for (int i = 0; i < length_jacobian; ++i) hessian(i).setZero();
-    for (int i = 0; i < tasks_.size(); ++i)
+    // The kinematics only need to be re-evaluated if the state or the scene changed
+    if (!IsUpdateCached(x))
     {
-        if (tasks_[i]->is_used)
+        scene_->Update(x, t_start);
+        Phi.SetZero(length_Phi);
+        if (flags_ & KIN_J) jacobian.setZero();
+        if (flags_ & KIN_H)
+            for (int i = 0; i < length_jacobian; ++i) hessian(i).setZero();
+        for (int i = 0; i < tasks_.size(); ++i)
         {
-            if (flags_ & KIN_H)
-            {
-                tasks_[i]->Update(x,
-                                  Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
-                                  jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian),
-                                  hessian.segment(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian));
-            }
-            else if (flags_ & KIN_J)
-            {
-                tasks_[i]->Update(x,
-                                  Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
-                                  Eigen::MatrixXdRef(jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian))  // Adding MatrixXdRef(...) is a work-around for issue #737 when using Eigen 3.3.9
-                );
-            }
-            else
+            if (tasks_[i]->is_used)
             {
-                tasks_[i]->Update(x, Phi.data.segment(tasks_[i]->start, tasks_[i]->length));
+                EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
+                if (flags_ & KIN_H)
+                {
+                    tasks_[i]->Update(x,
+                                      Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
+                                      jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian),
+                                      hessian.segment(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian));
+                }
+                else if (flags_ & KIN_J)
+                {
+                    tasks_[i]->Update(x,
+                                      Phi.data.segment(tasks_[i]->start, tasks_[i]->length),
+                                      Eigen::MatrixXdRef(jacobian.middleRows(tasks_[i]->start_jacobian, tasks_[i]->length_jacobian))  // Adding MatrixXdRef(...) is a work-around for issue #737 when using Eigen 3.3.9
+                    );
+                }
+                else
+                {
+                    tasks_[i]->Update(x, Phi.data.segment(tasks_[i]->start, tasks_[i]->length));
+                }
             }
         }
+        SetUpdateCache(x);
+        ++number_of_problem_updates_;
     }
     if (flags_ & KIN_H)
     {
@@ -203,7 +210,6 @@ void EndPoseProblem::Update(Eigen::VectorXdRefConst x)
         inequality.Update(Phi);
         equality.Update(Phi);
     }
-    ++number_of_problem_updates_;
 }
 
 void EndPoseProblem::SetGoal(const std::string& task_name, Eigen::VectorXdRefConst goal)
@@ -238,7 +238,10 @@ void SamplingProblem::Update(Eigen::VectorXdRefConst x)
     for (int i = 0; i < num_tasks; ++i)
     {
         if (tasks_[i]->is_used)
+        {
+            EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
             tasks_[i]->Update(x, Phi.data.segment(tasks_[i]->start, tasks_[i]->length));
+        }
     }
     inequality.Update(Phi);
     equality.Update(Phi);
@@ -116,6 +116,22 @@ void UnconstrainedTimeIndexedProblem::PreUpdate()
     for (int i = 0; i < T_; ++i) kinematic_solutions_[i] = std::make_shared<KinematicResponse>(*scene_->GetKinematicTree().GetKinematicResponse());
 }
 
+void UnconstrainedTimeIndexedProblem::UpdateTaskSpaces(int t)
+{
+    if (flags_ & KIN_H)
+    {
+        cost.Update(Phi[t], jacobian[t], hessian[t], t);
+    }
+    else if (flags_ & KIN_J)
+    {
+        cost.Update(Phi[t], jacobian[t], t);
+    }
+    else
+    {
+        cost.Update(Phi[t], t);
+    }
+}
+
 void UnconstrainedTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t)
 {
     ValidateTimeIndex(t);
@@ -149,6 +165,7 @@ void UnconstrainedTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t
         // Only update TaskMap if rho is not 0
         if (tasks_[i]->is_used)
         {
+            EXOTICA_PROFILE_ZONE(tasks_[i]->GetProfilerZoneName());
             if (flags_ & KIN_H)
             {
                 tasks_[i]->Update(x[t],
@@ -169,18 +186,7 @@ void UnconstrainedTimeIndexedProblem::Update(Eigen::VectorXdRefConst x_in, int t
             }
         }
     }
-    if (flags_ & KIN_H)
-    {
-        cost.Update(Phi[t], jacobian[t], hessian[t], t);
-    }
-    else if (flags_ & KIN_J)
-    {
-        cost.Update(Phi[t], jacobian[t], t);
-    }
-    else
-    {
-        cost.Update(Phi[t], t);
-    }
+    UpdateTaskSpaces(t);
 
     if (t > 0) xdiff[t] = x[t] - x[t - 1];
 
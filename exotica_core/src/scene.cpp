@@ -74,6 +74,7 @@ void Scene::Instantiate(const SceneInitializer& init)
 
     // Load robot model and set up kinematics (KinematicTree)
     robot_model::RobotModelPtr model;
+    const std::string model_name = (init.URDF == "" || init.SRDF == "") ? init.RobotDescription : init.URDF;
     if (init.URDF == "" || init.SRDF == "")
     {
         Server::Instance()->GetModel(init.RobotDescription, model);
@@ -83,7 +84,17 @@ void Scene::Instantiate(const SceneInitializer& init)
         Server::Instance()->GetModel(init.URDF, model, init.URDF, init.SRDF);
     }
     kinematica_.Instantiate(init.JointGroup, model, object_name_);
-    ps_.reset(new planning_scene::PlanningScene(model));
+
+    // The planning scene either shares the robot model and the geometry of the LoadScene files with
+    // other scenes created from the same template, or loads the scene files itself.
+    if (init.UseSceneTemplate)
+    {
+        ps_ = Server::Instance()->GetPlanningScene(model_name, model, init.LoadScene);
+    }
+    else
+    {
+        ps_.reset(new planning_scene::PlanningScene(model));
+    }
 
     // Write URDF/SRDF to ROS param server
     if (Server::IsRos() && init.SetRobotDescriptionRosParams && init.URDF != "" && init.SRDF != "")
@@ -105,18 +116,23 @@ void Scene::Instantiate(const SceneInitializer& init)
     }
 
     // Note: Using the LoadScene initializer does not support custom offsets/poses, assumes Identity transform to world_frame
-    if (init.LoadScene != "")
+    if (init.LoadScene != "" && !init.UseSceneTemplate)
     {
         std::vector<std::string> files = ParseList(init.LoadScene, ';');
         for (const std::string& file : files) LoadSceneFile(file, Eigen::Isometry3d::Identity(), false);
     }
+    else if (init.LoadScene != "")
+    {
+        // The template already holds the geometry of the scene files; create their frames so that custom links can be attached to them.
+        UpdateSceneFrames();
+    }
 
     // Add custom links
     for (const exotica::Initializer& linkInit : init.Links)
     {
         LinkInitializer link(linkInit);
 
-        shapes::ShapePtr link_shape = nullptr;
+        shapes::ShapeConstPtr link_shape = nullptr;
         Eigen::Vector4d link_color = Eigen::Vector4d::Zero();
         if (link.Shape.size() == 1)
         {
@@ -138,7 +154,7 @@ void Scene::Instantiate(const SceneInitializer& init)
             {
                 MeshShapeInitializer mesh(link.Shape[0]);
                 // TODO: This will not support textures.
-                link_shape.reset(shapes::createMeshFromResource(ParsePath(mesh.MeshFilePath), mesh.Scale));
+                link_shape = Server::Instance()->GetMesh(ParsePath(mesh.MeshFilePath), mesh.Scale);
             }
             else if (shape.Type == "Octree")
             {
@@ -336,11 +352,13 @@ void Scene::UpdateTrajectoryGenerators(double t)
 
 void Scene::Update(Eigen::VectorXdRefConst x, double t)
 {
+    EXOTICA_PROFILE_ZONE("Scene::Update");
     if (request_needs_updating_ && kinematic_request_callback_)
     {
         UpdateInternalFrames();
     }
 
+    current_time_ = t;
     UpdateTrajectoryGenerators(t);
     kinematica_.Update(x);
     if (force_collision_ && collision_scene_ != nullptr) collision_scene_->UpdateCollisionObjectTransforms();
@@ -579,6 +597,7 @@ void Scene::SetModelState(Eigen::VectorXdRefConst x, double t, bool update_traj)
         UpdateInternalFrames();
     }
 
+    current_time_ = t;
     if (update_traj) UpdateTrajectoryGenerators(t);
     // Update Kinematica internal state
     kinematica_.SetModelState(x);
@@ -594,6 +613,7 @@ void Scene::SetModelState(const std::map<std::string, double>& x, double t, bool
         UpdateInternalFrames();
     }
 
+    current_time_ = t;
     if (update_traj) UpdateTrajectoryGenerators(t);
     // Update Kinematica internal state
     kinematica_.SetModelState(x);
@@ -654,6 +674,47 @@ std::string Scene::GetScene()
     return ss.str();
 }
 
+std::size_t Scene::GetWorldHash() const
+{
+    std::stringstream ss;
+    ss.precision(12);
+    for (const auto& element : kinematica_.GetModelTree())
+    {
+        if (element->is_robot_link || element->is_trajectory_generated || !element->shape) continue;
+        const KDL::Frame& pose = element->segment.getFrameToTip();
+        double qx, qy, qz, qw;
+        pose.M.GetQuaternion(qx, qy, qz, qw);
+        ss << element->segment.getName() << ' ' << element->parent_name << ' '
+           << pose.p.x() << ' ' << pose.p.y() << ' ' << pose.p.z() << ' ' << qx << ' ' << qy << ' ' << qz << ' ' << qw << ' '
+           << element->shape_resource_path << ' ' << element->scale.transpose() << '\n';
+        if (element->shape->type == shapes::MESH && !element->shape_resource_path.empty())
+        {
+            // Serialising every vertex would dominate the cost, the resource path and size identify the mesh.
+            // Meshes without a resource path, e.g. created from vertices, fall through to saveAsText.
+            const shapes::Mesh* mesh = static_cast<const shapes::Mesh*>(element->shape.get());
+            ss << mesh->vertex_count << ' ' << mesh->triangle_count << '\n';
+        }
+        else if (element->shape->type == shapes::OCTREE)
+        {
+            // Octrees are identified by instance, i.e. conservatively treated as changed when reloaded.
+            ss << "octree " << element->shape.get() << '\n';
+        }
+        else
+        {
+            shapes::saveAsText(element->shape.get(), ss);
+        }
+    }
+
+    // FNV-1a, std::hash gives no guarantees across processes.
+    std::size_t hash = 14695981039346656037ULL;
+    for (const char c : ss.str())
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 void Scene::CleanScene()
 {
     ps_->removeAllCollisionObjects();
@@ -930,6 +991,7 @@ void Scene::AddTrajectory(const std::string& link, std::shared_ptr<Trajectory> t
     const auto& it = tree.find(link);
     if (it == tree.end()) ThrowPretty("Can't find link '" << link << "'!");
     if (traj->GetDuration() == 0.0) ThrowPretty("The trajectory is empty!");
+    if (trajectory_sample_dt_ > 0.0) traj->SetSampling(trajectory_sample_dt_, trajectory_sample_offset_);
     trajectory_generators_[link] = std::pair<std::weak_ptr<KinematicElement>, std::shared_ptr<Trajectory>>(it->second, traj);
     it->second.lock()->is_trajectory_generated = true;
 }
@@ -949,6 +1011,13 @@ void Scene::RemoveTrajectory(const std::string& link)
     trajectory_generators_.erase(it);
 }
 
+void Scene::SetTrajectorySampling(double dt, double offset)
+{
+    trajectory_sample_dt_ = dt;
+    trajectory_sample_offset_ = offset;
+    for (auto& it : trajectory_generators_) it.second.second->SetSampling(dt, offset);
+}
+
 int Scene::get_num_positions() const
 {
     return num_positions_;
@@ -28,8 +28,11 @@
 //
 
 #include <boost/any.hpp>
+#include <fstream>
 #include <typeinfo>
 
+#include <geometric_shapes/shape_operations.h>
+
 #include <exotica_core/server.h>
 #include <exotica_core/tools.h>
 
@@ -149,6 +152,60 @@ robot_model::RobotModelConstPtr Server::GetModel(const std::string& path, const
     }
 }
 
+planning_scene::PlanningScenePtr Server::GetPlanningScene(const std::string& path, robot_model::RobotModelConstPtr model, const std::string& scene_files)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    planning_scene::PlanningSceneConstPtr& scene_template = planning_scene_templates_[std::make_pair(path, scene_files)];
+    if (!scene_template || scene_template->getRobotModel() != model)
+    {
+        planning_scene::PlanningScenePtr new_template(new planning_scene::PlanningScene(model));
+        for (const std::string& file : scene_files == "" ? std::vector<std::string>() : ParseList(scene_files, ';'))
+        {
+            std::ifstream ss(ParsePath(file));
+            if (!ss.is_open()) ThrowPretty("Cant read file '" << ParsePath(file) << "'!");
+#if ROS_VERSION_MINIMUM(1, 14, 0)  // if ROS version >= ROS_MELODIC
+            new_template->loadGeometryFromStream(ss, Eigen::Isometry3d::Identity());
+#else
+            new_template->loadGeometryFromStream(ss, Eigen::Affine3d::Identity());
+#endif
+        }
+        scene_template = new_template;
+    }
+    return scene_template->diff();
+}
+
+shapes::ShapeConstPtr Server::GetMesh(const std::string& resource, const Eigen::Vector3d& scale)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    const auto key = std::make_tuple(resource, scale(0), scale(1), scale(2));
+    auto it = meshes_.find(key);
+    if (it != meshes_.end()) return it->second;
+
+    shapes::ShapeConstPtr mesh(shapes::createMeshFromResource(resource, scale));
+    if (mesh) meshes_[key] = mesh;
+    return mesh;
+}
+
+void Server::ClearCache()
+{
+    std::map<std::string, std::function<void()>> registered_caches;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        robot_models_.clear();
+        planning_scene_templates_.clear();
+        meshes_.clear();
+        registered_caches = registered_caches_;
+    }
+    // Called without holding the lock, the functions may use the server themselves.
+    for (const auto& cache : registered_caches) cache.second();
+}
+
+void Server::RegisterCache(const std::string& name, std::function<void()> clear)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    registered_caches_[name] = clear;
+}
+
 bool Server::HasModel(const std::string& path)
 {
     return robot_models_.find(path) != robot_models_.end();
@@ -44,6 +44,7 @@ void TaskMap::InstantiateBase(const Initializer& init)
     Object::InstantiateObject(init);
     TaskMapInitializer MapInitializer(init);
     is_used = true;
+    profiler_zone_name_ = Profiler::Intern("TaskMap::Update/" + object_name_);
 
     frames_.clear();
 
@@ -52,6 +53,10 @@ void TaskMap::InstantiateBase(const Initializer& init)
         FrameInitializer frame(eff);
         frames_.push_back(KinematicFrameRequest(frame.Link, GetFrame(frame.LinkOffset), frame.Base, GetFrame(frame.BaseOffset)));
     }
+
+    SetFiniteDifferenceMethod(MapInitializer.FiniteDifferenceMethod);
+    SetFiniteDifferenceStep(MapInitializer.FiniteDifferenceStep);
+    finite_difference_subtree_updates_ = MapInitializer.FiniteDifferenceSubtreeUpdates;
 }
 
 std::vector<KinematicFrameRequest> TaskMap::GetFrames() const
@@ -61,41 +66,86 @@ std::vector<KinematicFrameRequest> TaskMap::GetFrames() const
 
 void TaskMap::Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian)
 {
-    if (jacobian.rows() != TaskSpaceDim() && jacobian.cols() != q.rows())
-        ThrowNamed("Jacobian dimension mismatch!");
+    FiniteDifferenceJacobian(q, phi, jacobian);
+}
+
+void TaskMap::SetFiniteDifferenceMethod(const std::string& method)
+{
+    if (method == "Forward")
+        finite_difference_method_ = FiniteDifferenceMethod::Forward;
+    else if (method == "Backward")
+        finite_difference_method_ = FiniteDifferenceMethod::Backward;
+    else if (method == "Central")
+        finite_difference_method_ = FiniteDifferenceMethod::Central;
+    else
+        ThrowNamed("Unknown finite difference method: " << method);
+}
+
+void TaskMap::SetFiniteDifferenceStep(double step)
+{
+    if (!(step > 0.0)) ThrowNamed("Finite difference step has to be positive, got " << step);
+    finite_difference_step_ = step;
+}
+
+void TaskMap::UpdatePerturbed(Eigen::VectorXdRefConst q, int i, double value, bool subtree_update, Eigen::VectorXdRef phi)
+{
+    finite_difference_q_(i) = value;
+    if (subtree_update)
+        scene_->GetKinematicTree().UpdateControlledJoint(i, value);
+    else
+        scene_->GetKinematicTree().Update(finite_difference_q_);
+    Update(finite_difference_q_, phi);
+    finite_difference_q_(i) = q(i);
+}
+
+void TaskMap::FiniteDifferenceJacobian(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian)
+{
+    if (jacobian.rows() != TaskSpaceDim() || jacobian.cols() != q.rows())
+        ThrowNamed("Jacobian dimension mismatch! Expected " << TaskSpaceDim() << "x" << q.rows() << ", got " << jacobian.rows() << "x" << jacobian.cols());
 
     if (scene_ == nullptr)
     {
         ThrowNamed("Scene is not initialised!");
     }
 
-    // Set constants
-    constexpr double h = 1e-6;
-    constexpr double h_inverse = 1.0 / h;
+    KinematicTree& tree = scene_->GetKinematicTree();
+    const double h = finite_difference_step_;
+    const double h_inverse = 1.0 / h;
+    // Perturbing one joint only moves the subtree below it, the rest of the tree can be reused.
+    const bool subtree_update = finite_difference_subtree_updates_ && q.rows() == tree.GetNumControlledJoints();
 
     // Compute x/phi using forward mapping (no jacobian)
     Update(q, phi);
 
-    // Setup for gradient estimate
-    Eigen::VectorXd q_backward(q.size()), phi_backward(TaskSpaceDim());
+    finite_difference_q_ = q;
+    finite_difference_phi_plus_.resize(phi.rows());
+    finite_difference_phi_minus_.resize(phi.rows());
 
-    // Backward finite differencing
     for (int i = 0; i < jacobian.cols(); ++i)
     {
-        // Compute and set x_backward as model state
-        q_backward = q;
-        q_backward(i) -= h;
-        scene_->GetKinematicTree().Update(q_backward);
-
-        // Compute phi_backward using forward mapping (no jacobian)
-        Update(q_backward, phi_backward);
-
-        // Compute gradient estimate
-        jacobian.col(i).noalias() = h_inverse * (phi - phi_backward);
+        switch (finite_difference_method_)
+        {
+            case FiniteDifferenceMethod::Forward:
+                UpdatePerturbed(q, i, q(i) + h, subtree_update, finite_difference_phi_plus_);
+                jacobian.col(i).noalias() = h_inverse * (finite_difference_phi_plus_ - phi);
+                break;
+            case FiniteDifferenceMethod::Backward:
+                UpdatePerturbed(q, i, q(i) - h, subtree_update, finite_difference_phi_minus_);
+                jacobian.col(i).noalias() = h_inverse * (phi - finite_difference_phi_minus_);
+                break;
+            case FiniteDifferenceMethod::Central:
+                UpdatePerturbed(q, i, q(i) + h, subtree_update, finite_difference_phi_plus_);
+                UpdatePerturbed(q, i, q(i) - h, subtree_update, finite_difference_phi_minus_);
+                jacobian.col(i).noalias() = (0.5 * h_inverse) * (finite_difference_phi_plus_ - finite_difference_phi_minus_);
+                break;
+        }
+
+        // Reset the perturbed joint
+        if (subtree_update) tree.UpdateControlledJoint(i, q(i));
     }
 
     // Reset model state
-    scene_->GetKinematicTree().Update(q);
+    if (!subtree_update) tree.Update(q);
 }
 
 void TaskMap::Update(Eigen::VectorXdRefConst q, Eigen::VectorXdRef phi, Eigen::MatrixXdRef jacobian, HessianRef hessian)
@@ -73,7 +73,7 @@ void EndPoseTask::Initialize(const std::vector<exotica::Initializer>& inits, Pla
     rho = Eigen::VectorXd::Ones(num_tasks);
     if (prob->GetFlags() & KIN_J) jacobian = Eigen::MatrixXd(length_jacobian, prob->N);
     if (prob->GetFlags() & KIN_H) hessian.setConstant(length_jacobian, Eigen::MatrixXd::Zero(prob->N, prob->N));
-    S = Eigen::MatrixXd::Identity(length_jacobian, length_jacobian);
+    S.setIdentity(length_jacobian);
     ydiff = Eigen::VectorXd::Zero(length_jacobian);
 
     for (int i = 0; i < num_tasks; ++i)
@@ -110,10 +110,7 @@ void EndPoseTask::UpdateS()
 {
     for (const TaskIndexing& task : indexing)
     {
-        for (int i = 0; i < task.length_jacobian; ++i)
-        {
-            S(i + task.start_jacobian, i + task.start_jacobian) = rho(task.id);
-        }
+        S.diagonal().segment(task.start_jacobian, task.length_jacobian).setConstant(rho(task.id));
         if (rho(task.id) != 0.0) tasks[task.id]->is_used = true;
     }
 }
@@ -207,7 +204,7 @@ Eigen::MatrixXd EndPoseTask::GetS(const std::string& task_name) const
         if (tasks[i]->GetObjectName() == task_name)
         {
             // We are interested in the square matrix of dimension length_jacobian
-            return S.block(indexing[i].start_jacobian, indexing[i].start_jacobian, indexing[i].length_jacobian, indexing[i].length_jacobian);
+            return S.diagonal().segment(indexing[i].start_jacobian, indexing[i].length_jacobian).asDiagonal();
         }
     }
     ThrowPretty("Cannot get S. Task map '" << task_name << "' does not exist.");
@@ -249,10 +246,7 @@ void TimeIndexedTask::UpdateS()
     {
         for (const TaskIndexing& task : indexing)
         {
-            for (int i = 0; i < task.length_jacobian; ++i)
-            {
-                S[t](i + task.start_jacobian, i + task.start_jacobian) = rho[t](task.id);
-            }
+            S[t].diagonal().segment(task.start_jacobian, task.length_jacobian).setConstant(rho[t](task.id));
             if (rho[t](task.id) != 0.0) tasks[task.id]->is_used = true;
         }
     }
@@ -411,7 +405,7 @@ Eigen::MatrixXd TimeIndexedTask::GetS(const std::string& task_name, int t) const
         if (tasks[i]->GetObjectName() == task_name)
         {
             // We are interested in the square matrix of dimension length_jacobian
-            return S[t].block(indexing[i].start_jacobian, indexing[i].start_jacobian, indexing[i].length_jacobian, indexing[i].length_jacobian);
+            return S[t].diagonal().segment(indexing[i].start_jacobian, indexing[i].length_jacobian).asDiagonal();
         }
     }
     ThrowPretty("Cannot get S. Task map '" << task_name << "' does not exist.");
@@ -437,7 +431,7 @@ void TimeIndexedTask::ReinitializeVariables(int _T, PlanningProblemPtr _prob, co
         ddPhi_ddu.assign(T, Hessian::Constant(length_jacobian, Eigen::MatrixXd::Zero(_prob->GetScene()->get_num_controls(), _prob->GetScene()->get_num_controls())));
         ddPhi_dxdu.assign(T, Hessian::Constant(length_jacobian, Eigen::MatrixXd::Zero(_prob->GetScene()->get_num_state_derivative(), _prob->GetScene()->get_num_controls())));
     }
-    S.assign(T, Eigen::MatrixXd::Identity(length_jacobian, length_jacobian));
+    S.assign(T, Eigen::DiagonalMatrix<double, Eigen::Dynamic>(Eigen::VectorXd::Ones(length_jacobian)));
     ydiff.assign(T, Eigen::VectorXd::Zero(length_jacobian));
 
     if (num_tasks != task_initializers_.size()) ThrowPretty("Number of tasks does not match internal number of tasks!");
@@ -497,7 +491,7 @@ void SamplingTask::Initialize(const std::vector<exotica::Initializer>& inits, Pl
     y = Phi;
     y.SetZero(length_Phi);
     rho = Eigen::VectorXd::Ones(num_tasks);
-    S = Eigen::MatrixXd::Identity(length_jacobian, length_jacobian);
+    S.setIdentity(length_jacobian);
     ydiff = Eigen::VectorXd::Zero(length_jacobian);
 
     for (int i = 0; i < num_tasks; ++i)
@@ -534,10 +528,7 @@ void SamplingTask::UpdateS()
 {
     for (const TaskIndexing& task : indexing)
     {
-        for (int i = 0; i < task.length_jacobian; ++i)
-        {
-            S(i + task.start_jacobian, i + task.start_jacobian) = rho(task.id);
-        }
+        S.diagonal().segment(task.start_jacobian, task.length_jacobian).setConstant(rho(task.id));
         if (rho(task.id) != 0.0) tasks[task.id]->is_used = true;
     }
 }
@@ -33,6 +33,7 @@
 #include <random>
 #include <regex>
 #include <typeinfo>  // The run-time type information (RTTI) Functionality of C++
+#include <unistd.h>
 
 #include <geometric_shapes/shapes.h>
 #include <octomap/OcTree.h>
@@ -206,4 +207,13 @@ bool PathExists(const std::string& path)
     std::ifstream file(ParsePath(path));
     return (bool)file;
 }
+
+std::size_t GetResidentSetSize()
+{
+    // The second field of /proc/self/statm is the number of resident pages.
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size, resident;
+    if (!(statm >> size >> resident)) return 0;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
 }  // namespace exotica
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+#include <geometric_shapes/shape_operations.h>
+
+#include <exotica_core/tools/continuous_motion_checker.h>
+
+namespace exotica
+{
+namespace
+{
+bool IsRotational(const KDL::Joint& joint)
+{
+    return joint.getType() == KDL::Joint::RotAxis || joint.getType() == KDL::Joint::RotX || joint.getType() == KDL::Joint::RotY || joint.getType() == KDL::Joint::RotZ;
+}
+
+bool IsTranslational(const KDL::Joint& joint)
+{
+    return joint.getType() == KDL::Joint::TransAxis || joint.getType() == KDL::Joint::TransX || joint.getType() == KDL::Joint::TransY || joint.getType() == KDL::Joint::TransZ;
+}
+}  // namespace
+
+ContinuousMotionChecker::ContinuousMotionChecker(ScenePtr scene, bool self_collision, double tolerance, double max_world_speed)
+    : scene_(scene), self_collision_(self_collision), tolerance_(tolerance), max_world_speed_(max_world_speed)
+{
+    if (!scene_) ThrowPretty("Scene is not set!");
+    if (tolerance_ <= 0.0) ThrowPretty("Tolerance has to be positive, got " << tolerance_);
+    if (max_world_speed_ < 0.0) ThrowPretty("Maximum world speed has to be non-negative, got " << max_world_speed_);
+    UpdateLeverArms();
+}
+
+void ContinuousMotionChecker::UpdateLeverArms()
+{
+    const KinematicTree& tree = scene_->GetKinematicTree();
+    const CollisionScenePtr& collision_scene = scene_->GetCollisionScene();
+    const double scale = collision_scene ? collision_scene->GetRobotLinkScale() : 1.0;
+    const double padding = collision_scene ? collision_scene->GetRobotLinkPadding() : 0.0;
+
+    lever_arms_ = Eigen::VectorXd::Zero(tree.GetNumControlledJoints());
+    // Mimic joints move with the joint they mimic, their lever arms are added to it
+    std::map<std::shared_ptr<KinematicElement>, double> mimic_lever_arms;
+
+    for (const auto& element : tree.GetModelTree())
+    {
+        if (!element->shape || !(element->is_robot_link || element->closest_robot_link.lock())) continue;
+
+        Eigen::Vector3d center;
+        double radius;
+        shapes::computeShapeBoundingSphere(element->shape.get(), center, radius);
+        // Distance between the origin of the current frame and any point of the shape
+        double reach = (center.norm() + radius) * scale + padding;
+
+        for (std::shared_ptr<KinematicElement> current = element; current; current = current->parent.lock())
+        {
+            const KDL::Joint& joint = current->segment.getJoint();
+            const KDL::Vector tip = current->segment.getFrameToTip().p;
+            // The joint axis passes through the joint origin, which stays fixed in the parent frame
+            const double reach_from_joint = (tip - joint.JointOrigin()).Norm() + reach;
+
+            if (IsRotational(joint) || IsTranslational(joint))
+            {
+                const double lever_arm = IsRotational(joint) ? reach_from_joint : 1.0;
+                if (current->is_controlled)
+                    lever_arms_(current->control_id) = std::max(lever_arms_(current->control_id), lever_arm);
+                else if (current->is_mimic_joint)
+                    mimic_lever_arms[current] = std::max(mimic_lever_arms[current], std::abs(current->mimic_multiplier) * lever_arm);
+            }
+
+            reach = joint.JointOrigin().Norm() + reach_from_joint;
+            if (IsTranslational(joint) && current->joint_limits.size() == 2)
+                reach += std::max(std::abs(current->joint_limits[0]), std::abs(current->joint_limits[1]));
+        }
+    }
+
+    for (const auto& mimic : mimic_lever_arms)
+    {
+        for (const auto& element : tree.GetModelTree())
+        {
+            if (element->is_controlled && element->id == mimic.first->mimic_joint_id) lever_arms_(element->control_id) += mimic.second;
+        }
+    }
+}
+
+double ContinuousMotionChecker::GetMinimumDistance(bool self, double margin)
+{
+    ++num_distance_queries_;
+    const std::vector<CollisionProxy> proxies = self ? scene_->GetCollisionScene()->GetRobotToRobotCollisionDistance(margin) : scene_->GetCollisionScene()->GetRobotToWorldCollisionDistance(margin);
+    double distance = std::numeric_limits<double>::infinity();
+    for (const CollisionProxy& proxy : proxies) distance = std::min(distance, proxy.distance);
+    return distance;
+}
+
+bool ContinuousMotionChecker::CheckMotion(Eigen::VectorXdRefConst x1, Eigen::VectorXdRefConst x2, double& last_valid, double t1, double t2)
+{
+    num_distance_queries_ = 0;
+    last_valid = 0.0;
+    if (x1.rows() != lever_arms_.rows() || x2.rows() != lever_arms_.rows()) ThrowPretty("Wrong state size, expected " << lever_arms_.rows() << ", got " << x1.rows() << " and " << x2.rows());
+
+    // Displacement bounds per unit of the motion fraction. Robot links move relative to each other at most twice as fast.
+    const double robot_bound = GetDisplacementBound(x2 - x1);
+    const double world_bound = robot_bound + max_world_speed_ * std::abs(t2 - t1);
+    const double self_bound = 2.0 * robot_bound;
+    if (world_bound == 0.0) return true;
+
+    double s = 0.0;
+    while (true)
+    {
+        x_ = x1 + s * (x2 - x1);
+        scene_->Update(x_, t1 + s * (t2 - t1));
+        if (!scene_->GetCollisionScene()->GetAlwaysExternallyUpdatedCollisionScene()) scene_->GetCollisionScene()->UpdateCollisionObjectTransforms();
+
+        // Pairs further apart than the remaining displacement are culled by their bounding volumes
+        const double remaining = 1.0 - s;
+        const double world_distance = GetMinimumDistance(false, remaining * world_bound + tolerance_);
+        const double self_distance = self_collision_ && self_bound > 0.0 ? GetMinimumDistance(true, remaining * self_bound + tolerance_) : std::numeric_limits<double>::infinity();
+        if (world_distance < tolerance_ || self_distance < tolerance_)
+        {
+            last_valid = s;
+            return false;
+        }
+
+        double step = world_distance / world_bound;
+        if (self_bound > 0.0) step = std::min(step, self_distance / self_bound);
+        s += step;
+        if (s >= 1.0) break;
+    }
+
+    last_valid = 1.0;
+    return true;
+}
+}  // namespace exotica
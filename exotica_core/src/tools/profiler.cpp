@@ -0,0 +1,374 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <exotica_core/tools.h>
+#include <exotica_core/tools/profiler.h>
+
+namespace exotica
+{
+namespace
+{
+constexpr std::size_t kDefaultBufferSize = 1 << 16;
+constexpr std::size_t kInitialBufferSize = 64;
+
+struct ZoneStatistics
+{
+    std::size_t calls = 0;
+    std::int64_t total = 0;
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max = 0;
+};
+
+void Merge(ZoneStatistics& into, const ZoneStatistics& from)
+{
+    into.calls += from.calls;
+    into.total += from.total;
+    into.min = std::min(into.min, from.min);
+    into.max = std::max(into.max, from.max);
+}
+
+void WriteJsonString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (const char* c = str; *c; ++c)
+    {
+        switch (*c)
+        {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*c) << std::dec << std::setfill(' ');
+                else
+                    out << *c;
+        }
+    }
+    out << '"';
+}
+}  // namespace
+
+struct Profiler::ThreadBuffer
+{
+    explicit ThreadBuffer(int id_in, std::size_t size) : id(id_in), max_events(size) {}
+
+    void Record(const Event& event)
+    {
+        if (max_events == 0) return;
+        if (events.size() < max_events)
+        {
+            // Grow geometrically, but not beyond the ring size: threads recording a few zones stay small.
+            if (events.size() == events.capacity()) events.reserve(std::min(max_events, std::max<std::size_t>(kInitialBufferSize, 2 * events.size())));
+            events.push_back(event);
+        }
+        else
+        {
+            events[next] = event;
+        }
+        if (++next == max_events) next = 0;
+    }
+
+    /// Index of the oldest event in the ring.
+    std::size_t Oldest() const { return events.size() == max_events ? next : 0; }
+
+    /// Reorders the events oldest first and shrinks the ring to them.
+    void Linearize()
+    {
+        std::rotate(events.begin(), events.begin() + Oldest(), events.end());
+        events.shrink_to_fit();
+        max_events = events.size();
+        next = 0;
+    }
+
+    /// Changes the ring size, dropping all events.
+    void Resize(std::size_t size)
+    {
+        std::vector<Event>().swap(events);
+        max_events = size;
+        next = 0;
+    }
+
+    void Clear()
+    {
+        events.clear();
+        next = 0;
+        statistics.clear();
+    }
+
+    const int id;
+    int depth = 0;  ///< Only accessed by the owning thread
+    std::mutex lock;
+    std::size_t max_events;     ///< Ring size, events grows on demand up to it
+    std::vector<Event> events;  ///< Ring of the most recent events, the oldest is at Oldest()
+    std::size_t next = 0;       ///< Position of the next event in the ring
+    std::unordered_map<const char*, ZoneStatistics> statistics;
+};
+
+/// Hands the buffer of the owning thread back to the profiler when the thread exits.
+struct Profiler::ThreadBufferOwner
+{
+    ~ThreadBufferOwner()
+    {
+        if (buffer) Profiler::Instance().RetireThreadBuffer(buffer);
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+Profiler& Profiler::Instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : buffer_size_(kDefaultBufferSize), epoch_(std::chrono::steady_clock::now()), retired_(std::make_shared<ThreadBuffer>(-1, 0))
+{
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::SetBufferSize(std::size_t size)
+{
+    buffer_size_ = size;
+    std::lock_guard<std::mutex> threads_lock(threads_lock_);
+    for (const auto& thread : threads_)
+    {
+        std::lock_guard<std::mutex> lock(thread->lock);
+        thread->Resize(size);
+    }
+    TrimRetiredEvents();
+}
+
+std::size_t Profiler::GetBufferSize() const
+{
+    return buffer_size_;
+}
+
+const char* Profiler::Intern(const std::string& name)
+{
+    static std::mutex lock;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> guard(lock);
+    return names.insert(name).first->c_str();
+}
+
+std::int64_t Profiler::Now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBufferOwner owner;
+    if (!owner.buffer)
+    {
+        std::lock_guard<std::mutex> threads_lock(threads_lock_);
+        owner.buffer = std::make_shared<ThreadBuffer>(next_thread_id_++, buffer_size_);
+        threads_.push_back(owner.buffer);
+    }
+    return *owner.buffer;
+}
+
+void Profiler::RetireThreadBuffer(const std::shared_ptr<ThreadBuffer>& buffer)
+{
+    std::lock_guard<std::mutex> threads_lock(threads_lock_);
+    threads_.erase(std::remove(threads_.begin(), threads_.end(), buffer), threads_.end());
+    std::lock_guard<std::mutex> lock(buffer->lock);
+    for (const auto& it : buffer->statistics) Merge(retired_->statistics[it.first], it.second);
+    buffer->statistics.clear();
+    if (buffer->events.empty()) return;
+
+    buffer->Linearize();
+    retired_events_ += buffer->events.size();
+    retired_threads_.push_back(buffer);
+    TrimRetiredEvents();
+}
+
+void Profiler::TrimRetiredEvents()
+{
+    while (retired_events_ > buffer_size_)
+    {
+        ThreadBuffer& oldest = *retired_threads_.front();
+        const std::size_t excess = std::min(retired_events_ - buffer_size_, oldest.events.size());
+        oldest.events.erase(oldest.events.begin(), oldest.events.begin() + excess);
+        oldest.max_events = oldest.events.size();
+        retired_events_ -= excess;
+        if (oldest.events.empty()) retired_threads_.pop_front();
+    }
+}
+
+int Profiler::Begin()
+{
+    return GetThreadBuffer().depth++;
+}
+
+void Profiler::End(const char* name, std::int64_t begin, int depth)
+{
+    const std::int64_t end = Now();
+    ThreadBuffer& buffer = GetThreadBuffer();
+    buffer.depth = depth;
+
+    std::lock_guard<std::mutex> lock(buffer.lock);
+    buffer.Record({name, begin, end, depth});
+
+    ZoneStatistics& stats = buffer.statistics[name];
+    const std::int64_t duration = end - begin;
+    ++stats.calls;
+    stats.total += duration;
+    stats.min = std::min(stats.min, duration);
+    stats.max = std::max(stats.max, duration);
+}
+
+std::vector<ProfilerZoneStatistics> Profiler::GetSummary() const
+{
+    // Identical names may be stored at different addresses (e.g., literals in different libraries).
+    std::map<std::string, ZoneStatistics> merged;
+    {
+        std::lock_guard<std::mutex> threads_lock(threads_lock_);
+        for (const auto& it : retired_->statistics) Merge(merged[it.first], it.second);
+        for (const auto& thread : threads_)
+        {
+            std::lock_guard<std::mutex> lock(thread->lock);
+            for (const auto& it : thread->statistics) Merge(merged[it.first], it.second);
+        }
+    }
+
+    std::vector<ProfilerZoneStatistics> summary;
+    summary.reserve(merged.size());
+    for (const auto& it : merged)
+    {
+        ProfilerZoneStatistics zone;
+        zone.name = it.first;
+        zone.calls = it.second.calls;
+        zone.total = static_cast<double>(it.second.total) * 1e-9;
+        zone.min = static_cast<double>(it.second.min) * 1e-9;
+        zone.max = static_cast<double>(it.second.max) * 1e-9;
+        summary.push_back(zone);
+    }
+    std::stable_sort(summary.begin(), summary.end(), [](const ProfilerZoneStatistics& a, const ProfilerZoneStatistics& b) { return a.total > b.total; });
+    return summary;
+}
+
+std::string Profiler::GetSummaryTable() const
+{
+    const std::vector<ProfilerZoneStatistics> summary = GetSummary();
+    std::size_t width = 4;
+    for (const auto& zone : summary) width = std::max(width, zone.name.size());
+
+    std::ostringstream table;
+    table << std::left << std::setw(static_cast<int>(width)) << "Zone" << std::right
+          << std::setw(12) << "Calls"
+          << std::setw(14) << "Total [ms]"
+          << std::setw(14) << "Mean [us]"
+          << std::setw(14) << "Min [us]"
+          << std::setw(14) << "Max [us]" << '\n';
+    table << std::fixed << std::setprecision(3);
+    for (const auto& zone : summary)
+    {
+        table << std::left << std::setw(static_cast<int>(width)) << zone.name << std::right
+              << std::setw(12) << zone.calls
+              << std::setw(14) << zone.total * 1e3
+              << std::setw(14) << zone.Mean() * 1e6
+              << std::setw(14) << zone.min * 1e6
+              << std::setw(14) << zone.max * 1e6 << '\n';
+    }
+    return table.str();
+}
+
+std::string Profiler::GetChromeTrace() const
+{
+    std::ostringstream trace;
+    trace << std::fixed << std::setprecision(3);
+    trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> threads_lock(threads_lock_);
+    std::vector<std::shared_ptr<ThreadBuffer>> threads(retired_threads_.begin(), retired_threads_.end());
+    threads.insert(threads.end(), threads_.begin(), threads_.end());
+    for (const auto& thread : threads)
+    {
+        std::lock_guard<std::mutex> lock(thread->lock);
+        trace << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread->id
+              << ",\"args\":{\"name\":\"Thread " << thread->id << "\"}}";
+        first = false;
+
+        // Oldest event first
+        const std::size_t start = thread->Oldest();
+        for (std::size_t i = 0; i < thread->events.size(); ++i)
+        {
+            const Event& event = thread->events[(start + i) % thread->events.size()];
+            trace << ",\n{\"name\":";
+            WriteJsonString(trace, event.name);
+            trace << ",\"cat\":\"exotica\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread->id
+                  << ",\"ts\":" << static_cast<double>(event.begin) * 1e-3
+                  << ",\"dur\":" << static_cast<double>(event.end - event.begin) * 1e-3
+                  << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+    }
+    trace << "\n]}\n";
+    return trace.str();
+}
+
+void Profiler::ExportChromeTrace(const std::string& file_name) const
+{
+    std::ofstream file(ParsePath(file_name));
+    if (!file.is_open()) ThrowPretty("Can't open file '" << file_name << "' for writing!");
+    file << GetChromeTrace();
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> threads_lock(threads_lock_);
+    retired_->Clear();
+    retired_threads_.clear();
+    retired_events_ = 0;
+    for (const auto& thread : threads_)
+    {
+        std::lock_guard<std::mutex> lock(thread->lock);
+        thread->Clear();
+    }
+}
+}  // namespace exotica
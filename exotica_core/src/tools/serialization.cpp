@@ -0,0 +1,467 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <typeinfo>
+#include <vector>
+
+#include <exotica_core/tools.h>
+#include <exotica_core/tools/serialization.h>
+
+namespace exotica
+{
+namespace
+{
+constexpr char kMagic[4] = {'E', 'X', 'O', 'B'};
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 16;
+constexpr std::size_t kAlignment = sizeof(double);
+
+// Type tags of serialized property values
+enum class ValueType : uint32_t
+{
+    Empty = 0,
+    Bool,
+    Int,
+    Double,
+    String,
+    VectorXd,
+    Vector2d,
+    Vector3d,
+    Vector4d,
+    VectorXi,
+    StringList,
+    IntList,
+    BoolList,
+    Initializer,
+    InitializerList
+};
+
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(BinaryRecordType type)
+    {
+        buffer_.append(kMagic, sizeof(kMagic));
+        Write<uint32_t>(kVersion);
+        Write<uint32_t>(static_cast<uint32_t>(type));
+        Write<uint32_t>(0);
+    }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+        buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void WriteString(const std::string& value)
+    {
+        Write<uint64_t>(value.size());
+        buffer_.append(value);
+    }
+
+    template <typename T>
+    void WriteArray(const T* data, std::size_t size)
+    {
+        buffer_.append(Padding(), '\0');
+        buffer_.append(reinterpret_cast<const char*>(data), size * sizeof(T));
+    }
+
+    template <typename Derived>
+    void WriteMatrix(const Eigen::DenseBase<Derived>& matrix)
+    {
+        Write<uint64_t>(matrix.rows());
+        Write<uint64_t>(matrix.cols());
+        const Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic, Eigen::Dynamic> tmp = matrix;
+        WriteArray(tmp.data(), tmp.size());
+    }
+
+    const std::string& GetBuffer() const { return buffer_; }
+
+private:
+    std::size_t Padding() const { return (kAlignment - buffer_.size() % kAlignment) % kAlignment; }
+
+    std::string buffer_;
+};
+
+class BinaryReader
+{
+public:
+    BinaryReader(const char* data, std::size_t size, BinaryRecordType type) : data_(data), size_(size)
+    {
+        if (size_ < kHeaderSize || std::memcmp(data_, kMagic, sizeof(kMagic)) != 0) ThrowPretty("Not a valid EXOTica binary buffer!");
+        position_ = sizeof(kMagic);
+        const uint32_t version = Read<uint32_t>();
+        if (version != kVersion) ThrowPretty("Unsupported binary format version " << version << ", expected " << kVersion << "!");
+        const uint32_t stored_type = Read<uint32_t>();
+        if (stored_type != static_cast<uint32_t>(type)) ThrowPretty("Binary buffer contains record type " << stored_type << ", expected " << static_cast<uint32_t>(type) << "!");
+        position_ = kHeaderSize;
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T value;
+        std::memcpy(&value, Advance(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // Reads the number of elements of a list whose elements occupy at least min_element_size bytes each,
+    // so that a corrupt count can't allocate more elements than the remaining buffer can hold.
+    std::size_t ReadCount(std::size_t min_element_size)
+    {
+        const uint64_t count = Read<uint64_t>();
+        if (count > (size_ - position_) / min_element_size) ThrowPretty("Binary buffer is truncated!");
+        return static_cast<std::size_t>(count);
+    }
+
+    std::string ReadString()
+    {
+        const std::size_t size = Read<uint64_t>();
+        return std::string(Advance(size), size);
+    }
+
+    // Returns a pointer to the aligned array in the buffer.
+    template <typename T>
+    const char* ReadArray(std::size_t size)
+    {
+        Advance((kAlignment - position_ % kAlignment) % kAlignment);
+        if (size > (size_ - position_) / sizeof(T)) ThrowPretty("Binary buffer is truncated!");
+        return Advance(size * sizeof(T));
+    }
+
+    template <typename T>
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> ReadMatrix()
+    {
+        Eigen::Index rows, cols;
+        const char* data = ReadMatrixData<T>(rows, cols);
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> ret(rows, cols);
+        if (ret.size() > 0) std::memcpy(ret.data(), data, ret.size() * sizeof(T));
+        return ret;
+    }
+
+    template <typename T>
+    const char* ReadMatrixData(Eigen::Index& rows, Eigen::Index& cols)
+    {
+        rows = static_cast<Eigen::Index>(Read<uint64_t>());
+        cols = static_cast<Eigen::Index>(Read<uint64_t>());
+        if (rows < 0 || cols < 0 || (rows > 0 && static_cast<uint64_t>(cols) > std::numeric_limits<uint64_t>::max() / static_cast<uint64_t>(rows))) ThrowPretty("Invalid matrix size in binary buffer!");
+        return ReadArray<T>(static_cast<std::size_t>(rows * cols));
+    }
+
+    bool AtEnd() const { return position_ == size_; }
+
+private:
+    const char* Advance(std::size_t size)
+    {
+        if (size > size_ - position_) ThrowPretty("Binary buffer is truncated!");
+        const char* ret = data_ + position_;
+        position_ += size;
+        return ret;
+    }
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t position_ = 0;
+};
+
+void WriteInitializer(BinaryWriter& writer, const Initializer& init);
+Initializer ReadInitializer(BinaryReader& reader);
+
+void WriteValue(BinaryWriter& writer, const Property& prop)
+{
+    const boost::any value = prop.Get();
+    const std::type_info& type = value.type();
+    if (value.empty())
+    {
+        writer.Write(ValueType::Empty);
+    }
+    else if (type == typeid(bool))
+    {
+        writer.Write(ValueType::Bool);
+        writer.Write<uint8_t>(boost::any_cast<bool>(value));
+    }
+    else if (type == typeid(int))
+    {
+        writer.Write(ValueType::Int);
+        writer.Write<int64_t>(boost::any_cast<int>(value));
+    }
+    else if (type == typeid(double))
+    {
+        writer.Write(ValueType::Double);
+        writer.Write(boost::any_cast<double>(value));
+    }
+    else if (type == typeid(std::string))
+    {
+        writer.Write(ValueType::String);
+        writer.WriteString(boost::any_cast<std::string>(value));
+    }
+    else if (type == typeid(Eigen::VectorXd))
+    {
+        writer.Write(ValueType::VectorXd);
+        writer.WriteMatrix(boost::any_cast<Eigen::VectorXd>(value));
+    }
+    else if (type == typeid(Eigen::Vector2d))
+    {
+        writer.Write(ValueType::Vector2d);
+        writer.WriteMatrix(boost::any_cast<Eigen::Vector2d>(value));
+    }
+    else if (type == typeid(Eigen::Vector3d))
+    {
+        writer.Write(ValueType::Vector3d);
+        writer.WriteMatrix(boost::any_cast<Eigen::Vector3d>(value));
+    }
+    else if (type == typeid(Eigen::Vector4d))
+    {
+        writer.Write(ValueType::Vector4d);
+        writer.WriteMatrix(boost::any_cast<Eigen::Vector4d>(value));
+    }
+    else if (type == typeid(Eigen::VectorXi))
+    {
+        writer.Write(ValueType::VectorXi);
+        writer.WriteMatrix(boost::any_cast<Eigen::VectorXi>(value).cast<int64_t>());
+    }
+    else if (type == typeid(std::vector<std::string>))
+    {
+        writer.Write(ValueType::StringList);
+        const std::vector<std::string>& list = boost::any_cast<const std::vector<std::string>&>(value);
+        writer.Write<uint64_t>(list.size());
+        for (const std::string& item : list) writer.WriteString(item);
+    }
+    else if (type == typeid(std::vector<int>))
+    {
+        writer.Write(ValueType::IntList);
+        const std::vector<int>& list = boost::any_cast<const std::vector<int>&>(value);
+        writer.Write<uint64_t>(list.size());
+        for (const int item : list) writer.Write<int64_t>(item);
+    }
+    else if (type == typeid(std::vector<bool>))
+    {
+        writer.Write(ValueType::BoolList);
+        const std::vector<bool>& list = boost::any_cast<const std::vector<bool>&>(value);
+        writer.Write<uint64_t>(list.size());
+        for (const bool item : list) writer.Write<uint8_t>(item);
+    }
+    else if (type == typeid(Initializer))
+    {
+        writer.Write(ValueType::Initializer);
+        WriteInitializer(writer, boost::any_cast<const Initializer&>(value));
+    }
+    else if (type == typeid(std::vector<Initializer>))
+    {
+        writer.Write(ValueType::InitializerList);
+        const std::vector<Initializer>& list = boost::any_cast<const std::vector<Initializer>&>(value);
+        writer.Write<uint64_t>(list.size());
+        for (const Initializer& item : list) WriteInitializer(writer, item);
+    }
+    else
+    {
+        ThrowPretty("Can't serialize property '" << prop.GetName() << "' of type '" << GetTypeName(type) << "'!");
+    }
+}
+
+template <typename T>
+T ReadFixedVector(BinaryReader& reader)
+{
+    const Eigen::MatrixXd tmp = reader.ReadMatrix<double>();
+    if (tmp.rows() != T::RowsAtCompileTime || tmp.cols() != 1) ThrowPretty("Invalid vector size " << tmp.rows() << "x" << tmp.cols() << " in binary buffer!");
+    return tmp;
+}
+
+boost::any ReadValue(BinaryReader& reader)
+{
+    const ValueType type = reader.Read<ValueType>();
+    switch (type)
+    {
+        case ValueType::Empty:
+            return boost::any();
+        case ValueType::Bool:
+            return static_cast<bool>(reader.Read<uint8_t>());
+        case ValueType::Int:
+            return static_cast<int>(reader.Read<int64_t>());
+        case ValueType::Double:
+            return reader.Read<double>();
+        case ValueType::String:
+            return reader.ReadString();
+        case ValueType::VectorXd:
+        {
+            const Eigen::MatrixXd tmp = reader.ReadMatrix<double>();
+            return Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(tmp.data(), tmp.size()));
+        }
+        case ValueType::Vector2d:
+            return ReadFixedVector<Eigen::Vector2d>(reader);
+        case ValueType::Vector3d:
+            return ReadFixedVector<Eigen::Vector3d>(reader);
+        case ValueType::Vector4d:
+            return ReadFixedVector<Eigen::Vector4d>(reader);
+        case ValueType::VectorXi:
+        {
+            const Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic> tmp = reader.ReadMatrix<int64_t>();
+            return Eigen::VectorXi(Eigen::Map<const Eigen::Matrix<int64_t, Eigen::Dynamic, 1>>(tmp.data(), tmp.size()).cast<int>());
+        }
+        case ValueType::StringList:
+        {
+            std::vector<std::string> ret(reader.ReadCount(sizeof(uint64_t)));
+            for (std::string& item : ret) item = reader.ReadString();
+            return ret;
+        }
+        case ValueType::IntList:
+        {
+            std::vector<int> ret(reader.ReadCount(sizeof(int64_t)));
+            for (int& item : ret) item = static_cast<int>(reader.Read<int64_t>());
+            return ret;
+        }
+        case ValueType::BoolList:
+        {
+            std::vector<bool> ret(reader.ReadCount(sizeof(uint8_t)));
+            for (std::size_t i = 0; i < ret.size(); ++i) ret[i] = reader.Read<uint8_t>();
+            return ret;
+        }
+        case ValueType::Initializer:
+            return ReadInitializer(reader);
+        case ValueType::InitializerList:
+        {
+            std::vector<Initializer> ret(reader.ReadCount(2 * sizeof(uint64_t)));
+            for (Initializer& item : ret) item = ReadInitializer(reader);
+            return ret;
+        }
+    }
+    ThrowPretty("Unknown property type " << static_cast<uint32_t>(type) << " in binary buffer!");
+}
+
+void WriteInitializer(BinaryWriter& writer, const Initializer& init)
+{
+    writer.WriteString(init.GetName());
+    writer.Write<uint64_t>(init.properties_.size());
+    for (const auto& it : init.properties_)
+    {
+        writer.WriteString(it.first);
+        writer.Write<uint8_t>(it.second.IsRequired());
+        WriteValue(writer, it.second);
+    }
+}
+
+Initializer ReadInitializer(BinaryReader& reader)
+{
+    Initializer ret(reader.ReadString());
+    const std::size_t size = reader.ReadCount(sizeof(uint64_t) + sizeof(uint8_t) + sizeof(ValueType));
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const std::string name = reader.ReadString();
+        const bool required = reader.Read<uint8_t>();
+        ret.properties_.emplace(name, Property(name, required, ReadValue(reader)));
+    }
+    return ret;
+}
+
+template <typename Function>
+auto ReadRecord(const std::string& buffer, BinaryRecordType type, Function read) -> decltype(read(std::declval<BinaryReader&>()))
+{
+    BinaryReader reader(buffer.data(), buffer.size(), type);
+    auto ret = read(reader);
+    if (!reader.AtEnd()) ThrowPretty("Unexpected data at the end of the binary buffer!");
+    return ret;
+}
+}  // namespace
+
+std::string SerializeInitializer(const Initializer& init)
+{
+    BinaryWriter writer(BinaryRecordType::Initializer);
+    WriteInitializer(writer, init);
+    return writer.GetBuffer();
+}
+
+Initializer DeserializeInitializer(const std::string& buffer)
+{
+    return ReadRecord(buffer, BinaryRecordType::Initializer, [](BinaryReader& reader) { return ReadInitializer(reader); });
+}
+
+std::string SerializeTrajectory(const Trajectory& trajectory)
+{
+    BinaryWriter writer(BinaryRecordType::Trajectory);
+    writer.Write(trajectory.GetRadius());
+    writer.WriteMatrix(trajectory.GetData());
+    return writer.GetBuffer();
+}
+
+Trajectory DeserializeTrajectory(const std::string& buffer)
+{
+    return ReadRecord(buffer, BinaryRecordType::Trajectory, [](BinaryReader& reader) {
+        const double radius = reader.Read<double>();
+        return Trajectory(reader.ReadMatrix<double>(), radius);
+    });
+}
+
+std::string SerializeMatrix(Eigen::MatrixXdRefConst matrix)
+{
+    BinaryWriter writer(BinaryRecordType::Matrix);
+    writer.WriteMatrix(matrix);
+    return writer.GetBuffer();
+}
+
+Eigen::MatrixXd DeserializeMatrix(const std::string& buffer)
+{
+    return ReadRecord(buffer, BinaryRecordType::Matrix, [](BinaryReader& reader) { return reader.ReadMatrix<double>(); });
+}
+
+Eigen::Map<const Eigen::MatrixXd> MapMatrix(const char* buffer, std::size_t size)
+{
+    if (reinterpret_cast<std::uintptr_t>(buffer) % kAlignment != 0) ThrowPretty("Binary buffer is not aligned!");
+    BinaryReader reader(buffer, size, BinaryRecordType::Matrix);
+    Eigen::Index rows, cols;
+    const char* data = reader.ReadMatrixData<double>(rows, cols);
+    return Eigen::Map<const Eigen::MatrixXd>(reinterpret_cast<const double*>(data), rows, cols);
+}
+
+BinaryRecordType GetBinaryRecordType(const std::string& buffer)
+{
+    if (buffer.size() < kHeaderSize || std::memcmp(buffer.data(), kMagic, sizeof(kMagic)) != 0) ThrowPretty("Not a valid EXOTica binary buffer!");
+    uint32_t type;
+    std::memcpy(&type, buffer.data() + 2 * sizeof(uint32_t), sizeof(type));
+    return static_cast<BinaryRecordType>(type);
+}
+
+void SaveBinary(const std::string& file_name, const std::string& buffer)
+{
+    std::ofstream file(ParsePath(file_name), std::ios::binary);
+    if (!file.is_open()) ThrowPretty("Can't open file '" << file_name << "' for writing!");
+    file.write(buffer.data(), buffer.size());
+}
+
+std::string LoadBinary(const std::string& file_name)
+{
+    std::ifstream file(ParsePath(file_name), std::ios::binary);
+    if (!file.is_open()) ThrowPretty("Can't open file '" << file_name << "'!");
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+}  // namespace exotica
@@ -27,6 +27,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <kdl/path.hpp>
 #include <kdl/path_line.hpp>
@@ -76,7 +78,85 @@ Trajectory::Trajectory(Eigen::MatrixXdRefConst data, double radius)
 
 KDL::Frame Trajectory::GetPosition(double t)
 {
-    return trajectory_->Pos(t);
+    if (!samples_.empty())
+    {
+        const double k = (t - sample_phase_) / sample_dt_;
+        const double k_round = std::round(k);
+        if (std::abs(k - k_round) < 1e-9 && k_round >= 0.0 && k_round < static_cast<double>(samples_.size()))
+        {
+            return samples_[static_cast<std::size_t>(k_round)];
+        }
+    }
+    return InterpolatePosition(t);
+}
+
+KDL::Frame Trajectory::InterpolatePosition(double t) const
+{
+    if (segment_end_time_.size() == 0) ThrowPretty("The trajectory is empty!");
+
+    // Times outside of the trajectory are clamped to the first and last waypoint.
+    const double* end_time = segment_end_time_.data();
+    const int num_segments = segment_end_time_.size();
+    const int i = std::lower_bound(end_time, end_time + num_segments, t) - end_time;
+    double tau;
+    int waypoint;
+    if (t <= 0.0)
+    {
+        waypoint = 0;
+        tau = 0.0;
+    }
+    else if (i == num_segments)
+    {
+        waypoint = num_segments - 1;
+        tau = 1.0;
+    }
+    else
+    {
+        const double start_time = i == 0 ? 0.0 : end_time[i - 1];
+        waypoint = i;
+        tau = (t - start_time) / (end_time[i] - start_time);
+    }
+
+    const Eigen::Vector3d position = waypoint_position_.col(waypoint) + tau * (waypoint_position_.col(waypoint + 1) - waypoint_position_.col(waypoint));
+    const Eigen::Quaterniond rotation = Eigen::Quaterniond(waypoint_rotation_.col(waypoint)).slerp(tau, Eigen::Quaterniond(waypoint_rotation_.col(waypoint + 1)));
+    return KDL::Frame(KDL::Rotation::Quaternion(rotation.x(), rotation.y(), rotation.z(), rotation.w()), KDL::Vector(position(0), position(1), position(2)));
+}
+
+constexpr std::size_t Trajectory::MaxSamples;
+
+void Trajectory::SetSampling(double dt, double offset)
+{
+    if (!(dt > 0.0) || !std::isfinite(dt) || !std::isfinite(offset))
+    {
+        samples_.clear();
+        sample_dt_ = 0.0;
+        return;
+    }
+
+    // The samples lie on the grid phase + k * dt, k >= 0, with the phase in [0, dt). Offsets that differ by a
+    // whole number of steps, e.g. the start time of a receding horizon advancing by dt, share the grid and keep the samples.
+    if (dt == sample_dt_ && !samples_.empty())
+    {
+        const double steps = (offset - sample_phase_) / dt;
+        if (std::abs(steps - std::round(steps)) < 1e-9) return;
+    }
+
+    sample_dt_ = dt;
+    sample_phase_ = offset - std::floor(offset / dt) * dt;
+    samples_.clear();
+    const double duration = segment_end_time_.size() > 0 ? segment_end_time_(segment_end_time_.size() - 1) : 0.0;
+
+    // Times beyond the last sample fall back to interpolation, so clamping only limits the speed-up.
+    const double num_samples = std::floor((duration - sample_phase_) / dt) + 1.0;
+    if (num_samples > static_cast<double>(MaxSamples))
+    {
+        WARNING("Sampling the trajectory with dt=" << dt << " requires " << num_samples << " samples, only the first " << MaxSamples << " are stored.");
+    }
+    samples_.reserve(static_cast<std::size_t>(std::max(0.0, std::min(num_samples, static_cast<double>(MaxSamples)))));
+    for (double t = sample_phase_; t <= duration && samples_.size() < MaxSamples; t = sample_phase_ + static_cast<double>(samples_.size()) * dt)
+    {
+        samples_.push_back(InterpolatePosition(t));
+    }
 }
 
 KDL::Twist Trajectory::GetVelocity(double t)
@@ -94,12 +174,12 @@ double Trajectory::GetDuration()
     return trajectory_->Duration();
 }
 
-Eigen::MatrixXd Trajectory::GetData()
+Eigen::MatrixXd Trajectory::GetData() const
 {
     return data_;
 }
 
-double Trajectory::GetRadius()
+double Trajectory::GetRadius() const
 {
     return radius_;
 }
@@ -117,6 +197,20 @@ void Trajectory::ConstructFromData(Eigen::MatrixXdRefConst data, double radius)
 {
     if (!(data.cols() == 4 || data.cols() == 7 || data.cols() == 8) || data.rows() < 2) ThrowPretty("Invalid trajectory data size!\nNeeds to contain 4, 7, or 8 columns and at least 2 rows.");
     trajectory_.reset(new KDL::Trajectory_Composite());
+    segment_end_time_.resize(data.rows() - 1);
+    waypoint_position_.resize(3, data.rows());
+    waypoint_rotation_.resize(4, data.rows());
+    for (int i = 0; i < data.rows(); ++i)
+    {
+        const KDL::Frame frame = GetFrame(data.row(i).tail(data.cols() - 1).transpose());
+        waypoint_position_.col(i) = Eigen::Map<const Eigen::Vector3d>(frame.p.data);
+        Eigen::Vector4d q;
+        frame.M.GetQuaternion(q(0), q(1), q(2), q(3));
+        // Interpolate along the shorter arc, like the single axis rotational interpolation of the segments.
+        if (i > 0 && q.dot(waypoint_rotation_.col(i - 1)) < 0.0) q = -q;
+        waypoint_rotation_.col(i) = q;
+        if (i > 0) segment_end_time_(i - 1) = data(i, 0) - data(0, 0);
+    }
     for (int i = 0; i < data.rows() - 1; ++i)
     {
         KDL::Frame f1 = GetFrame(data.row(i).tail(data.cols() - 1).transpose());
@@ -138,5 +232,7 @@ void Trajectory::ConstructFromData(Eigen::MatrixXdRefConst data, double radius)
     }
     data_ = data;
     radius_ = radius;
+    samples_.clear();
+    sample_dt_ = 0.0;
 }
 }  // namespace exotica
@@ -169,7 +169,7 @@ void VisualizationMeshcat::DisplayScene(bool use_mesh_materials)
             {
                 case shapes::SPHERE:
                 {
-                    std::shared_ptr<shapes::Sphere> sphere = std::static_pointer_cast<shapes::Sphere>(ToStdPtr(visual.shape));
+                    std::shared_ptr<const shapes::Sphere> sphere = std::static_pointer_cast<const shapes::Sphere>(ToStdPtr(visual.shape));
 
                     auto object = visualization::SetObject(path_prefix_ + visual.name,
                                                            visualization::CreateGeometryObject(visualization::GeometrySphere(sphere->radius),
@@ -181,7 +181,7 @@ void VisualizationMeshcat::DisplayScene(bool use_mesh_materials)
                 break;
                 case shapes::BOX:
                 {
-                    std::shared_ptr<shapes::Box> box = std::static_pointer_cast<shapes::Box>(ToStdPtr(visual.shape));
+                    std::shared_ptr<const shapes::Box> box = std::static_pointer_cast<const shapes::Box>(ToStdPtr(visual.shape));
 
                     auto object = visualization::SetObject(path_prefix_ + visual.name,
                                                            visualization::CreateGeometryObject(visualization::GeometryBox(box->size[0], box->size[1], box->size[2]),
@@ -193,7 +193,7 @@ void VisualizationMeshcat::DisplayScene(bool use_mesh_materials)
                 break;
                 case shapes::CYLINDER:
                 {
-                    std::shared_ptr<shapes::Cylinder> cylinder = std::static_pointer_cast<shapes::Cylinder>(ToStdPtr(visual.shape));
+                    std::shared_ptr<const shapes::Cylinder> cylinder = std::static_pointer_cast<const shapes::Cylinder>(ToStdPtr(visual.shape));
 
                     auto object = visualization::SetObject(path_prefix_ + visual.name,
                                                            visualization::CreateGeometryObject(visualization::GeometryCylinder(cylinder->radius, cylinder->length),
@@ -234,7 +234,6 @@ void VisualizationMeshcat::DisplayScene(bool use_mesh_materials)
                     {
                         if (visual.shape->type == shapes::MESH)
                         {
-                            std::shared_ptr<shapes::Mesh> shape = std::static_pointer_cast<shapes::Mesh>(visual.shape);
                             auto mesh = visualization::GeometryMeshBuffer(visual.shape);
                             auto object = visualization::SetObject(path_prefix_ + visual.name, visualization::CreateGeometryObject(mesh,
                                                                                                                                    visualization::Material(visualization::RGB(visual.color(0), visual.color(1), visual.color(2)), visual.color(3))));
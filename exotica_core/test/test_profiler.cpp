@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <thread>
+
+#include <exotica_core/tools/profiler.h>
+#include <gtest/gtest.h>
+
+using namespace exotica;
+
+namespace
+{
+void Inner()
+{
+    ProfilerZone zone("Inner");
+}
+
+void Outer(int n)
+{
+    ProfilerZone zone("Outer");
+    for (int i = 0; i < n; ++i) Inner();
+}
+
+const ProfilerZoneStatistics* FindZone(const std::vector<ProfilerZoneStatistics>& summary, const std::string& name)
+{
+    for (const auto& zone : summary)
+        if (zone.name == name) return &zone;
+    return nullptr;
+}
+
+std::size_t CountOccurrences(const std::string& str, const std::string& pattern)
+{
+    std::size_t count = 0;
+    for (std::size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) ++count;
+    return count;
+}
+}  // namespace
+
+TEST(ExoticaCore, ProfilerAggregatesAcrossThreads)
+{
+    Profiler& profiler = Profiler::Instance();
+    profiler.Reset();
+    profiler.SetEnabled(true);
+
+    Outer(3);
+    std::thread worker(Outer, 2);
+    worker.join();
+
+    const std::vector<ProfilerZoneStatistics> summary = profiler.GetSummary();
+    const ProfilerZoneStatistics* outer = FindZone(summary, "Outer");
+    const ProfilerZoneStatistics* inner = FindZone(summary, "Inner");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(outer->calls, 2u);
+    EXPECT_EQ(inner->calls, 5u);
+    EXPECT_GE(outer->total, inner->total);
+    EXPECT_LE(inner->min, inner->Mean());
+    EXPECT_LE(inner->Mean(), inner->max);
+    EXPECT_EQ(summary.front().name, "Outer");
+    EXPECT_NE(profiler.GetSummaryTable().find("Inner"), std::string::npos);
+
+    profiler.Reset();
+    EXPECT_TRUE(profiler.GetSummary().empty());
+}
+
+TEST(ExoticaCore, ProfilerKeepsEventsOfExitedThreads)
+{
+    Profiler& profiler = Profiler::Instance();
+    profiler.Reset();
+    Outer(1);
+
+    // Threads spawned per call (e.g., by parallel loops) hand their events and statistics over when they exit.
+    for (int round = 0; round < 10; ++round)
+    {
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 4; ++i) workers.emplace_back(Outer, 2);
+        for (auto& worker : workers) worker.join();
+    }
+
+    EXPECT_EQ(CountOccurrences(profiler.GetChromeTrace(), "\"thread_name\""), 41u);
+    EXPECT_EQ(CountOccurrences(profiler.GetChromeTrace(), "\"name\":\"Outer\""), 41u);
+    const std::vector<ProfilerZoneStatistics> summary = profiler.GetSummary();
+    EXPECT_EQ(FindZone(summary, "Outer")->calls, 41u);
+    EXPECT_EQ(FindZone(summary, "Inner")->calls, 81u);
+
+    // Exited threads share one buffer of the buffer size.
+    profiler.SetBufferSize(8);
+    for (int i = 0; i < 4; ++i) std::thread(Outer, 2).join();
+    EXPECT_EQ(CountOccurrences(profiler.GetChromeTrace(), "\"ph\":\"X\""), 8u);
+    EXPECT_EQ(FindZone(profiler.GetSummary(), "Outer")->calls, 45u);
+
+    profiler.SetBufferSize(1 << 16);
+    profiler.Reset();
+    EXPECT_TRUE(profiler.GetSummary().empty());
+    EXPECT_EQ(CountOccurrences(profiler.GetChromeTrace(), "\"thread_name\""), 1u);
+}
+
+TEST(ExoticaCore, ProfilerDisabledRecordsNothing)
+{
+    Profiler& profiler = Profiler::Instance();
+    profiler.Reset();
+    profiler.SetEnabled(false);
+    Outer(1);
+    profiler.SetEnabled(true);
+    EXPECT_TRUE(profiler.GetSummary().empty());
+}
+
+TEST(ExoticaCore, ProfilerChromeTrace)
+{
+    Profiler& profiler = Profiler::Instance();
+    profiler.Reset();
+    profiler.SetBufferSize(2);
+    Outer(3);
+    {
+        ProfilerZone zone(Profiler::Intern("Quoted \"zone\""));
+    }
+
+    // Only the two most recent events are kept in the trace, statistics cover all of them.
+    const std::string trace = profiler.GetChromeTrace();
+    EXPECT_EQ(trace.find("\"name\":\"Inner\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Outer\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Quoted \\\"zone\\\"\""), std::string::npos);
+    EXPECT_EQ(FindZone(profiler.GetSummary(), "Inner")->calls, 3u);
+    EXPECT_EQ(Profiler::Intern("Quoted \"zone\""), Profiler::Intern("Quoted \"zone\""));
+
+    profiler.SetBufferSize(1 << 16);
+    profiler.Reset();
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
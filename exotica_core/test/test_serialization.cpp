@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdint>
+#include <cstring>
+
+#include <exotica_core/tools/serialization.h>
+#include <gtest/gtest.h>
+
+using namespace exotica;
+
+TEST(ExoticaCore, SerializeInitializer)
+{
+    const Initializer child("Child", {{"Name", std::string("child")}, {"Offset", Eigen::Vector3d(0.1, 0.2, 0.3)}});
+    Initializer init("Parent", {{"Debug", true},
+                                {"T", 100},
+                                {"Tolerance", 1e-5},
+                                {"Weights", Eigen::VectorXd::LinSpaced(6, 0.0, 1.0).eval()},
+                                {"Indices", Eigen::VectorXi::LinSpaced(3, 0, 2).eval()},
+                                {"Links", std::vector<std::string>{"base", "tool"}},
+                                {"Child", child},
+                                {"Children", std::vector<Initializer>{child, child}}});
+    init.AddProperty(Property("Unset", false));
+
+    const std::string buffer = SerializeInitializer(init);
+    EXPECT_EQ(GetBinaryRecordType(buffer), BinaryRecordType::Initializer);
+    const Initializer copy = DeserializeInitializer(buffer);
+
+    EXPECT_EQ(copy.GetName(), "Parent");
+    EXPECT_EQ(copy.GetPropertyNames(), init.GetPropertyNames());
+    EXPECT_TRUE(boost::any_cast<bool>(copy.GetProperty("Debug")));
+    EXPECT_EQ(boost::any_cast<int>(copy.GetProperty("T")), 100);
+    EXPECT_EQ(boost::any_cast<double>(copy.GetProperty("Tolerance")), 1e-5);
+    EXPECT_TRUE(boost::any_cast<Eigen::VectorXd>(copy.GetProperty("Weights")) == boost::any_cast<Eigen::VectorXd>(init.GetProperty("Weights")));
+    EXPECT_TRUE(boost::any_cast<Eigen::VectorXi>(copy.GetProperty("Indices")) == boost::any_cast<Eigen::VectorXi>(init.GetProperty("Indices")));
+    EXPECT_EQ(boost::any_cast<std::vector<std::string>>(copy.GetProperty("Links")), boost::any_cast<std::vector<std::string>>(init.GetProperty("Links")));
+    EXPECT_TRUE(boost::any_cast<Eigen::Vector3d>(boost::any_cast<Initializer>(copy.GetProperty("Child")).GetProperty("Offset")) == Eigen::Vector3d(0.1, 0.2, 0.3));
+    EXPECT_EQ(boost::any_cast<std::vector<Initializer>>(copy.GetProperty("Children")).size(), 2u);
+    EXPECT_FALSE(copy.properties_.at("Unset").IsSet());
+    EXPECT_FALSE(copy.properties_.at("Unset").IsRequired());
+
+    // Round trip is lossless
+    EXPECT_EQ(SerializeInitializer(copy), buffer);
+
+    // Corrupted buffers are rejected
+    EXPECT_THROW(DeserializeInitializer(buffer.substr(0, buffer.size() - 1)), std::exception);
+    EXPECT_THROW(DeserializeInitializer(SerializeMatrix(Eigen::MatrixXd::Zero(2, 2))), std::exception);
+    EXPECT_THROW(SerializeInitializer(Initializer("Invalid", {{"Value", 1.0f}})), std::exception);
+
+    // List sizes larger than the remaining buffer are rejected before allocating the list. The size of an empty
+    // list as the only property is stored in the last 8 bytes of the buffer.
+    const uint64_t corrupt_size = uint64_t(1) << 60;
+    for (const Initializer& list : {Initializer("List", {{"Value", std::vector<std::string>()}}),
+                                    Initializer("List", {{"Value", std::vector<int>()}}),
+                                    Initializer("List", {{"Value", std::vector<bool>()}}),
+                                    Initializer("List", {{"Value", std::vector<Initializer>()}})})
+    {
+        std::string corrupt = SerializeInitializer(list);
+        EXPECT_NO_THROW(DeserializeInitializer(corrupt));
+        std::memcpy(&corrupt[corrupt.size() - sizeof(uint64_t)], &corrupt_size, sizeof(uint64_t));
+        EXPECT_THROW(DeserializeInitializer(corrupt), std::exception);
+    }
+}
+
+TEST(ExoticaCore, SerializeMatrixAndTrajectory)
+{
+    const Eigen::MatrixXd solution = Eigen::MatrixXd::Random(10, 7);
+    const std::string buffer = SerializeMatrix(solution);
+    EXPECT_TRUE(DeserializeMatrix(buffer) == solution);
+
+    // Aligned copy of the buffer, e.g. a memory-mapped file
+    std::vector<double> aligned(buffer.size() / sizeof(double) + 1);
+    std::memcpy(aligned.data(), buffer.data(), buffer.size());
+    EXPECT_TRUE(MapMatrix(reinterpret_cast<const char*>(aligned.data()), buffer.size()) == solution);
+
+    Eigen::MatrixXd data(3, 7);
+    data << 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+        1.0, 1.0, 0.5, -0.2, 0.3, -0.2, 1.0,
+        2.0, -0.5, 1.0, 0.4, -1.2, 0.7, 2.5;
+    const Trajectory trajectory = DeserializeTrajectory(SerializeTrajectory(Trajectory(data, 0.5)));
+    EXPECT_EQ(trajectory.GetRadius(), 0.5);
+    EXPECT_TRUE(trajectory.GetData() == data);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <exotica_core/trajectory.h>
+#include <gtest/gtest.h>
+
+using namespace exotica;
+
+// Exposes the underlying KDL trajectory as the reference for the precompiled lookup.
+class TestTrajectory : public Trajectory
+{
+public:
+    using Trajectory::Trajectory;
+    KDL::Frame GetReferencePosition(double t) { return trajectory_->Pos(t); }
+    // Marks the first sample so that a test can tell whether the samples were recomputed
+    void MarkFirstSample() { samples_.front() = KDL::Frame(KDL::Vector(100.0, 0.0, 0.0)); }
+    bool IsFirstSampleMarked() const { return !samples_.empty() && samples_.front().p.x() == 100.0; }
+};
+
+TEST(ExoticaCore, TrajectoryPosition)
+{
+    // Time, position, RPY; includes a stationary segment and a rotation of more than pi/2.
+    Eigen::MatrixXd data(5, 7);
+    data << 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+        0.5, 1.0, 0.5, -0.2, 0.3, -0.2, 1.0,
+        1.0, 1.0, 0.5, -0.2, 0.3, -0.2, 1.0,
+        2.0, -0.5, 1.0, 0.4, -1.2, 0.7, 2.5,
+        2.2, -0.4, 1.1, 0.3, -1.0, 0.6, -2.8;
+    TestTrajectory trajectory(data, 1.0);
+
+    for (double t = -0.5; t < trajectory.GetDuration() + 0.5; t += 0.0137)
+    {
+        EXPECT_TRUE(KDL::Equal(trajectory.GetPosition(t), trajectory.GetReferencePosition(t), 1e-6)) << "t = " << t;
+    }
+
+    trajectory.SetSampling(0.1, 0.05);
+    for (int k = 0; k < 30; ++k)
+    {
+        const double t = 0.05 + static_cast<double>(k) * 0.1;
+        EXPECT_TRUE(KDL::Equal(trajectory.GetPosition(t), trajectory.GetReferencePosition(t), 1e-6)) << "t = " << t;
+    }
+
+    // Advancing the offset by whole steps, as a receding horizon does, keeps the samples
+    trajectory.MarkFirstSample();
+    double offset = 0.05;
+    for (int shift = 0; shift < 5; ++shift)
+    {
+        offset += 0.1;
+        trajectory.SetSampling(0.1, offset);
+        EXPECT_TRUE(trajectory.IsFirstSampleMarked()) << "offset = " << offset;
+    }
+    for (int k = 0; k < 20; ++k)
+    {
+        const double t = offset + static_cast<double>(k) * 0.1;
+        EXPECT_TRUE(KDL::Equal(trajectory.GetPosition(t), trajectory.GetReferencePosition(t), 1e-6)) << "t = " << t;
+    }
+
+    // A different phase resamples the trajectory
+    trajectory.SetSampling(0.1, 0.37);
+    EXPECT_FALSE(trajectory.IsFirstSampleMarked());
+    for (int k = 0; k < 20; ++k)
+    {
+        const double t = 0.37 + static_cast<double>(k) * 0.1;
+        EXPECT_TRUE(KDL::Equal(trajectory.GetPosition(t), trajectory.GetReferencePosition(t), 1e-6)) << "t = " << t;
+    }
+
+    // A grid finer than the sample limit stores only its beginning, later grid times are interpolated.
+    const double dt = 1e-6;
+    trajectory.SetSampling(dt);
+    for (const double t : {0.0, 1000.0 * dt, static_cast<double>(Trajectory::MaxSamples - 1) * dt, static_cast<double>(Trajectory::MaxSamples) * dt, 1.5, 2.2})
+    {
+        EXPECT_TRUE(KDL::Equal(trajectory.GetPosition(t), trajectory.GetReferencePosition(t), 1e-6)) << "t = " << t;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,366 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <regex>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <exotica_core/exotica_core.h>
+#include <ros/ros.h>
+
+using namespace exotica;
+
+namespace
+{
+const std::string kRobots = "{exotica_examples}/resources/robots/";
+const std::string kConfigs = "{exotica_examples}/resources/configs/";
+
+struct BenchmarkOptions
+{
+    double min_time = 0.5;  ///< Minimum measurement time per benchmark [s]
+    int min_samples = 5;
+    double sample_time = 1e-3;  ///< Fast functions are called in batches lasting at least this long [s]
+    std::string filter = "";
+    std::string output;
+};
+
+/// Timings of one benchmark, all durations per call in nanoseconds.
+struct BenchmarkResult
+{
+    std::string name;
+    std::size_t calls = 0;
+    std::size_t samples = 0;
+    double median = 0.0;
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double stddev = 0.0;
+};
+
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options) : options_(options), filter_(options.filter) {}
+
+    bool IsSelected(const std::string& name) const { return std::regex_search(name, filter_); }
+
+    void Run(const std::string& name, const std::function<void()>& function)
+    {
+        if (!IsSelected(name)) return;
+
+        try
+        {
+            // The first call doubles as warm-up and calibration of the batch size.
+            Timer timer;
+            function();
+            const double first_call = std::max(timer.GetDuration(), 1e-9);
+            const std::size_t batch = std::max<std::size_t>(1, static_cast<std::size_t>(options_.sample_time / first_call));
+
+            std::vector<double> samples;
+            Timer total;
+            while (total.GetDuration() < options_.min_time || static_cast<int>(samples.size()) < options_.min_samples)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (std::size_t i = 0; i < batch; ++i) function();
+                const auto stop = std::chrono::steady_clock::now();
+                samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(batch));
+            }
+
+            BenchmarkResult result;
+            result.name = name;
+            result.calls = batch * samples.size();
+            result.samples = samples.size();
+            result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+            for (const double sample : samples) result.stddev += (sample - result.mean) * (sample - result.mean);
+            result.stddev = std::sqrt(result.stddev / static_cast<double>(samples.size()));
+            std::sort(samples.begin(), samples.end());
+            result.min = samples.front();
+            result.max = samples.back();
+            result.median = samples.size() % 2 ? samples[samples.size() / 2] : 0.5 * (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]);
+            results_.push_back(result);
+
+            std::cout << std::left << std::setw(60) << name << std::right << std::setw(16) << std::fixed << std::setprecision(1) << result.median << " ns"
+                      << std::setw(12) << result.calls << " calls" << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            WARNING_NAMED("exotica_benchmark", "Skipping " << name << ": " << e.what());
+        }
+    }
+
+    /// Sets up and runs a group of benchmarks. A group that fails to load is reported and skipped.
+    void Group(const std::string& prefix, const std::function<void()>& setup_and_run)
+    {
+        try
+        {
+            setup_and_run();
+        }
+        catch (const std::exception& e)
+        {
+            WARNING_NAMED("exotica_benchmark", "Skipping " << prefix << ": " << e.what());
+        }
+    }
+
+    std::string ToJson() const
+    {
+        char host[256] = "unknown";
+        gethostname(host, sizeof(host) - 1);
+        const std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        std::ostringstream json;
+        json << std::setprecision(17);
+        json << "{\n  \"context\": {\n"
+             << "    \"date\": \"" << date << "\",\n"
+             << "    \"host\": \"" << host << "\",\n"
+             << "    \"exotica_version\": \"" << exotica::version << "\",\n"
+             << "    \"exotica_branch\": \"" << exotica::branch << "\",\n"
+#ifdef NDEBUG
+             << "    \"build_type\": \"release\",\n"
+#else
+             << "    \"build_type\": \"debug\",\n"
+#endif
+             << "    \"min_time\": " << options_.min_time << ",\n"
+             << "    \"unit\": \"ns\"\n  },\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i)
+        {
+            const BenchmarkResult& r = results_[i];
+            json << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\", \"calls\": " << r.calls << ", \"samples\": " << r.samples
+                 << ", \"median\": " << r.median << ", \"mean\": " << r.mean << ", \"min\": " << r.min << ", \"max\": " << r.max
+                 << ", \"stddev\": " << r.stddev << "}";
+        }
+        json << "\n  ]\n}\n";
+        return json.str();
+    }
+
+private:
+    BenchmarkOptions options_;
+    std::regex filter_;
+    std::vector<BenchmarkResult> results_;
+};
+
+std::vector<Eigen::VectorXd> RandomStates(int n, int count = 64)
+{
+    std::srand(42);
+    std::vector<Eigen::VectorXd> states(count);
+    for (Eigen::VectorXd& x : states) x = 0.5 * Eigen::VectorXd::Random(n);
+    return states;
+}
+
+Initializer MakeSceneInitializer(const std::string& robot, const std::string& joint_group, const std::string& collision_scene = "", const std::string& load_scene = "")
+{
+    Initializer scene("Scene", {{"Name", robot},
+                                {"JointGroup", joint_group},
+                                {"URDF", kRobots + robot + ".urdf"},
+                                {"SRDF", kRobots + robot + ".srdf"}});
+    if (collision_scene.empty())
+    {
+        scene.AddProperty(Property("DoNotInstantiateCollisionScene", false, true));
+    }
+    else
+    {
+        scene.AddProperty(Property("CollisionScene", false, std::vector<Initializer>({Initializer(collision_scene, {{"Name", std::string("CollisionScene")}})})));
+        if (!load_scene.empty()) scene.AddProperty(Property("LoadScene", false, load_scene));
+    }
+    return scene;
+}
+
+/// Forward kinematics, Jacobians and Hessians of a set of frames, evaluated through Scene::Update.
+void BenchmarkKinematics(BenchmarkRunner& runner, const std::string& name, const std::string& robot, const std::string& joint_group, const std::vector<std::string>& links)
+{
+    ScenePtr scene = Setup::CreateScene(MakeSceneInitializer(robot, joint_group));
+    const std::vector<Eigen::VectorXd> states = RandomStates(scene->GetKinematicTree().GetNumControlledJoints());
+
+    KinematicsRequest request;
+    for (const std::string& link : links) request.frames.emplace_back(link);
+
+    const std::vector<std::pair<std::string, KinematicRequestFlags>> levels = {{"fk", KIN_FK}, {"jacobian", KIN_FK | KIN_J}, {"hessian", KIN_FK | KIN_J | KIN_H}};
+    for (const auto& level : levels)
+    {
+        request.flags = level.second;
+        scene->RequestKinematics(request, [](std::shared_ptr<KinematicResponse>) {});
+        std::size_t k = 0;
+        runner.Run("kinematics/" + name + "/" + level.first, [&]() { scene->Update(states[k++ % states.size()], 0.0); });
+    }
+}
+
+/// Collision queries at a fixed configuration. The collision scene updates its object transforms on every query.
+void BenchmarkCollision(BenchmarkRunner& runner, const std::string& name, const std::string& robot, const std::string& joint_group, const std::string& load_scene = "")
+{
+    ScenePtr scene = Setup::CreateScene(MakeSceneInitializer(robot, joint_group, "exotica/CollisionSceneFCLLatest", load_scene));
+    scene->Update(Eigen::VectorXd::Zero(scene->GetKinematicTree().GetNumControlledJoints()), 0.0);
+    const CollisionScenePtr& collision_scene = scene->GetCollisionScene();
+
+    runner.Run("collision/" + name + "/is_state_valid", [&]() { collision_scene->IsStateValid(true, 0.0); });
+    runner.Run("collision/" + name + "/get_collision_distance", [&]() { collision_scene->GetCollisionDistance(true); });
+}
+
+/// Each task map of benchmark_task_maps.xml on its own, at a fixed and already updated configuration.
+void BenchmarkTaskMaps(BenchmarkRunner& runner)
+{
+    MotionSolverPtr solver = XMLLoader::LoadSolver(kConfigs + "benchmark_task_maps.xml");
+    PlanningProblemPtr problem = solver->GetProblem();
+    const Eigen::VectorXd x = problem->ApplyStartState();
+    std::static_pointer_cast<UnconstrainedEndPoseProblem>(problem)->Update(x);
+
+    for (const auto& it : problem->GetTaskMaps())
+    {
+        const TaskMapPtr& map = it.second;
+        Eigen::VectorXd phi(map->length);
+        Eigen::MatrixXd jacobian(map->length_jacobian, problem->N);
+        runner.Run("task_map/" + it.first + "/phi", [&]() { map->Update(x, phi); });
+        runner.Run("task_map/" + it.first + "/jacobian", [&]() { map->Update(x, phi, jacobian); });
+    }
+}
+
+/// DynamicsSolver::ComputeDerivatives at the start state of a shooting problem.
+void BenchmarkDynamics(BenchmarkRunner& runner, const std::string& name, const std::string& config)
+{
+    MotionSolverPtr solver = XMLLoader::LoadSolver(kConfigs + config);
+    auto problem = std::static_pointer_cast<DynamicTimeIndexedShootingProblem>(solver->GetProblem());
+    const DynamicsSolverPtr dynamics = problem->GetScene()->GetDynamicsSolver();
+    const Eigen::VectorXd x = problem->get_X(0);
+    const Eigen::VectorXd u = problem->get_U(0);
+
+    runner.Run("dynamics/" + name + "/compute_derivatives", [&]() { dynamics->ComputeDerivatives(x, u); });
+}
+
+/// End-to-end solves. Problems that are warm-started by the previous solution are reset before every solve.
+void BenchmarkSolve(BenchmarkRunner& runner, const std::string& name, const std::string& config)
+{
+    MotionSolverPtr solver = XMLLoader::LoadSolver(kConfigs + config);
+    solver->debug_ = false;
+    PlanningProblemPtr problem = solver->GetProblem();
+    problem->debug_ = false;
+
+    std::function<void()> reset = []() {};
+    if (auto shooting = std::dynamic_pointer_cast<DynamicTimeIndexedShootingProblem>(problem))
+    {
+        const Eigen::MatrixXd U = shooting->get_U();
+        reset = [shooting, U]() { shooting->set_U(U); };
+    }
+
+    Eigen::MatrixXd solution;
+    runner.Run("solve/" + name, [&]() {
+        reset();
+        solver->Solve(solution);
+    });
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: exotica_benchmark [--filter REGEX] [--min-time SECONDS] [--output FILE]\n\n"
+              << "Runs the EXOTica microbenchmarks and optionally writes the results as JSON.\n"
+              << "Compare two result files with scripts/compare_benchmarks.\n"
+              << "A ROS master is required by the solver configurations.\n";
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "exotica_benchmark", ros::init_options::AnonymousName);
+
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+        if (arg == "--filter")
+            options.filter = argv[++i];
+        else if (arg == "--min-time")
+            options.min_time = std::stod(argv[++i]);
+        else if (arg == "--output")
+            options.output = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Server::InitRos(std::make_shared<ros::NodeHandle>("~"));
+    BenchmarkRunner runner(options);
+
+    // Kinematics
+    runner.Group("kinematics/lwr", [&]() { BenchmarkKinematics(runner, "lwr", "lwr_simplified", "arm", {"lwr_arm_6_link"}); });
+    runner.Group("kinematics/valkyrie", [&]() { BenchmarkKinematics(runner, "valkyrie", "valkyrie_sim", "whole_body", {"leftPalm", "rightPalm", "leftFoot", "rightFoot", "head"}); });
+
+    // Task maps
+    runner.Group("task_map/", [&]() { BenchmarkTaskMaps(runner); });
+
+    // Collision
+    runner.Group("collision/lwr", [&]() { BenchmarkCollision(runner, "lwr", "lwr_simplified", "arm", "{exotica_examples}/resources/scenes/example_distance.scene"); });
+    runner.Group("collision/valkyrie", [&]() { BenchmarkCollision(runner, "valkyrie", "valkyrie_sim", "whole_body"); });
+
+    // Dynamics
+    runner.Group("dynamics/cartpole", [&]() { BenchmarkDynamics(runner, "cartpole", "dynamic_time_indexed/04_analytic_ddp_cartpole.xml"); });
+    runner.Group("dynamics/quadrotor", [&]() { BenchmarkDynamics(runner, "quadrotor", "dynamic_time_indexed/13_control_limited_ddp_quadrotor.xml"); });
+    runner.Group("dynamics/lwr", [&]() { BenchmarkDynamics(runner, "lwr", "dynamic_time_indexed/05_analytic_ddp_lwr.xml"); });
+
+    // End-to-end solves
+    runner.Group("solve/ik_lwr", [&]() { BenchmarkSolve(runner, "ik_lwr", "example_ik.xml"); });
+    runner.Group("solve/ik_valkyrie", [&]() { BenchmarkSolve(runner, "ik_valkyrie", "example_ik_quasistatic_valkyrie.xml"); });
+    runner.Group("solve/aico_lwr", [&]() { BenchmarkSolve(runner, "aico_lwr", "example_aico.xml"); });
+    runner.Group("solve/ddp_cartpole", [&]() { BenchmarkSolve(runner, "ddp_cartpole", "dynamic_time_indexed/04_analytic_ddp_cartpole.xml"); });
+    runner.Group("solve/control_limited_ddp_quadrotor", [&]() { BenchmarkSolve(runner, "control_limited_ddp_quadrotor", "dynamic_time_indexed/13_control_limited_ddp_quadrotor.xml"); });
+    runner.Group("solve/fddp_cartpole", [&]() { BenchmarkSolve(runner, "fddp_cartpole", "dynamic_time_indexed/22_boxfddp_cartpole.xml"); });
+    runner.Group("solve/ompl_rrt_connect_lwr", [&]() { BenchmarkSolve(runner, "ompl_rrt_connect_lwr", "example_ompl.xml"); });
+
+    if (!options.output.empty())
+    {
+        std::ofstream file(ParsePath(options.output));
+        if (!file.is_open()) ThrowPretty("Can't open file '" << options.output << "' for writing!");
+        file << runner.ToJson();
+        HIGHLIGHT_NAMED("exotica_benchmark", "Results written to " << options.output);
+    }
+
+    // Clean up
+    // Run this only after all the exotica classes have been disposed of!
+    Setup::Destroy();
+}
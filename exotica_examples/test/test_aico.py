@@ -0,0 +1,48 @@
+import unittest
+
+import numpy as np
+from pyexotica.testing import create_solver_for_config
+import exotica_aico_solver_py
+
+CONFIG = '{exotica_examples}/resources/configs/example_aico.xml'
+
+
+def solve(solver_params):
+    solver, problem = create_solver_for_config(CONFIG, 'exotica/AICOSolver', solver_params)
+    solution = solver.solve()
+    return solution, problem, solver
+
+
+class TestAICO(unittest.TestCase):
+    def test_information_form(self):
+        # The information form is an algebraic rearrangement of the covariance form, the results must agree.
+        reference, reference_problem, _ = solve({'UseInformationForm': False})
+        solution, problem, _ = solve({'UseInformationForm': True})
+        np.testing.assert_allclose(solution, reference, rtol=1e-6, atol=1e-6)
+        np.testing.assert_allclose(problem.get_cost_evolution()[1], reference_problem.get_cost_evolution()[1], rtol=1e-6)
+        self.assertEqual(problem.termination_criterion, reference_problem.termination_criterion)
+
+    def test_checkpoints(self):
+        # Rejected sweeps roll back to the checkpoint. The returned trajectory and its cost must stay consistent.
+        for sweep_mode in ['Forwardly', 'Symmetric', 'LocalGaussNewton']:
+            solution, problem, solver = solve({'SweepMode': sweep_mode, 'Damping': 0.01})
+            cost_evolution = np.array(problem.get_cost_evolution()[1])
+            final_cost = cost_evolution[np.isfinite(cost_evolution)][-1]
+            cost = 0.0
+            for t in range(problem.T):
+                problem.update(solution[t, :], t)
+            for t in range(1, problem.T):
+                cost += problem.get_scalar_task_cost(t) + problem.get_scalar_transition_cost(t)
+            np.testing.assert_allclose(cost, final_cost, rtol=1e-9)
+
+            # A second solve starts from fresh buffers and must reproduce the first one.
+            np.testing.assert_allclose(solver.solve(), solution)
+
+    def test_memory_usage(self):
+        _, problem, solver = solve({})
+        # Two state buffers hold at least the N x NT message and belief precisions.
+        self.assertGreaterEqual(solver.get_memory_usage(), 2 * 8 * 4 * problem.N * problem.N * problem.T)
+
+
+if __name__ == '__main__':
+    unittest.main()
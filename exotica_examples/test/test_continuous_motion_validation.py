@@ -0,0 +1,31 @@
+import unittest
+
+import numpy as np
+import pyexotica as exo
+import exotica_ompl_solver_py as ompl
+
+CONFIG = '{exotica_examples}/resources/configs/example_manipulate_ompl.xml'
+START = [1.5035205538438838, 0.8730168650583787, -1.6298590879018438, 1.7106630821349438, -0.8789956712153559, 0.1278222471656531, 0.0]
+GOAL = [-1.5035205538442702, 0.8730168650583671, 1.6298590879018415, 1.7106630821349786, 0.8789956712153525, 0.12782224716566898, 0.0]
+
+
+class TestContinuousMotionValidation(unittest.TestCase):
+    def test_solution_is_collision_free(self):
+        _, problem_init = exo.Initializers.load_xml_full(CONFIG)
+        problem = exo.Setup.create_problem(problem_init)
+        solver = exo.Setup.create_solver(('exotica/RRTConnectSolver', {'Name': 'Solver', 'ContinuousMotionValidation': True,
+                                                                         'ContinuousMotionValidationSelfCollision': False, 'RandomSeed': 42}))
+        solver.specify_problem(problem)
+        problem.start_state = START
+        problem.goal_state = GOAL
+        solution = solver.solve()
+        self.assertTrue(solution.shape[0] > 1)
+
+        # The solution must stay collision free between its waypoints, not only at the validated states.
+        for k in range(solution.shape[0] - 1):
+            for s in np.linspace(0.0, 1.0, 20):
+                self.assertTrue(problem.is_state_valid((1.0 - s) * solution[k, :] + s * solution[k + 1, :]))
+
+
+if __name__ == '__main__':
+    unittest.main()
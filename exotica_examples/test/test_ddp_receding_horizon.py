@@ -0,0 +1,43 @@
+import unittest
+
+import numpy as np
+import pyexotica as exo
+from pyexotica.testing import create_solver_for_config
+
+CONFIG = '{exotica_examples}/resources/configs/dynamic_time_indexed/22_boxfddp_cartpole.xml'
+
+
+def create_solver(max_planning_time=0.0):
+    return create_solver_for_config(CONFIG, 'exotica/ControlLimitedFeasibilityDrivenDDPSolver',
+                                    {'MaxIterations': 20, 'MaxPlanningTime': max_planning_time})
+
+
+class TestDDPRecedingHorizon(unittest.TestCase):
+    def test_shift_horizon(self):
+        solver, problem = create_solver()
+        solver.solve()
+        X, U = problem.X.copy(), problem.U.copy()
+        x_measured = X[:, 1] + 1e-3
+
+        solver.shift_horizon(x_measured)
+        np.testing.assert_allclose(problem.X[:, 0], x_measured)
+        np.testing.assert_allclose(problem.X[:, 1:-1], X[:, 2:])
+        np.testing.assert_allclose(problem.X[:, -1], X[:, -1])
+        np.testing.assert_allclose(problem.U[:, :-1], U[:, 1:])
+        np.testing.assert_allclose(problem.U[:, -1], U[:, -1])
+        np.testing.assert_allclose(problem.start_state, x_measured)
+
+        # The warm-started re-solve needs fewer iterations than the cold start.
+        iterations_cold = len(problem.get_cost_evolution()[1])
+        solver.solve()
+        self.assertLessEqual(len(problem.get_cost_evolution()[1]), iterations_cold)
+        self.assertNotEqual(problem.termination_criterion, exo.TerminationCriterion.Divergence)
+
+    def test_time_budget(self):
+        solver, problem = create_solver(max_planning_time=1e-9)
+        solver.solve()
+        self.assertEqual(problem.termination_criterion, exo.TerminationCriterion.TimeLimit)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2021, University of Oxford
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of  nor the names of its contributors may be used to
+//    endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <exotica_core/dynamics_solver_initializer.h>
+#include <exotica_core/exotica_core.h>
+#include <exotica_core/tools/test_helpers.h>
+#include <gtest/gtest.h>
+
+using namespace exotica;
+
+/// \brief Reference implementation of Simulate as it was before SimulateInPlace: repeated one-step integration.
+Eigen::VectorXd SimulateByOneStepLoop(DynamicsSolverPtr solver, const Eigen::VectorXd& x, const Eigen::VectorXd& u, int num_timesteps)
+{
+    Eigen::VectorXd x_t = x;
+    Eigen::VectorXd x_t_plus_1(solver->get_num_state());
+    for (int i = 0; i < num_timesteps; ++i)
+    {
+        solver->Integrate(x_t, solver->f(x_t, u), solver->get_dt(), x_t_plus_1);
+        x_t = x_t_plus_1;
+    }
+    return x_t;
+}
+
+void CheckSimulateMatchesOneStepLoop(DynamicsSolverPtr solver, const Eigen::VectorXd& x, const Eigen::VectorXd& u)
+{
+    constexpr int num_timesteps = 17;
+    for (const std::string integrator : {"RK1", "SymplecticEuler"})
+    {
+        TEST_COUT << "Testing " << solver->GetObjectName() << " with integrator " << integrator;
+        solver->SetIntegrator(integrator);
+        const Eigen::VectorXd expected = SimulateByOneStepLoop(solver, x, u, num_timesteps);
+
+        // Pad the duration slightly to avoid truncating the last step.
+        const double t = (num_timesteps + 0.5) * solver->get_dt();
+        EXPECT_TRUE(solver->Simulate(x, u, t).isApprox(expected, 1e-12));
+
+        Eigen::VectorXd x_in_place = x;
+        solver->SimulateInPlace(x_in_place, u, t);
+        EXPECT_TRUE(x_in_place.isApprox(expected, 1e-12));
+
+        // A single step through F is the first iteration of the loop.
+        EXPECT_TRUE(solver->F(x, u).isApprox(SimulateByOneStepLoop(solver, x, u, 1), 1e-12));
+
+        // Durations shorter than dt do not step.
+        EXPECT_TRUE(solver->Simulate(x, u, 0.5 * solver->get_dt()).isApprox(x));
+    }
+}
+
+TEST(ExoticaDynamicsSolvers, SimulateMatchesOneStepLoop)
+{
+    DynamicsSolverPtr solver = Setup::CreateDynamicsSolver(Initializer("exotica/CartpoleDynamicsSolver", {{"Name", std::string("MyCartpole")}}));
+    Eigen::VectorXd x(solver->get_num_state());
+    x << 0.1, 0.5, -0.2, 0.3;
+    Eigen::VectorXd u = Eigen::VectorXd::Constant(solver->get_num_controls(), 0.7);
+    CheckSimulateMatchesOneStepLoop(solver, x, u);
+}
+
+TEST(ExoticaDynamicsSolvers, SimulateMatchesOneStepLoopOnManifold)
+{
+    ScenePtr scene = Setup::CreateScene(Initializer("exotica/Scene", {{"Name", std::string("PendulumScene")},
+                                                                      {"JointGroup", std::string("actuated_joints")},
+                                                                      {"URDF", std::string("{exotica_examples}/resources/robots/pendulum.urdf")},
+                                                                      {"SRDF", std::string("{exotica_examples}/resources/robots/pendulum.srdf")},
+                                                                      {"DynamicsSolver", std::vector<Initializer>({Initializer("exotica/PinocchioDynamicsSolver", {{"Name", std::string("MyPinocchio")}})})}}));
+    DynamicsSolverPtr solver = scene->GetDynamicsSolver();
+
+    // The continuous joint is represented as (cos, sin) in Pinocchio, i.e. positions and velocities differ in size.
+    ASSERT_EQ(solver->get_num_positions(), 2);
+    ASSERT_EQ(solver->get_num_velocities(), 1);
+
+    const double angle = 0.4;
+    Eigen::VectorXd x(solver->get_num_state());
+    x << std::cos(angle), std::sin(angle), 0.2;
+    Eigen::VectorXd u = Eigen::VectorXd::Constant(solver->get_num_controls(), 0.3);
+    CheckSimulateMatchesOneStepLoop(solver, x, u);
+
+    // Integrating on the manifold keeps the configuration on the unit circle.
+    const Eigen::VectorXd x_final = solver->Simulate(x, u, 1.0);
+    EXPECT_NEAR(x_final.head<2>().norm(), 1.0, 1e-9);
+}
+
+/// \brief Double integrator that replaces the state transition with an explicit (non-symplectic) step and counts the steps.
+class CustomStepDynamicsSolver : public DynamicsSolver, public Instantiable<DynamicsSolverInitializer>
+{
+public:
+    CustomStepDynamicsSolver()
+    {
+        num_positions_ = 1;
+        num_velocities_ = 1;
+        num_controls_ = 1;
+    }
+
+    StateVector f(const StateVector& x, const ControlVector& u) override
+    {
+        return (StateVector(2) << x(1), u(0)).finished();
+    }
+
+    int num_steps = 0;
+
+protected:
+    void SimulateOneStepInPlace(const StateVector& x, const ControlVector& u, StateVector& xout) override
+    {
+        ++num_steps;
+        xout = x + dt_ * f(x, u);
+        xout(1) += 1.0;
+    }
+};
+
+TEST(ExoticaDynamicsSolvers, SimulateUsesOverriddenStep)
+{
+    auto solver = std::make_shared<CustomStepDynamicsSolver>();
+    const Eigen::Vector2d x(0.0, 0.0);
+    const Eigen::VectorXd u = Eigen::VectorXd::Zero(1);
+
+    // The overridden step adds 1 to the velocity on every step.
+    EXPECT_DOUBLE_EQ(solver->F(x, u)(1), 1.0);
+    EXPECT_EQ(solver->num_steps, 1);
+
+    EXPECT_DOUBLE_EQ(solver->Simulate(x, u, 5.5 * solver->get_dt())(1), 5.0);
+    EXPECT_EQ(solver->num_steps, 6);
+
+    Eigen::VectorXd x_in_place = x;
+    solver->SimulateInPlace(x_in_place, u, 3.5 * solver->get_dt());
+    EXPECT_DOUBLE_EQ(x_in_place(1), 3.0);
+    EXPECT_EQ(solver->num_steps, 9);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    Setup::Destroy();
+    return ret;
+}
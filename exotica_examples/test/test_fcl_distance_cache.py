@@ -0,0 +1,67 @@
+import unittest
+
+import numpy as np
+import pyexotica as exo
+
+CHECK_MARGIN = 0.1
+
+
+def create_scene(collision_scene_params):
+    params = {'Name': 'MyCollisionScene'}
+    params.update(collision_scene_params)
+    return exo.Setup.create_scene(('exotica/Scene',
+                                   {'Name': 'MyScene',
+                                    'JointGroup': 'arm',
+                                    'URDF': '{exotica_examples}/resources/robots/lwr_simplified.urdf',
+                                    'SRDF': '{exotica_examples}/resources/robots/lwr_simplified.srdf',
+                                    'LoadScene': '{exotica_examples}/resources/scenes/example_distance.scene',
+                                    'AlwaysUpdateCollisionScene': '1',
+                                    'CollisionScene': [('exotica/CollisionSceneFCLLatest', params)]}))
+
+
+def sorted_proxies(proxies):
+    return sorted(proxies, key=lambda p: (p.object_1, p.object_2))
+
+
+class TestFCLDistanceCache(unittest.TestCase):
+    def assert_same_proxies(self, expected, actual):
+        expected = sorted_proxies(expected)
+        actual = sorted_proxies(actual)
+        self.assertEqual([(p.object_1, p.object_2) for p in expected], [(p.object_1, p.object_2) for p in actual])
+        for p, q in zip(expected, actual):
+            np.testing.assert_allclose(q.distance, p.distance, atol=1e-9)
+            np.testing.assert_allclose(q.contact_1, p.contact_1, atol=1e-9)
+            np.testing.assert_allclose(q.contact_2, p.contact_2, atol=1e-9)
+            np.testing.assert_allclose(q.normal_1, p.normal_1, atol=1e-9)
+
+    def check_trajectory(self, times, collision_scene_params={}):
+        uncached = create_scene({})
+        cached_params = {'UseDistanceCache': True}
+        cached_params.update(collision_scene_params)
+        cached = create_scene(cached_params)
+
+        # Small steps revisiting the same times, as iterative solvers do, exercise the cached lower bounds.
+        np.random.seed(42)
+        n = len(uncached.get_controlled_joint_names())
+        x = np.zeros((len(times), n))
+        for sweep in range(5):
+            x += np.random.uniform(-0.05, 0.05, x.shape)
+            for k, t in enumerate(times):
+                for scene in (uncached, cached):
+                    scene.update(x[k, :], t)
+                self.assertEqual(cached.is_state_valid(True), uncached.is_state_valid(True))
+                self.assertEqual(cached.is_state_valid(False), uncached.is_state_valid(False))
+                self.assert_same_proxies(uncached.get_collision_distance(True), cached.get_collision_distance(True))
+                self.assert_same_proxies(uncached.get_collision_scene().get_robot_to_world_collision_distance(CHECK_MARGIN),
+                                         cached.get_collision_scene().get_robot_to_world_collision_distance(CHECK_MARGIN))
+
+    def test_time_indexed(self):
+        self.check_trajectory(np.linspace(0.0, 1.0, 20))
+
+    def test_time_slices_evicted(self):
+        # Fewer slices than times: entries are evicted and recomputed, results must not change.
+        self.check_trajectory(np.linspace(0.0, 1.0, 20), {'DistanceCacheTimeSlices': 3})
+
+
+if __name__ == '__main__':
+    unittest.main()
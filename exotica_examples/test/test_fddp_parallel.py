@@ -0,0 +1,30 @@
+import unittest
+
+import numpy as np
+from pyexotica.testing import create_solver_for_config
+
+CONFIG = '{exotica_examples}/resources/configs/dynamic_time_indexed/22_boxfddp_cartpole.xml'
+
+
+def solve(solver_type, num_threads):
+    solver, problem = create_solver_for_config(CONFIG, solver_type, {'MaxIterations': 20, 'NumThreads': num_threads})
+    return solver.solve(), problem.get_cost_evolution()[1]
+
+
+class TestFDDPParallelRollout(unittest.TestCase):
+    def check_solver(self, solver_type):
+        # Parallel evaluation of the shooting intervals must not change the result.
+        us_serial, cost_serial = solve(solver_type, 1)
+        us_parallel, cost_parallel = solve(solver_type, 4)
+        np.testing.assert_allclose(us_parallel, us_serial)
+        np.testing.assert_allclose(cost_parallel, cost_serial)
+
+    def test_fddp(self):
+        self.check_solver('exotica/FeasibilityDrivenDDPSolver')
+
+    def test_box_fddp(self):
+        self.check_solver('exotica/ControlLimitedFeasibilityDrivenDDPSolver')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,120 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy as np
+import pyexotica as exo
+import exotica_ompl_solver_py as ompl
+from pyexotica.testing import check_path_valid, create_solver_for_config
+
+CONFIG = '{exotica_examples}/resources/configs/example_lazy_prm.xml'
+TIP_LINK = 'lwr_arm_7_link'
+
+
+def create_unsmoothed_prm(solver_type):
+    # Without smoothing the solution follows the edges of the roadmap.
+    solver, _ = create_solver_for_config(CONFIG, 'exotica/' + solver_type, {'MultiQuery': True, 'Smooth': False,
+                                                                            'RandomSeed': 42, 'Timeout': 10})
+    return solver
+
+
+def block_path(problem, solution):
+    # Places an obstacle at the tip of the arm along the middle of the solution, keeping the start and goal valid.
+    scene = problem.get_scene()
+    middle = solution.shape[0] // 2
+    for k in sorted(range(1, solution.shape[0] - 1), key=lambda k: abs(k - middle)):
+        problem.update(solution[k, :])
+        position = scene.fk(TIP_LINK).get_translation()
+        scene.add_object_to_environment('BlockingObstacle', shape=exo.Sphere(0.05), transform=exo.KDLFrame(position))
+        if problem.is_state_valid(problem.start_state) and problem.is_state_valid(problem.goal_state):
+            return solution[k, :]
+        scene.remove_object('BlockingObstacle')
+    return None
+
+
+class TestPRMRoadmap(unittest.TestCase):
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+        self.file_name = os.path.join(self.directory, 'roadmap.graph')
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def test_world_hash(self):
+        scene = exo.Setup.load_solver(CONFIG).get_problem().get_scene()
+        other_scene = exo.Setup.load_solver(CONFIG).get_problem().get_scene()
+        self.assertEqual(scene.get_world_hash(), other_scene.get_world_hash())
+
+        scene.add_object_to_environment('FarAwayObstacle', shape=exo.Sphere(0.1), transform=exo.KDLFrame([5, 5, 5]))
+        self.assertNotEqual(scene.get_world_hash(), other_scene.get_world_hash())
+
+    def test_world_hash_mesh_without_resource(self):
+        scene = exo.Setup.load_solver(CONFIG).get_problem().get_scene()
+        other_scene = exo.Setup.load_solver(CONFIG).get_problem().get_scene()
+
+        # Same number of vertices and triangles, only the vertex data differs.
+        mesh = exo.Mesh.createMeshFromVertices([np.array([0., 0., 0.]), np.array([1., 0., 0.]), np.array([0., 1., 0.])], [0, 1, 2])
+        other_mesh = exo.Mesh.createMeshFromVertices([np.array([0., 0., 0.]), np.array([1., 0., 0.]), np.array([0., 0., 1.])], [0, 1, 2])
+        scene.add_object_to_environment('MeshObstacle', shape=mesh, transform=exo.KDLFrame([5, 5, 5]))
+        other_scene.add_object_to_environment('MeshObstacle', shape=other_mesh, transform=exo.KDLFrame([5, 5, 5]))
+        self.assertNotEqual(scene.get_world_hash(), other_scene.get_world_hash())
+
+    def test_save_and_load_roadmap(self):
+        prm = exo.Setup.load_solver(CONFIG)
+        self.assertTrue(prm.solve().shape[0] > 0)
+        milestones = prm.milestone_count()
+        self.assertTrue(milestones > 0)
+        prm.save_roadmap(self.file_name)
+
+        loaded = exo.Setup.load_solver(CONFIG)
+        loaded.load_roadmap(self.file_name)
+        self.assertTrue(loaded.multi_query)
+        self.assertEqual(loaded.milestone_count(), milestones)
+        self.assertTrue(loaded.solve().shape[0] > 0)
+
+    def test_roadmap_kept_across_world_changes(self):
+        prm = exo.Setup.load_solver(CONFIG)
+        prm.solve()
+        milestones = prm.milestone_count()
+
+        # LazyPRM keeps the graph and revalidates it when the world changes
+        prm.get_problem().get_scene().add_object_to_environment('FarAwayObstacle', shape=exo.Sphere(0.1), transform=exo.KDLFrame([5, 5, 5]))
+        self.assertTrue(prm.solve().shape[0] > 0)
+        self.assertTrue(prm.milestone_count() >= milestones)
+
+    def check_path_avoids_blocked_edge(self, solver_type):
+        prm = create_unsmoothed_prm(solver_type)
+        problem = prm.get_problem()
+        solution = prm.solve()
+        self.assertTrue(solution.shape[0] > 2)
+
+        blocked_state = block_path(problem, solution)
+        self.assertIsNotNone(blocked_state)
+        self.assertFalse(problem.is_state_valid(blocked_state))
+
+        # The previous path runs through the obstacle, the next query must not reuse its edges.
+        check_path_valid(prm.solve(), problem.is_state_valid)
+
+    def test_lazy_prm_revalidates_blocked_edge(self):
+        self.check_path_avoids_blocked_edge('LazyPRMSolver')
+
+    def test_prm_discards_roadmap_with_blocked_edge(self):
+        # PRM validates edges only when adding them, so it has to discard the roadmap when the world changes.
+        self.check_path_avoids_blocked_edge('PRMSolver')
+
+    def test_prm_discards_loaded_roadmap_of_other_world(self):
+        prm = create_unsmoothed_prm('PRMSolver')
+        solution = prm.solve()
+        prm.save_roadmap(self.file_name)
+
+        loaded = create_unsmoothed_prm('PRMSolver')
+        self.assertIsNotNone(block_path(loaded.get_problem(), solution))
+        loaded.load_roadmap(self.file_name)
+        self.assertEqual(loaded.milestone_count(), prm.milestone_count())
+
+        check_path_valid(loaded.solve(), loaded.get_problem().is_state_valid)
+
+
+if __name__ == '__main__':
+    unittest.main()
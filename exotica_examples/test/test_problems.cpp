@@ -277,6 +277,116 @@ TEST(ExoticaProblems, UnconstrainedEndPoseProblem)
     }
 }
 
+TEST(ExoticaProblems, UpdateCache)
+{
+    try
+    {
+        CREATE_PROBLEM(UnconstrainedEndPoseProblem, 1);
+        Eigen::VectorXd x = problem->GetStartState();
+        problem->ResetNumberOfProblemUpdates();
+
+        problem->Update(x);
+        const Eigen::VectorXd ydiff = problem->cost.ydiff;
+        const Eigen::MatrixXd jacobian = problem->cost.jacobian;
+        problem->Update(x);
+        EXPECT_EQ(problem->GetNumberOfProblemUpdates(), 1u);
+        EXPECT_EQ(problem->GetNumberOfProblemUpdateCacheHits(), 1u);
+        EXPECT_TRUE(problem->cost.ydiff == ydiff);
+        EXPECT_TRUE(problem->cost.jacobian == jacobian);
+
+        // Goals are applied on cache hits
+        const std::string task_name = problem->cost.tasks[0]->GetObjectName();
+        problem->SetGoal(task_name, problem->GetGoal(task_name) + Eigen::VectorXd::Ones(problem->cost.indexing[0].length));
+        problem->Update(x);
+        EXPECT_EQ(problem->GetNumberOfProblemUpdates(), 1u);
+        EXPECT_TRUE(problem->cost.ydiff != ydiff);
+
+        // Changing the scene invalidates the cache
+        problem->GetScene()->SetModelState(x.setRandom());
+        problem->Update(problem->GetStartState());
+        EXPECT_EQ(problem->GetNumberOfProblemUpdates(), 2u);
+
+        problem->SetUseUpdateCache(false);
+        problem->Update(problem->GetStartState());
+        EXPECT_EQ(problem->GetNumberOfProblemUpdates(), 3u);
+        EXPECT_EQ(problem->GetNumberOfProblemUpdateCacheHits(), 2u);
+        EXPECT_DOUBLE_EQ(problem->GetProblemUpdateCacheHitRate(), 0.4);
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Uncaught exception! " << e.what();
+    }
+}
+
+ScenePtr CreateSceneWithBox(const std::string& name)
+{
+    // The custom link is attached to the box loaded from the scene file
+    const std::vector<Initializer> links({Initializer("Link", {{"Name", std::string("BoxChild")}, {"Parent", std::string("box")}, {"Transform", std::string("0 0 0.1")}})});
+    return Setup::CreateScene(Initializer("exotica/Scene", {{"Name", name},
+                                                           {"JointGroup", std::string("arm")},
+                                                           {"URDF", std::string("{exotica_examples}/resources/robots/lwr_simplified.urdf")},
+                                                           {"SRDF", std::string("{exotica_examples}/resources/robots/lwr_simplified.srdf")},
+                                                           {"LoadScene", std::string("{exotica_examples}/resources/scenes/example_box.scene")},
+                                                           {"DoNotInstantiateCollisionScene", true},
+                                                           {"Links", links}}));
+}
+
+TEST(ExoticaProblems, SharedSceneTemplate)
+{
+    try
+    {
+        std::shared_ptr<UnconstrainedEndPoseProblem> first = CreateProblem<UnconstrainedEndPoseProblem>("UnconstrainedEndPoseProblem", 0);
+        std::shared_ptr<UnconstrainedEndPoseProblem> second = CreateProblem<UnconstrainedEndPoseProblem>("UnconstrainedEndPoseProblem", 0);
+        EXPECT_GT(first->GetConstructionTime(), 0.0);
+        EXPECT_GT(second->GetConstructionTime(), 0.0);
+
+        // Scenes created from the same robot share the model but keep independent states
+        EXPECT_EQ(first->GetScene()->GetKinematicTree().GetRobotModel(), second->GetScene()->GetKinematicTree().GetRobotModel());
+
+        Eigen::VectorXd x = first->GetStartState();
+        x.setRandom();
+        first->GetScene()->SetModelState(x);
+        EXPECT_TRUE(second->GetScene()->GetModelState() != first->GetScene()->GetModelState());
+
+        // Scenes loading the same scene file share its geometry
+        ScenePtr first_scene = CreateSceneWithBox("FirstScene");
+        ScenePtr second_scene = CreateSceneWithBox("SecondScene");
+        const std::shared_ptr<KinematicElement> first_box = first_scene->GetKinematicTree().GetTreeMap().at("box_collision_0").lock();
+        const std::shared_ptr<KinematicElement> second_box = second_scene->GetKinematicTree().GetTreeMap().at("box_collision_0").lock();
+        ASSERT_TRUE(first_box && first_box->shape);
+        ASSERT_TRUE(second_box && second_box->shape);
+        EXPECT_EQ(first_box->shape, second_box->shape);
+
+        // Custom links can be attached to objects of the shared scene
+        for (ScenePtr scene : {first_scene, second_scene})
+        {
+            ASSERT_TRUE(scene->GetKinematicTree().DoesLinkWithNameExist("BoxChild"));
+            EXPECT_EQ(scene->GetKinematicTree().GetTreeMap().at("BoxChild").lock()->parent_name, "box");
+        }
+
+        // Objects added to one scene do not appear in the other one
+        first_scene->AddObject("Extra", KDL::Frame(), "", shapes::ShapeConstPtr(new shapes::Sphere(0.1)), KDL::RigidBodyInertia::Zero(), Eigen::Vector4d(0.5, 0.5, 0.5, 1.0), false);
+        EXPECT_TRUE(first_scene->GetKinematicTree().DoesLinkWithNameExist("Extra"));
+        EXPECT_FALSE(second_scene->GetKinematicTree().DoesLinkWithNameExist("Extra"));
+        for (const moveit_msgs::CollisionObject& object : second_scene->GetPlanningSceneMsg().world.collision_objects) EXPECT_NE(object.id, "Extra");
+        ScenePtr third_scene = CreateSceneWithBox("ThirdScene");
+        EXPECT_FALSE(third_scene->GetKinematicTree().DoesLinkWithNameExist("Extra"));
+
+        // Meshes are loaded once until the cache is cleared
+        const std::string mesh = "package://exotica_examples/resources/cone.stl";
+        shapes::ShapeConstPtr first_mesh = Server::Instance()->GetMesh(mesh);
+        ASSERT_TRUE(first_mesh != nullptr);
+        EXPECT_EQ(Server::Instance()->GetMesh(mesh), first_mesh);
+        EXPECT_NE(Server::Instance()->GetMesh(mesh, Eigen::Vector3d::Constant(2.0)), first_mesh);
+        Server::Instance()->ClearCache();
+        EXPECT_NE(Server::Instance()->GetMesh(mesh), first_mesh);
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Uncaught exception! " << e.what();
+    }
+}
+
 TEST(ExoticaProblems, BoundedEndPoseProblem)
 {
     try
@@ -557,6 +667,51 @@ TEST(ExoticaProblems, TimeIndexedProblem)
     }
 }
 
+TEST(ExoticaProblems, TimeIndexedProblemSparseJacobians)
+{
+    try
+    {
+        CREATE_PROBLEM(TimeIndexedProblem, 1);
+        const int T = problem->GetT();
+        const int N = problem->N;
+        const Eigen::Matrix<int, Eigen::Dynamic, 2> equality_structure = problem->GetEqualityJacobianStructure();
+        const Eigen::Matrix<int, Eigen::Dynamic, 2> inequality_structure = problem->GetInequalityJacobianStructure();
+        for (int trial = 0; trial < 3; ++trial)
+        {
+            for (int t = 0; t < T; ++t) problem->Update(problem->GetStartState() + Eigen::VectorXd::Random(N), t);
+
+            // All tasks are active with rho = 1, i.e. the Jacobians are block diagonal over timesteps.
+            Eigen::MatrixXd equality_jacobian = Eigen::MatrixXd::Zero(problem->get_active_nonlinear_equality_constraints_dimension(), N * (T - 1));
+            Eigen::MatrixXd inequality_jacobian = Eigen::MatrixXd::Zero(problem->get_active_nonlinear_inequality_constraints_dimension(), N * (T - 1));
+            Eigen::RowVectorXd cost_jacobian = Eigen::RowVectorXd::Zero(N * (T - 1));
+            for (int t = 1; t < T; ++t)
+            {
+                const Eigen::MatrixXd equality_jacobian_t = problem->GetEqualityJacobian(t);
+                const Eigen::MatrixXd inequality_jacobian_t = problem->GetInequalityJacobian(t);
+                equality_jacobian.block((t - 1) * equality_jacobian_t.rows(), (t - 1) * N, equality_jacobian_t.rows(), N) = equality_jacobian_t;
+                inequality_jacobian.block((t - 1) * inequality_jacobian_t.rows(), (t - 1) * N, inequality_jacobian_t.rows(), N) = inequality_jacobian_t;
+                cost_jacobian.segment((t - 1) * N, N) += problem->GetScalarTaskJacobian(t) + problem->GetScalarTransitionJacobian(t);
+                if (t > 1) cost_jacobian.segment((t - 2) * N, N) -= problem->GetScalarTransitionJacobian(t);
+            }
+
+            if (!Eigen::MatrixXd(problem->GetEqualityJacobian()).isApprox(equality_jacobian))
+                ADD_FAILURE() << "Sparse equality Jacobian is inconsistent with the per-timestep Jacobians!";
+            if (!Eigen::MatrixXd(problem->GetInequalityJacobian()).isApprox(inequality_jacobian))
+                ADD_FAILURE() << "Sparse inequality Jacobian is inconsistent with the per-timestep Jacobians!";
+            if (!problem->GetCostJacobian().isApprox(cost_jacobian))
+                ADD_FAILURE() << "Cost Jacobian is inconsistent with the per-timestep Jacobians!";
+            if (problem->GetEqualityJacobianStructure() != equality_structure || problem->GetInequalityJacobianStructure() != inequality_structure)
+                ADD_FAILURE() << "Sparsity structure changed between updates!";
+            if (equality_structure.rows() != problem->GetEqualityJacobian().nonZeros())
+                ADD_FAILURE() << "Sparsity structure does not match the number of non-zeros!";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Uncaught exception! " << e.what();
+    }
+}
+
 TEST(ExoticaProblems, SamplingProblem)
 {
     try
@@ -0,0 +1,59 @@
+import threading
+import unittest
+
+import numpy as np
+import pyexotica as exo
+
+CONFIG = '{exotica_examples}/resources/configs/example_ik.xml'
+
+
+class TestPythonBatchEvaluation(unittest.TestCase):
+    def setUp(self):
+        self.solver = exo.Setup.load_solver(CONFIG)
+        self.problem = self.solver.get_problem()
+        self.scene = self.problem.get_scene()
+        np.random.seed(42)
+        self.X = np.random.uniform(-1.0, 1.0, (20, self.problem.N))
+
+    def test_update_batch(self):
+        cost, jacobian = self.problem.update_batch(self.X)
+        self.assertEqual(cost.shape, (self.X.shape[0],))
+        self.assertEqual(jacobian.shape, self.X.shape)
+        for k in range(self.X.shape[0]):
+            self.problem.update(self.X[k, :])
+            np.testing.assert_allclose(cost[k], self.problem.get_scalar_cost())
+            np.testing.assert_allclose(jacobian[k, :], self.problem.get_scalar_jacobian())
+
+    def test_fk_batch(self):
+        frames = self.scene.fk_batch(self.X, 'lwr_arm_6_link')
+        self.assertEqual(frames.shape, (self.X.shape[0], 7))
+        for k in range(self.X.shape[0]):
+            self.scene.update(self.X[k, :])
+            np.testing.assert_allclose(frames[k, :], self.scene.fk('lwr_arm_6_link').get_translation_and_quaternion())
+
+    def test_is_state_valid_batch(self):
+        valid = self.scene.is_state_valid_batch(self.X)
+        self.assertEqual(valid.shape, (self.X.shape[0],))
+        for k in range(self.X.shape[0]):
+            self.scene.update(self.X[k, :])
+            self.assertEqual(valid[k], self.scene.is_state_valid())
+
+    def test_concurrent_solve(self):
+        # Independent solvers must be able to run from Python threads.
+        solvers = [exo.Setup.load_solver(CONFIG) for _ in range(4)]
+        solutions = [None] * len(solvers)
+
+        def solve(i):
+            solutions[i] = solvers[i].solve()
+
+        threads = [threading.Thread(target=solve, args=(i,)) for i in range(len(solvers))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for solution in solutions:
+            np.testing.assert_allclose(solution, solutions[0])
+
+
+if __name__ == '__main__':
+    unittest.main()
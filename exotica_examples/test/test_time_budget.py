@@ -0,0 +1,44 @@
+import unittest
+
+import numpy as np
+import pyexotica as exo
+
+CONFIG = '{exotica_examples}/resources/configs/example_ik.xml'
+
+
+class TestTimeBudget(unittest.TestCase):
+    def setUp(self):
+        self.solver = exo.Setup.load_solver(CONFIG)
+        self.problem = self.solver.get_problem()
+
+    def test_time_limit(self):
+        self.solver.max_planning_time = 1e-9
+        solution = self.solver.solve()
+        self.assertEqual(self.problem.termination_criterion, exo.TerminationCriterion.TimeLimit)
+        # The best solution found so far is returned, i.e., the start state.
+        np.testing.assert_allclose(solution[0], self.problem.start_state)
+
+    def test_timings(self):
+        self.solver.clear_timings()
+        self.solver.solve()
+        timings = self.solver.get_timings()
+        self.assertIn('ProblemUpdate', timings)
+        counts, edges = self.solver.get_timing_histogram('ProblemUpdate', 5)
+        self.assertEqual(counts.sum(), len(timings['ProblemUpdate']))
+        self.assertEqual(len(edges), 6)
+        self.solver.clear_timings()
+        self.assertEqual(len(self.solver.get_timings()), 0)
+
+    def test_timing_samples_bounded(self):
+        self.solver.max_timing_samples = 3
+        for _ in range(5):
+            self.solver.solve()
+        self.assertEqual(len(self.solver.get_timings()['ProblemUpdate']), 3)
+
+        self.solver.max_timing_samples = 0
+        self.solver.solve()
+        self.assertEqual(len(self.solver.get_timings()), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
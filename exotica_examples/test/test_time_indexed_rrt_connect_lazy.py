@@ -0,0 +1,27 @@
+import unittest
+
+from pyexotica.testing import check_path_valid, create_solver_for_config
+
+CONFIG = '{exotica_examples}/resources/configs/example_time_indexed_sampling.xml'
+
+
+class TestTimeIndexedRRTConnectLazy(unittest.TestCase):
+    def check_solution(self, parameters):
+        solver_params = {'Timeout': 10, 'AddTimeIntoSolution': 1, 'TrajectoryPointsPerSecond': 30, 'RandomSeed': 42}
+        solver_params.update(parameters)
+        solver, problem = create_solver_for_config(CONFIG, 'exotica/TimeIndexedRRTConnectSolver', solver_params)
+        # Lazy checking defers motion checks, so the motions between the waypoints have to be valid as well.
+        check_path_valid(solver.solve(), lambda x: problem.is_valid(x[1:], x[0]))
+
+    def test_lazy(self):
+        self.check_solution({'LazyCollisionChecking': 1})
+
+    def test_validity_cache(self):
+        self.check_solution({'ValidityCacheSize': 100000})
+
+    def test_lazy_with_validity_cache(self):
+        self.check_solution({'LazyCollisionChecking': 1, 'ValidityCacheSize': 100000})
+
+
+if __name__ == '__main__':
+    unittest.main()
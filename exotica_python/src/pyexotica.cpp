@@ -669,6 +669,46 @@ public:
 }  // namespace detail
 }  // namespace pybind11
 
+// Batch of states, one state per row. C-contiguous NumPy arrays bind to this without a copy.
+typedef Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> BatchRefConst;
+
+inline void CheckBatchSize(BatchRefConst X, const int expected_size)
+{
+    if (X.cols() != expected_size) ThrowPretty("Invalid batch of states: each row has " << X.cols() << " elements, expected " << expected_size);
+}
+
+// Evaluates the scalar cost and its gradient at each row of X. The GIL is released for the whole batch.
+template <class ProblemType>
+std::pair<Eigen::VectorXd, Eigen::MatrixXd> UpdateEndPoseProblemBatch(ProblemType* problem, BatchRefConst X)
+{
+    CheckBatchSize(X, problem->N);
+    Eigen::VectorXd cost(X.rows());
+    Eigen::MatrixXd jacobian(X.rows(), X.cols());
+    {
+        py::gil_scoped_release release;
+        for (Eigen::Index k = 0; k < X.rows(); ++k)
+        {
+            problem->Update(X.row(k).transpose());
+            cost(k) = problem->GetScalarCost();
+            jacobian.row(k) = problem->GetScalarJacobian();
+        }
+    }
+    return std::make_pair(cost, jacobian);
+}
+
+// Checks the validity of each row of X. The GIL is released for the whole batch.
+template <class ProblemType>
+Eigen::Matrix<bool, Eigen::Dynamic, 1> IsStateValidBatch(ProblemType* problem, BatchRefConst X)
+{
+    CheckBatchSize(X, problem->N);
+    Eigen::Matrix<bool, Eigen::Dynamic, 1> valid(X.rows());
+    {
+        py::gil_scoped_release release;
+        for (Eigen::Index k = 0; k < X.rows(); ++k) valid(k) = problem->IsStateValid(X.row(k).transpose());
+    }
+    return valid;
+}
+
 PYBIND11_MODULE(_pyexotica, module)
 {
     module.doc() = "Exotica Python wrapper";
@@ -705,6 +745,7 @@ PYBIND11_MODULE(_pyexotica, module)
     setup.def_static("load_solver", &XMLLoader::LoadSolver, "Instantiate solver and problem from an XML file containing both a solver and problem initializer.", py::arg("filepath"));
     setup.def_static("load_solver_standalone", &XMLLoader::LoadSolverStandalone, "Instantiate only a solver from an XML file containing solely a solver initializer.", py::arg("filepath"));
     setup.def_static("load_problem", &XMLLoader::LoadProblem, "Instantiate only a problem from an XML file containing solely a problem initializer.", py::arg("filepath"));
+    setup.def_static("clear_cache", []() { Server::Instance()->ClearCache(); }, "Clears the cached robot models, scene templates, and meshes, e.g., after the files changed on disk.");
 
     py::module tools = module.def_submodule("Tools");
     tools.def("parse_path", &ParsePath);
@@ -726,6 +767,17 @@ PYBIND11_MODULE(_pyexotica, module)
         return Trajectory(data, radius).ToString();
     },
               py::arg("data"), py::arg("max_radius") = 1.0);
+    tools.def("serialize_initializer", [](const Initializer& init) { return py::bytes(SerializeInitializer(init)); });
+    tools.def("deserialize_initializer", [](const py::bytes& buffer) { return DeserializeInitializer(buffer); });
+    tools.def("serialize_trajectory", [](Eigen::MatrixXdRefConst data, double radius) { return py::bytes(SerializeTrajectory(Trajectory(data, radius))); }, py::arg("data"), py::arg("max_radius") = 1.0);
+    tools.def("deserialize_trajectory", [](const py::bytes& buffer) {
+        const Trajectory trajectory = DeserializeTrajectory(buffer);
+        return py::make_tuple(trajectory.GetData(), trajectory.GetRadius());
+    });
+    tools.def("serialize_matrix", [](Eigen::MatrixXdRefConst matrix) { return py::bytes(SerializeMatrix(matrix)); });
+    tools.def("deserialize_matrix", [](const py::bytes& buffer) { return DeserializeMatrix(buffer); });
+    tools.def("save_binary", [](const std::string& file_name, const py::bytes& buffer) { SaveBinary(file_name, buffer); });
+    tools.def("load_binary", [](const std::string& file_name) { return py::bytes(LoadBinary(file_name)); });
 
     py::module sparse_costs = tools.def_submodule("SparseCosts")
                                   .def("huber_cost", &huber_cost)
@@ -743,6 +795,33 @@ PYBIND11_MODULE(_pyexotica, module)
     timer.def("reset", &Timer::Reset);
     timer.def("get_duration", &Timer::GetDuration);
 
+    py::class_<ProfilerZoneStatistics> profiler_zone_statistics(module, "ProfilerZoneStatistics");
+    profiler_zone_statistics.def_readonly("name", &ProfilerZoneStatistics::name);
+    profiler_zone_statistics.def_readonly("calls", &ProfilerZoneStatistics::calls);
+    profiler_zone_statistics.def_readonly("total", &ProfilerZoneStatistics::total);
+    profiler_zone_statistics.def_readonly("min", &ProfilerZoneStatistics::min);
+    profiler_zone_statistics.def_readonly("max", &ProfilerZoneStatistics::max);
+    profiler_zone_statistics.def_property_readonly("mean", &ProfilerZoneStatistics::Mean);
+    profiler_zone_statistics.def("__repr__", [](const ProfilerZoneStatistics& zone) { return "<ProfilerZoneStatistics " + zone.name + ": " + std::to_string(zone.calls) + " calls, " + std::to_string(zone.total) + " s>"; });
+
+    py::class_<Profiler, std::unique_ptr<Profiler, py::nodelete>> profiler(module, "Profiler");
+    profiler.def_property_readonly_static("compiled", [](py::object) {
+#ifdef EXOTICA_ENABLE_PROFILER
+        return true;
+#else
+        return false;
+#endif
+    }, "Whether the profiler zones were compiled in (EXOTICA_ENABLE_PROFILER).");
+    profiler.def_static("is_enabled", []() { return Profiler::Instance().IsEnabled(); });
+    profiler.def_static("set_enabled", [](bool enabled) { Profiler::Instance().SetEnabled(enabled); });
+    profiler.def_static("get_buffer_size", []() { return Profiler::Instance().GetBufferSize(); });
+    profiler.def_static("set_buffer_size", [](std::size_t size) { Profiler::Instance().SetBufferSize(size); }, "Number of events kept per thread for the trace.");
+    profiler.def_static("get_summary", []() { return Profiler::Instance().GetSummary(); }, "Statistics of all zones sorted by descending total time.");
+    profiler.def_static("get_summary_table", []() { return Profiler::Instance().GetSummaryTable(); });
+    profiler.def_static("get_chrome_trace", []() { return Profiler::Instance().GetChromeTrace(); });
+    profiler.def_static("export_chrome_trace", [](const std::string& file_name) { Profiler::Instance().ExportChromeTrace(file_name); }, "Writes the buffered events in the Chrome trace event format.", py::arg("file_name"));
+    profiler.def_static("reset", []() { Profiler::Instance().Reset(); });
+
     py::class_<Object, std::shared_ptr<Object>> object(module, "Object");
     object.def_property_readonly("type", &Object::type, "Object type");
     object.def_property_readonly("name", &Object::GetObjectName, "Object name");
@@ -760,6 +839,7 @@ PYBIND11_MODULE(_pyexotica, module)
         .value("Divergence", TerminationCriterion::Divergence)
         .value("UserDefined", TerminationCriterion::UserDefined)
         .value("Convergence", TerminationCriterion::Convergence)
+        .value("TimeLimit", TerminationCriterion::TimeLimit)
         .export_values();
 
     py::enum_<RotationType>(module, "RotationType")
@@ -839,7 +919,9 @@ PYBIND11_MODULE(_pyexotica, module)
         .def_readonly("startJ", &TaskMap::start_jacobian)
         .def_readonly("lengthJ", &TaskMap::length_jacobian)
         .def("task_space_dim", (int (TaskMap::*)()) & TaskMap::TaskSpaceDim)
-        .def("task_space_jacobian_dim", &TaskMap::TaskSpaceJacobianDim);
+        .def("task_space_jacobian_dim", &TaskMap::TaskSpaceJacobianDim)
+        .def_property("finite_difference_step", &TaskMap::GetFiniteDifferenceStep, &TaskMap::SetFiniteDifferenceStep)
+        .def("set_finite_difference_method", (void (TaskMap::*)(const std::string&)) & TaskMap::SetFiniteDifferenceMethod);
 
     py::class_<TaskIndexing>(module, "TaskIndexing")
         .def_readonly("id", &TaskIndexing::id)
@@ -864,7 +946,18 @@ PYBIND11_MODULE(_pyexotica, module)
         .def_readonly("ddPhi_ddx", &TimeIndexedTask::ddPhi_ddx)    // Dynamic
         .def_readonly("ddPhi_ddu", &TimeIndexedTask::ddPhi_ddu)    // Dynamic
         .def_readonly("ddPhi_dxdu", &TimeIndexedTask::ddPhi_dxdu)  // Dynamic
-        .def_readonly("S", &TimeIndexedTask::S)
+        .def_property_readonly("S", [](const TimeIndexedTask& task) {
+            std::vector<Eigen::MatrixXd> S;
+            S.reserve(task.S.size());
+            for (const auto& S_t : task.S) S.emplace_back(S_t.toDenseMatrix());
+            return S;
+        })
+        .def_property_readonly("S_diagonal", [](const TimeIndexedTask& task) {
+            std::vector<Eigen::VectorXd> S;
+            S.reserve(task.S.size());
+            for (const auto& S_t : task.S) S.emplace_back(S_t.diagonal());
+            return S;
+        })
         .def_readonly("T", &TimeIndexedTask::T)
         .def_readonly("tasks", &TimeIndexedTask::tasks)
         .def_readonly("task_maps", &TimeIndexedTask::task_maps)
@@ -884,7 +977,8 @@ PYBIND11_MODULE(_pyexotica, module)
         .def_readonly("Phi", &EndPoseTask::Phi)
         .def_readonly("hessian", &EndPoseTask::hessian)
         .def_readonly("jacobian", &EndPoseTask::jacobian)
-        .def_readonly("S", &EndPoseTask::S)
+        .def_property_readonly("S", [](const EndPoseTask& task) -> Eigen::MatrixXd { return task.S.toDenseMatrix(); })
+        .def_property_readonly("S_diagonal", [](const EndPoseTask& task) -> Eigen::VectorXd { return task.S.diagonal(); })
         .def_readonly("tasks", &EndPoseTask::tasks)
         .def_readonly("task_maps", &EndPoseTask::task_maps)
         .def("get_S", &EndPoseTask::GetS)
@@ -902,7 +996,8 @@ PYBIND11_MODULE(_pyexotica, module)
         .def_readonly("y", &SamplingTask::y)
         .def_readonly("ydiff", &SamplingTask::ydiff)
         .def_readonly("Phi", &SamplingTask::Phi)
-        .def_readonly("S", &SamplingTask::S)
+        .def_property_readonly("S", [](const SamplingTask& task) -> Eigen::MatrixXd { return task.S.toDenseMatrix(); })
+        .def_property_readonly("S_diagonal", [](const SamplingTask& task) -> Eigen::VectorXd { return task.S.diagonal(); })
         .def_readonly("tasks", &SamplingTask::tasks)
         .def_readonly("task_maps", &SamplingTask::task_maps)
         .def("set_goal", &SamplingTask::SetGoal)
@@ -919,6 +1014,11 @@ PYBIND11_MODULE(_pyexotica, module)
     py::class_<MotionSolver, std::shared_ptr<MotionSolver>, Object> motion_solver(module, "MotionSolver");
     motion_solver.def_property("max_iterations", &MotionSolver::GetNumberOfMaxIterations, &MotionSolver::SetNumberOfMaxIterations);
     motion_solver.def("get_planning_time", &MotionSolver::GetPlanningTime);
+    motion_solver.def_property("max_planning_time", &MotionSolver::GetMaxPlanningTime, &MotionSolver::SetMaxPlanningTime);
+    motion_solver.def("get_timings", &MotionSolver::GetTimings);
+    motion_solver.def("get_timing_histogram", &MotionSolver::GetTimingHistogram, py::arg("phase"), py::arg("num_bins") = 10);
+    motion_solver.def("clear_timings", &MotionSolver::ClearTimings);
+    motion_solver.def_property("max_timing_samples", &MotionSolver::GetMaxTimingSamples, &MotionSolver::SetMaxTimingSamples);
     motion_solver.def("specify_problem", &MotionSolver::SpecifyProblem, "Assign problem to the solver", py::arg("planning_problem"));
     motion_solver.def(
         "solve", [](std::shared_ptr<MotionSolver> sol) {
@@ -926,7 +1026,7 @@ PYBIND11_MODULE(_pyexotica, module)
             sol->Solve(ret);
             return ret;
         },
-        "Solve the problem");
+        "Solve the problem", py::call_guard<py::gil_scoped_release>());
     motion_solver.def("get_problem", &MotionSolver::GetProblem);
 
     py::class_<FeedbackMotionSolver, std::shared_ptr<FeedbackMotionSolver>, MotionSolver> feedback_motion_solver(module, "FeedbackMotionSolver");
@@ -945,6 +1045,12 @@ PYBIND11_MODULE(_pyexotica, module)
         .def_property("start_time", &PlanningProblem::GetStartTime, &PlanningProblem::SetStartTime)
         .def("get_number_of_problem_updates", &PlanningProblem::GetNumberOfProblemUpdates)
         .def("reset_number_of_problem_updates", &PlanningProblem::ResetNumberOfProblemUpdates)
+        .def("get_number_of_problem_update_cache_hits", &PlanningProblem::GetNumberOfProblemUpdateCacheHits)
+        .def("get_problem_update_cache_hit_rate", &PlanningProblem::GetProblemUpdateCacheHitRate)
+        .def("invalidate_update_cache", &PlanningProblem::InvalidateUpdateCache)
+        .def_property("use_update_cache", &PlanningProblem::GetUseUpdateCache, &PlanningProblem::SetUseUpdateCache)
+        .def("get_construction_time", &PlanningProblem::GetConstructionTime)
+        .def("get_construction_memory", &PlanningProblem::GetConstructionMemory)
         .def("get_cost_evolution", (std::pair<std::vector<double>, std::vector<double>>(PlanningProblem::*)() const) & PlanningProblem::GetCostEvolution)
         .def("get_number_of_iterations", &PlanningProblem::GetNumberOfIterations)
         .def("pre_update", &PlanningProblem::PreUpdate)
@@ -957,8 +1063,8 @@ PYBIND11_MODULE(_pyexotica, module)
 
     py::class_<UnconstrainedTimeIndexedProblem, std::shared_ptr<UnconstrainedTimeIndexedProblem>, PlanningProblem> unconstrained_time_indexed_problem(prob, "UnconstrainedTimeIndexedProblem");
     unconstrained_time_indexed_problem.def("get_duration", &UnconstrainedTimeIndexedProblem::GetDuration);
-    unconstrained_time_indexed_problem.def("update", (void (UnconstrainedTimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & UnconstrainedTimeIndexedProblem::Update);
-    unconstrained_time_indexed_problem.def("update", (void (UnconstrainedTimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & UnconstrainedTimeIndexedProblem::Update);
+    unconstrained_time_indexed_problem.def("update", (void (UnconstrainedTimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & UnconstrainedTimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
+    unconstrained_time_indexed_problem.def("update", (void (UnconstrainedTimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & UnconstrainedTimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
     unconstrained_time_indexed_problem.def("set_goal", &UnconstrainedTimeIndexedProblem::SetGoal);
     unconstrained_time_indexed_problem.def("set_rho", &UnconstrainedTimeIndexedProblem::SetRho);
     unconstrained_time_indexed_problem.def("get_goal", &UnconstrainedTimeIndexedProblem::GetGoal);
@@ -980,8 +1086,8 @@ PYBIND11_MODULE(_pyexotica, module)
 
     py::class_<TimeIndexedProblem, std::shared_ptr<TimeIndexedProblem>, PlanningProblem> time_indexed_problem(prob, "TimeIndexedProblem");
     time_indexed_problem.def("get_duration", &TimeIndexedProblem::GetDuration);
-    time_indexed_problem.def("update", (void (TimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & TimeIndexedProblem::Update);
-    time_indexed_problem.def("update", (void (TimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & TimeIndexedProblem::Update);
+    time_indexed_problem.def("update", (void (TimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & TimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
+    time_indexed_problem.def("update", (void (TimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & TimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
     time_indexed_problem.def("set_goal", &TimeIndexedProblem::SetGoal);
     time_indexed_problem.def("set_rho", &TimeIndexedProblem::SetRho);
     time_indexed_problem.def("get_goal", &TimeIndexedProblem::GetGoal);
@@ -1013,12 +1119,14 @@ PYBIND11_MODULE(_pyexotica, module)
     time_indexed_problem.def("get_scalar_transition_jacobian", &TimeIndexedProblem::GetScalarTransitionJacobian);
     time_indexed_problem.def("get_equality", (Eigen::VectorXd(TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetEquality);
     time_indexed_problem.def("get_equality", (Eigen::VectorXd(TimeIndexedProblem::*)(int) const) & TimeIndexedProblem::GetEquality);
-    time_indexed_problem.def("get_equality_jacobian", (Eigen::SparseMatrix<double>(TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetEqualityJacobian);
+    time_indexed_problem.def("get_equality_jacobian", (const Eigen::SparseMatrix<double, Eigen::RowMajor>& (TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetEqualityJacobian);
     time_indexed_problem.def("get_equality_jacobian", (Eigen::MatrixXd(TimeIndexedProblem::*)(int) const) & TimeIndexedProblem::GetEqualityJacobian);
+    time_indexed_problem.def("get_equality_jacobian_structure", &TimeIndexedProblem::GetEqualityJacobianStructure);
     time_indexed_problem.def("get_inequality", (Eigen::VectorXd(TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetInequality);
     time_indexed_problem.def("get_inequality", (Eigen::VectorXd(TimeIndexedProblem::*)(int) const) & TimeIndexedProblem::GetInequality);
-    time_indexed_problem.def("get_inequality_jacobian", (Eigen::SparseMatrix<double>(TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetInequalityJacobian);
+    time_indexed_problem.def("get_inequality_jacobian", (const Eigen::SparseMatrix<double, Eigen::RowMajor>& (TimeIndexedProblem::*)() const) & TimeIndexedProblem::GetInequalityJacobian);
     time_indexed_problem.def("get_inequality_jacobian", (Eigen::MatrixXd(TimeIndexedProblem::*)(int) const) & TimeIndexedProblem::GetInequalityJacobian);
+    time_indexed_problem.def("get_inequality_jacobian_structure", &TimeIndexedProblem::GetInequalityJacobianStructure);
     time_indexed_problem.def("get_bounds", &TimeIndexedProblem::GetBounds);
     time_indexed_problem.def("get_joint_velocity_limits", &TimeIndexedProblem::GetJointVelocityLimits);  // deprecated
     time_indexed_problem.def_readonly("cost", &TimeIndexedProblem::cost);
@@ -1027,8 +1135,8 @@ PYBIND11_MODULE(_pyexotica, module)
 
     py::class_<BoundedTimeIndexedProblem, std::shared_ptr<BoundedTimeIndexedProblem>, PlanningProblem> bounded_time_indexed_problem(prob, "BoundedTimeIndexedProblem");
     bounded_time_indexed_problem.def("get_duration", &BoundedTimeIndexedProblem::GetDuration);
-    bounded_time_indexed_problem.def("update", (void (BoundedTimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & BoundedTimeIndexedProblem::Update);
-    bounded_time_indexed_problem.def("update", (void (BoundedTimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & BoundedTimeIndexedProblem::Update);
+    bounded_time_indexed_problem.def("update", (void (BoundedTimeIndexedProblem::*)(Eigen::VectorXdRefConst, int)) & BoundedTimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
+    bounded_time_indexed_problem.def("update", (void (BoundedTimeIndexedProblem::*)(Eigen::VectorXdRefConst)) & BoundedTimeIndexedProblem::Update, py::call_guard<py::gil_scoped_release>());
     bounded_time_indexed_problem.def("set_goal", &BoundedTimeIndexedProblem::SetGoal);
     bounded_time_indexed_problem.def("set_rho", &BoundedTimeIndexedProblem::SetRho);
     bounded_time_indexed_problem.def("get_goal", &BoundedTimeIndexedProblem::GetGoal);
@@ -1050,7 +1158,8 @@ PYBIND11_MODULE(_pyexotica, module)
     bounded_time_indexed_problem.def_readonly("cost", &BoundedTimeIndexedProblem::cost);
 
     py::class_<UnconstrainedEndPoseProblem, std::shared_ptr<UnconstrainedEndPoseProblem>, PlanningProblem> unconstrained_end_pose_problem(prob, "UnconstrainedEndPoseProblem");
-    unconstrained_end_pose_problem.def("update", &UnconstrainedEndPoseProblem::Update);
+    unconstrained_end_pose_problem.def("update", &UnconstrainedEndPoseProblem::Update, py::call_guard<py::gil_scoped_release>());
+    unconstrained_end_pose_problem.def("update_batch", &UpdateEndPoseProblemBatch<UnconstrainedEndPoseProblem>, "Updates the problem at each row of X and returns the scalar costs and their gradients (one row per state)", py::arg("X"));
     unconstrained_end_pose_problem.def("set_goal", &UnconstrainedEndPoseProblem::SetGoal);
     unconstrained_end_pose_problem.def("set_rho", &UnconstrainedEndPoseProblem::SetRho);
     unconstrained_end_pose_problem.def("get_goal", &UnconstrainedEndPoseProblem::GetGoal);
@@ -1070,7 +1179,8 @@ PYBIND11_MODULE(_pyexotica, module)
     unconstrained_end_pose_problem.def_readonly("cost", &UnconstrainedEndPoseProblem::cost);
 
     py::class_<EndPoseProblem, std::shared_ptr<EndPoseProblem>, PlanningProblem> end_pose_problem(prob, "EndPoseProblem");
-    end_pose_problem.def("update", &EndPoseProblem::Update);
+    end_pose_problem.def("update", &EndPoseProblem::Update, py::call_guard<py::gil_scoped_release>());
+    end_pose_problem.def("update_batch", &UpdateEndPoseProblemBatch<EndPoseProblem>, "Updates the problem at each row of X and returns the scalar costs and their gradients (one row per state)", py::arg("X"));
     end_pose_problem.def("pre_update", &EndPoseProblem::PreUpdate);
     end_pose_problem.def("set_goal", &EndPoseProblem::SetGoal);
     end_pose_problem.def("set_rho", &EndPoseProblem::SetRho);
@@ -1104,7 +1214,8 @@ PYBIND11_MODULE(_pyexotica, module)
     end_pose_problem.def_readonly("equality", &EndPoseProblem::equality);
 
     py::class_<BoundedEndPoseProblem, std::shared_ptr<BoundedEndPoseProblem>, PlanningProblem> bounded_end_pose_problem(prob, "BoundedEndPoseProblem");
-    bounded_end_pose_problem.def("update", &BoundedEndPoseProblem::Update);
+    bounded_end_pose_problem.def("update", &BoundedEndPoseProblem::Update, py::call_guard<py::gil_scoped_release>());
+    bounded_end_pose_problem.def("update_batch", &UpdateEndPoseProblemBatch<BoundedEndPoseProblem>, "Updates the problem at each row of X and returns the scalar costs and their gradients (one row per state)", py::arg("X"));
     bounded_end_pose_problem.def("set_goal", &BoundedEndPoseProblem::SetGoal);
     bounded_end_pose_problem.def("set_rho", &BoundedEndPoseProblem::SetRho);
     bounded_end_pose_problem.def("get_goal", &BoundedEndPoseProblem::GetGoal);
@@ -1122,7 +1233,7 @@ PYBIND11_MODULE(_pyexotica, module)
     bounded_end_pose_problem.def_readonly("cost", &BoundedEndPoseProblem::cost);
 
     py::class_<SamplingProblem, std::shared_ptr<SamplingProblem>, PlanningProblem> sampling_problem(prob, "SamplingProblem");
-    sampling_problem.def("update", &SamplingProblem::Update);
+    sampling_problem.def("update", &SamplingProblem::Update, py::call_guard<py::gil_scoped_release>());
     sampling_problem.def_property("goal_state", &SamplingProblem::GetGoalState, &SamplingProblem::SetGoalState);
     sampling_problem.def("get_space_dim", &SamplingProblem::GetSpaceDim);
     sampling_problem.def("get_bounds", &SamplingProblem::GetBounds);
@@ -1138,10 +1249,11 @@ PYBIND11_MODULE(_pyexotica, module)
     sampling_problem.def("set_rho_neq", &SamplingProblem::SetRhoNEQ);
     sampling_problem.def("get_goal_neq", &SamplingProblem::GetGoalNEQ);
     sampling_problem.def("get_rho_neq", &SamplingProblem::GetRhoNEQ);
-    sampling_problem.def("is_state_valid", &SamplingProblem::IsStateValid);
+    sampling_problem.def("is_state_valid", &SamplingProblem::IsStateValid, py::call_guard<py::gil_scoped_release>());
+    sampling_problem.def("is_state_valid_batch", &IsStateValidBatch<SamplingProblem>, "Checks the validity of each row of X", py::arg("X"));
 
     py::class_<TimeIndexedSamplingProblem, std::shared_ptr<TimeIndexedSamplingProblem>, PlanningProblem> time_indexed_sampling_problem(prob, "TimeIndexedSamplingProblem");
-    time_indexed_sampling_problem.def("update", &TimeIndexedSamplingProblem::Update);
+    time_indexed_sampling_problem.def("update", &TimeIndexedSamplingProblem::Update, py::call_guard<py::gil_scoped_release>());
     time_indexed_sampling_problem.def("get_space_dim", &TimeIndexedSamplingProblem::GetSpaceDim);
     time_indexed_sampling_problem.def("get_bounds", &TimeIndexedSamplingProblem::GetBounds);
     time_indexed_sampling_problem.def_property("goal_state", &TimeIndexedSamplingProblem::GetGoalState, &TimeIndexedSamplingProblem::SetGoalState);
@@ -1158,7 +1270,7 @@ PYBIND11_MODULE(_pyexotica, module)
     time_indexed_sampling_problem.def("set_rho_neq", &TimeIndexedSamplingProblem::SetRhoNEQ);
     time_indexed_sampling_problem.def("get_goal_neq", &TimeIndexedSamplingProblem::GetGoalNEQ);
     time_indexed_sampling_problem.def("get_rho_neq", &TimeIndexedSamplingProblem::GetRhoNEQ);
-    time_indexed_sampling_problem.def("is_valid", (bool (TimeIndexedSamplingProblem::*)(Eigen::VectorXdRefConst, const double&)) & TimeIndexedSamplingProblem::IsValid);
+    time_indexed_sampling_problem.def("is_valid", (bool (TimeIndexedSamplingProblem::*)(Eigen::VectorXdRefConst, const double&)) & TimeIndexedSamplingProblem::IsValid, py::call_guard<py::gil_scoped_release>());
 
     py::enum_<ControlCostLossTermType>(module, "ControlCostLossTermType")
         // BimodalHuber = 3, SuperHuber = 4, <-- skipped as not actively used right now.
@@ -1170,11 +1282,12 @@ PYBIND11_MODULE(_pyexotica, module)
         .export_values();
 
     py::class_<DynamicTimeIndexedShootingProblem, std::shared_ptr<DynamicTimeIndexedShootingProblem>, PlanningProblem>(prob, "DynamicTimeIndexedShootingProblem")
-        .def("update", (void (DynamicTimeIndexedShootingProblem::*)(Eigen::VectorXdRefConst, Eigen::VectorXdRefConst, int)) & DynamicTimeIndexedShootingProblem::Update)
-        .def("update", (void (DynamicTimeIndexedShootingProblem::*)(Eigen::VectorXdRefConst, int)) & DynamicTimeIndexedShootingProblem::Update)
-        .def("update_terminal_state", &DynamicTimeIndexedShootingProblem::UpdateTerminalState)
+        .def("update", (void (DynamicTimeIndexedShootingProblem::*)(Eigen::VectorXdRefConst, Eigen::VectorXdRefConst, int)) & DynamicTimeIndexedShootingProblem::Update, py::call_guard<py::gil_scoped_release>())
+        .def("update", (void (DynamicTimeIndexedShootingProblem::*)(Eigen::VectorXdRefConst, int)) & DynamicTimeIndexedShootingProblem::Update, py::call_guard<py::gil_scoped_release>())
+        .def("update_terminal_state", &DynamicTimeIndexedShootingProblem::UpdateTerminalState, py::call_guard<py::gil_scoped_release>())
         .def_property("X", static_cast<const Eigen::MatrixXd& (DynamicTimeIndexedShootingProblem::*)(void)const>(&DynamicTimeIndexedShootingProblem::get_X), &DynamicTimeIndexedShootingProblem::set_X)
         .def_property("U", static_cast<const Eigen::MatrixXd& (DynamicTimeIndexedShootingProblem::*)(void)const>(&DynamicTimeIndexedShootingProblem::get_U), &DynamicTimeIndexedShootingProblem::set_U)
+        .def("shift_horizon", &DynamicTimeIndexedShootingProblem::ShiftHorizon, py::arg("x_measured"))
         .def_property("X_star", &DynamicTimeIndexedShootingProblem::get_X_star, &DynamicTimeIndexedShootingProblem::set_X_star)
         .def_property_readonly("tau", &DynamicTimeIndexedShootingProblem::get_tau)
         .def_property("T", &DynamicTimeIndexedShootingProblem::get_T, &DynamicTimeIndexedShootingProblem::set_T)
@@ -1191,7 +1304,9 @@ PYBIND11_MODULE(_pyexotica, module)
         .def("get_control_cost", &DynamicTimeIndexedShootingProblem::GetControlCost)
         .def("get_control_cost_jacobian", &DynamicTimeIndexedShootingProblem::GetControlCostJacobian)
         .def("get_control_cost_hessian", &DynamicTimeIndexedShootingProblem::GetControlCostHessian)
-        .def("get_state_cost_hessian", &DynamicTimeIndexedShootingProblem::GetStateControlCostHessian);
+        .def("get_state_control_cost_hessian", &DynamicTimeIndexedShootingProblem::GetStateControlCostHessian)
+        .def("has_state_control_cost_coupling", &DynamicTimeIndexedShootingProblem::HasStateControlCostCoupling)
+        .def("is_control_cost_hessian_constant", &DynamicTimeIndexedShootingProblem::IsControlCostHessianConstant);
 
     py::class_<CollisionProxy, std::shared_ptr<CollisionProxy>> collision_proxy(module, "CollisionProxy");
     collision_proxy.def(py::init());
@@ -1225,7 +1340,7 @@ PYBIND11_MODULE(_pyexotica, module)
     scene.def_property_readonly("num_state", &Scene::get_num_state);
     scene.def_property_readonly("num_state_derivative", &Scene::get_num_state_derivative);
     scene.def_property_readonly("has_quaternion_floating_base", &Scene::get_has_quaternion_floating_base);
-    scene.def("update", &Scene::Update, py::arg("x"), py::arg("t") = 0.0);
+    scene.def("update", &Scene::Update, py::arg("x"), py::arg("t") = 0.0, py::call_guard<py::gil_scoped_release>());
     scene.def("get_controlled_joint_names", (std::vector<std::string>(Scene::*)()) & Scene::GetControlledJointNames);
     scene.def("get_controlled_link_names", &Scene::GetControlledLinkNames);
     scene.def("get_model_link_names", &Scene::GetModelLinkNames);
@@ -1243,7 +1358,7 @@ PYBIND11_MODULE(_pyexotica, module)
         }
         return frame_names;
     });
-    scene.def("set_model_state", (void (Scene::*)(Eigen::VectorXdRefConst, double, bool)) & Scene::SetModelState, py::arg("x"), py::arg("t") = 0.0, py::arg("update_trajectory") = false);
+    scene.def("set_model_state", (void (Scene::*)(Eigen::VectorXdRefConst, double, bool)) & Scene::SetModelState, py::arg("x"), py::arg("t") = 0.0, py::arg("update_trajectory") = false, py::call_guard<py::gil_scoped_release>());
     scene.def("set_model_state_map", (void (Scene::*)(const std::map<std::string, double>&, double, bool)) & Scene::SetModelState, py::arg("x"), py::arg("t") = 0.0, py::arg("update_trajectory") = false);
     scene.def("get_controlled_state", &Scene::GetControlledState);
     scene.def("publish_scene", &Scene::PublishScene);
@@ -1261,21 +1376,36 @@ PYBIND11_MODULE(_pyexotica, module)
               py::arg("update_collision_scene") = true);
     scene.def("get_scene", &Scene::GetScene);
     scene.def("clean_scene", &Scene::CleanScene);
-    scene.def("is_state_valid", [](Scene* instance, bool self, double safe_distance) { return instance->GetCollisionScene()->IsStateValid(self, safe_distance); }, py::arg("check_self_collision") = true, py::arg("safe_distance") = 0.0);
-    scene.def("is_collision_free", [](Scene* instance, const std::string& o1, const std::string& o2, double safe_distance) { return instance->GetCollisionScene()->IsCollisionFree(o1, o2, safe_distance); }, py::arg("object_1"), py::arg("object_2"), py::arg("safe_distance") = 0.0);
+    scene.def("get_world_hash", &Scene::GetWorldHash);
+    scene.def("is_state_valid", [](Scene* instance, bool self, double safe_distance) { return instance->GetCollisionScene()->IsStateValid(self, safe_distance); }, py::arg("check_self_collision") = true, py::arg("safe_distance") = 0.0, py::call_guard<py::gil_scoped_release>());
+    scene.def("is_state_valid_batch",
+              [](Scene* instance, BatchRefConst X, bool self, double safe_distance, double t) {
+                  Eigen::Matrix<bool, Eigen::Dynamic, 1> valid(X.rows());
+                  {
+                      py::gil_scoped_release release;
+                      for (Eigen::Index k = 0; k < X.rows(); ++k)
+                      {
+                          instance->Update(X.row(k).transpose(), t);
+                          valid(k) = instance->GetCollisionScene()->IsStateValid(self, safe_distance);
+                      }
+                  }
+                  return valid;
+              },
+              "Updates the scene to each row of X and checks it for collisions", py::arg("X"), py::arg("check_self_collision") = true, py::arg("safe_distance") = 0.0, py::arg("t") = 0.0);
+    scene.def("is_collision_free", [](Scene* instance, const std::string& o1, const std::string& o2, double safe_distance) { return instance->GetCollisionScene()->IsCollisionFree(o1, o2, safe_distance); }, py::arg("object_1"), py::arg("object_2"), py::arg("safe_distance") = 0.0, py::call_guard<py::gil_scoped_release>());
     scene.def("is_allowed_to_collide", [](Scene* instance, const std::string& o1, const std::string& o2, bool self) { return instance->GetCollisionScene()->IsAllowedToCollide(o1, o2, self); }, py::arg("object_1"), py::arg("object_2"), py::arg("check_self_collision") = true);
-    scene.def("get_collision_distance", [](Scene* instance, bool self) { return instance->GetCollisionScene()->GetCollisionDistance(self); }, py::arg("check_self_collision") = true);
-    scene.def("get_collision_distance", [](Scene* instance, const std::string& o1, const std::string& o2) { return instance->GetCollisionScene()->GetCollisionDistance(o1, o2); }, py::arg("object_1"), py::arg("object_2"));
+    scene.def("get_collision_distance", [](Scene* instance, bool self) { return instance->GetCollisionScene()->GetCollisionDistance(self); }, py::arg("check_self_collision") = true, py::call_guard<py::gil_scoped_release>());
+    scene.def("get_collision_distance", [](Scene* instance, const std::string& o1, const std::string& o2) { return instance->GetCollisionScene()->GetCollisionDistance(o1, o2); }, py::arg("object_1"), py::arg("object_2"), py::call_guard<py::gil_scoped_release>());
     scene.def("get_collision_distance",
               [](Scene* instance, const std::string& o1, const bool& self) {
                   return instance->GetCollisionScene()->GetCollisionDistance(o1, self);
               },
-              py::arg("object_1"), py::arg("check_self_collision") = true);
+              py::arg("object_1"), py::arg("check_self_collision") = true, py::call_guard<py::gil_scoped_release>());
     scene.def("get_collision_distance",
               [](Scene* instance, const std::vector<std::string>& objects, const bool& self) {
                   return instance->GetCollisionScene()->GetCollisionDistance(objects, self);
               },
-              py::arg("objects"), py::arg("check_self_collision") = true);
+              py::arg("objects"), py::arg("check_self_collision") = true, py::call_guard<py::gil_scoped_release>());
     scene.def("update_planning_scene_world",
               [](Scene* instance, moveit_msgs::PlanningSceneWorld& world) {
                   moveit_msgs::PlanningSceneWorldConstPtr my_ptr(
@@ -1295,6 +1425,20 @@ PYBIND11_MODULE(_pyexotica, module)
     scene.def("fk", [](Scene* instance, const std::string& e1, const KDL::Frame& o1, const std::string& e2, const KDL::Frame& o2) { return instance->GetKinematicTree().FK(e1, o1, e2, o2); });
     scene.def("fk", [](Scene* instance, const std::string& e1, const std::string& e2) { return instance->GetKinematicTree().FK(e1, KDL::Frame(), e2, KDL::Frame()); });
     scene.def("fk", [](Scene* instance, const std::string& e1) { return instance->GetKinematicTree().FK(e1, KDL::Frame(), "", KDL::Frame()); });
+    scene.def("fk_batch",
+              [](Scene* instance, BatchRefConst X, const std::string& e1, const std::string& e2, double t) {
+                  Eigen::Matrix<double, Eigen::Dynamic, 7, Eigen::RowMajor> frames(X.rows(), 7);
+                  {
+                      py::gil_scoped_release release;
+                      for (Eigen::Index k = 0; k < X.rows(); ++k)
+                      {
+                          instance->Update(X.row(k).transpose(), t);
+                          frames.row(k) = GetFrameAsVector(instance->GetKinematicTree().FK(e1, KDL::Frame(), e2, KDL::Frame()), RotationType::QUATERNION).transpose();
+                      }
+                  }
+                  return frames;
+              },
+              "Updates the scene to each row of X and returns the pose of e1 relative to e2 as rows of [x, y, z, qx, qy, qz, qw]", py::arg("X"), py::arg("e1"), py::arg("e2") = std::string(""), py::arg("t") = 0.0);
     scene.def("jacobian", [](Scene* instance, const std::string& e1, const KDL::Frame& o1, const std::string& e2, const KDL::Frame& o2) { return instance->GetKinematicTree().Jacobian(e1, o1, e2, o2); });
     scene.def("jacobian", [](Scene* instance, const std::string& e1, const std::string& e2) { return instance->GetKinematicTree().Jacobian(e1, KDL::Frame(), e2, KDL::Frame()); });
     scene.def("jacobian", [](Scene* instance, const std::string& e1) { return instance->GetKinematicTree().Jacobian(e1, KDL::Frame(), "", KDL::Frame()); });
@@ -1310,6 +1454,7 @@ PYBIND11_MODULE(_pyexotica, module)
               py::arg("link"), py::arg("data"), py::arg("radius"));
     scene.def("get_trajectory", [](Scene* instance, const std::string& link) { return instance->GetTrajectory(link)->ToString(); });
     scene.def("remove_trajectory", &Scene::RemoveTrajectory);
+    scene.def("set_trajectory_sampling", &Scene::SetTrajectorySampling, py::arg("dt"), py::arg("offset") = 0.0);
     scene.def("update_scene_frames", &Scene::UpdateSceneFrames);
     scene.def("add_object", [](Scene* instance, const std::string& name, const KDL::Frame& transform, const std::string& parent, const std::string& shape_resource_path, const Eigen::Vector3d scale, const Eigen::Vector4d color, const bool update_collision_scene) { instance->AddObject(name, transform, parent, shape_resource_path, scale, KDL::RigidBodyInertia::Zero(), color, update_collision_scene); },
               py::arg("name"),
@@ -1347,7 +1492,7 @@ PYBIND11_MODULE(_pyexotica, module)
     collision_scene.def_property("world_link_scale", &CollisionScene::GetWorldLinkScale, &CollisionScene::SetWorldLinkScale);
     collision_scene.def_property("robot_link_padding", &CollisionScene::GetRobotLinkPadding, &CollisionScene::SetRobotLinkPadding);
     collision_scene.def_property("world_link_padding", &CollisionScene::GetWorldLinkPadding, &CollisionScene::SetWorldLinkPadding);
-    collision_scene.def("update_collision_object_transforms", &CollisionScene::UpdateCollisionObjectTransforms);
+    collision_scene.def("update_collision_object_transforms", &CollisionScene::UpdateCollisionObjectTransforms, py::call_guard<py::gil_scoped_release>());
     collision_scene.def("continuous_collision_check", &CollisionScene::ContinuousCollisionCheck);
     collision_scene.def("get_robot_to_robot_collision_distance", &CollisionScene::GetRobotToRobotCollisionDistance);
     collision_scene.def("get_robot_to_world_collision_distance", &CollisionScene::GetRobotToWorldCollisionDistance);
@@ -1383,6 +1528,12 @@ PYBIND11_MODULE(_pyexotica, module)
     kinematic_tree.def("get_model_base_type", &KinematicTree::GetModelBaseType);
     kinematic_tree.def("get_controlled_base_type", &KinematicTree::GetControlledBaseType);
     kinematic_tree.def("get_controlled_link_mass", &KinematicTree::GetControlledLinkMass);
+    kinematic_tree.def("get_total_mass", &KinematicTree::GetTotalMass);
+    kinematic_tree.def("get_center_of_mass", &KinematicTree::GetCenterOfMass);
+    kinematic_tree.def("get_center_of_mass_jacobian", &KinematicTree::GetCenterOfMassJacobian);
+    kinematic_tree.def("get_subtree_mass", &KinematicTree::GetSubtreeMass);
+    kinematic_tree.def("get_subtree_center_of_mass", &KinematicTree::GetSubtreeCenterOfMass);
+    kinematic_tree.def("get_subtree_center_of_mass_jacobian", &KinematicTree::GetSubtreeCenterOfMassJacobian);
     kinematic_tree.def("get_collision_object_types", &KinematicTree::GetCollisionObjectTypes);
     kinematic_tree.def("set_seed", &KinematicTree::SetSeed);
     kinematic_tree.def("get_random_controlled_state", &KinematicTree::GetRandomControlledState);
@@ -45,6 +45,29 @@ def semiimplicit_euler(x, dx, dt, ds=None):
     return x + dx_new
 
 
+def create_solver_for_config(config, solver_type, solver_params=None):
+    """Creates the problem of an XML configuration and a solver of type solver_type
+    (e.g., 'exotica/AICOSolver') with solver_params for it. Returns the solver and the problem."""
+    _, problem_init = exo.Initializers.load_xml_full(config)
+    problem = exo.Setup.create_problem(problem_init)
+    params = {'Name': 'Solver'}
+    if solver_params is not None:
+        params.update(solver_params)
+    solver = exo.Setup.create_solver((solver_type, params))
+    solver.specify_problem(problem)
+    return solver, problem
+
+
+def check_path_valid(solution, is_valid, steps=10):
+    """Checks is_valid at steps points along the straight segments between consecutive rows of solution."""
+    np.testing.assert_array_less(1, solution.shape[0], err_msg='The solution has no segments')
+    for k in range(solution.shape[0] - 1):
+        for s in np.linspace(0.0, 1.0, steps):
+            x = (1.0 - s) * solution[k, :] + s * solution[k + 1, :]
+            if not is_valid(x):
+                raise AssertionError('Invalid state at {} between rows {} and {} of the solution: {}'.format(s, k, k + 1, x))
+
+
 def check_dynamics_solver_derivatives(name, urdf=None, srdf=None, joint_group=None, additional_args=None, do_test_integrators=True):
     ds = None
     if urdf is not None and srdf is not None and joint_group is not None: